@@ -38,6 +38,7 @@
 #include "qdpll_internals.h"
 #include "qdpll_dep_man_generic.h"
 #include "qdpll_dep_man_qdag.h"
+#include "qdpll_dep_man_rrs.h"
 #include "qdpll_config.h"
 
 #define QDPLL_ABORT_QDPLL(cond,msg)					\
@@ -124,6 +125,12 @@
     (anchor).cnt--;						\
   } while (0)
 
+/* Memory managers accounting to categories other than 'QDPLL_MEM_PCNF'. */
+#define QBCE_MM(qdpll) (qdpll_mem_view ((qdpll)->mm, QDPLL_MEM_QBCE))
+#define QPUP_MM(qdpll) (qdpll_mem_view ((qdpll)->mm, QDPLL_MEM_QPUP))
+#define TRAIL_MM(qdpll) (qdpll_mem_view ((qdpll)->mm, QDPLL_MEM_TRAIL))
+#define PQUEUE_MM(qdpll) (qdpll_mem_view ((qdpll)->mm, QDPLL_MEM_PQUEUE))
+
 
 static int is_clause_empty (QDPLL * qdpll, Constraint * clause);
 
@@ -166,7 +173,7 @@ print_lit_notify_lists (QDPLL * qdpll, BLitsOccStack * notify_list)
   BLitsOcc *p, *e;
   for (p = notify_list->start, e = notify_list->top; p < e; p++)
     {
-      print_constraint (qdpll, BLIT_STRIP_PTR (p->constraint));
+      print_constraint (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, *p));
       fprintf (stderr, "\n");
     }
 }
@@ -201,9 +208,9 @@ print_vars_state (QDPLL * qdpll)
         {
           cnt_used++;
           int val;
-          if (QDPLL_VAR_ASSIGNED_TRUE (p))
+          if (QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, p))
             val = 1;
-          else if (QDPLL_VAR_ASSIGNED_FALSE (p))
+          else if (QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, p))
             val = -1;
           else
             val = 0;
@@ -294,13 +301,11 @@ static unsigned int
 count_in_notify_literal_watcher_list (BLitsOccStack * notify_list,
                                       Constraint * c)
 {
-  assert (!BLIT_MARKED_PTR (c));
   unsigned int cnt = 0;
   BLitsOcc *p, *e;
   for (p = notify_list->start, e = notify_list->top; p < e; p++)
     {
-      Constraint *cp = BLIT_STRIP_PTR (p->constraint);
-      if (cp == c)
+      if (p->cref == c->ref)
         cnt++;
     }
 
@@ -321,7 +326,7 @@ print_assigned_vars (QDPLL * qdpll)
       fprintf (stderr,
                "id=%d, type=%c(%d), dlevel=%d, value=%d, mode=%d, prop=%d\n",
                v->id, QDPLL_SCOPE_FORALL (v->scope) ? 'A' : 'E',
-               v->scope->nesting, v->decision_level, v->assignment, v->mode,
+               v->scope->nesting, QDPLL_VAR_LEVEL (qdpll->pcnf, v), QDPLL_VAR_VALUE (qdpll->pcnf, v), v->mode,
                v->mark_propagated);
     }
 }
@@ -341,7 +346,7 @@ print_lits (QDPLL * qdpll, LitID * lits, unsigned int num,
       fprintf (stderr, "%c(%d)%d",
                QDPLL_SCOPE_FORALL (var->scope) ? 'A' : 'E',
                var->scope->nesting, *p);
-      if (QDPLL_VAR_ASSIGNED (var))
+      if (QDPLL_VAR_ASSIGNED (qdpll->pcnf, var))
         {
           char mode_char = 'X';
           if (var->mode == QDPLL_VARMODE_UNIT)
@@ -357,8 +362,8 @@ print_lits (QDPLL * qdpll, LitID * lits, unsigned int num,
           else
             assert (0);
           fprintf (stderr, "(%c%c)@%d",
-                   QDPLL_VAR_ASSIGNED_TRUE (var) ? 'T' : 'F', mode_char,
-                   var->decision_level);
+                   QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var) ? 'T' : 'F', mode_char,
+                   QDPLL_VAR_LEVEL (qdpll->pcnf, var));
         }
       fprintf (stderr, " ");
     }
@@ -430,7 +435,7 @@ assert_full_prefix_integrity_scopes (QDPLL * qdpll, Scope *s, Scope *n)
         continue;
       assert (var->scope == s);
       assert (var->id == v);
-      assert (!QDPLL_VAR_ASSIGNED (var) || var->mode == QDPLL_VARMODE_UNIT
+      assert (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, var) || var->mode == QDPLL_VARMODE_UNIT
               || var->mode == QDPLL_VARMODE_PURE || var->mode == QDPLL_VARMODE_ASSUMED);
       assert (!QDPLL_VAR_MARKED (var));
       assert (!QDPLL_VAR_MARKED_PROPAGATED (var));
@@ -442,10 +447,10 @@ assert_full_prefix_integrity_scopes (QDPLL * qdpll, Scope *s, Scope *n)
       BLitsOcc *bp, *be;
       for (bp = var->neg_occ_clauses.start, be = var->neg_occ_clauses.top;
            bp < be; bp++)
-        assert (constraint_has_lit (BLIT_STRIP_PTR (bp->constraint), -v));
+        assert (constraint_has_lit (BLIT_CONSTRAINT (qdpll->pcnf, *bp), -v));
       for (bp = var->pos_occ_clauses.start, be = var->pos_occ_clauses.top;
            bp < be; bp++)
-        assert (constraint_has_lit (BLIT_STRIP_PTR (bp->constraint), v));
+        assert (constraint_has_lit (BLIT_CONSTRAINT (qdpll->pcnf, *bp), v));
     }
 }
 
@@ -556,11 +561,10 @@ assert_full_prefix_integrity (QDPLL * qdpll)
 static int
 occs_have_constraint (LitID lit, BLitsOccStack * occ_list, Constraint * c)
 {
-  assert (!BLIT_MARKED_PTR (c));
   BLitsOcc *bp, *be;
   for (bp = occ_list->start, be = occ_list->top; bp < be; bp++)
     {
-      if (BLIT_STRIP_PTR (bp->constraint) == c)
+      if (bp->cref == c->ref)
         return 1;
     }
   return 0;
@@ -723,7 +727,7 @@ assert_incremental_selector_vars (QDPLL *qdpll)
       assert (!var->is_cur_inactive_group_selector);
       /* Stack may contain former internal variables which might have been
          cleaned up because they did not have occurrences. */
-      assert (!var->id || QDPLL_VAR_ASSIGNED_TRUE (var));
+      assert (!var->id || QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var));
     }
   for (p = qdpll->state.cur_used_internal_vars.start, 
          e = qdpll->state.cur_used_internal_vars.top; p < e; p++)
@@ -740,8 +744,8 @@ assert_incremental_selector_vars (QDPLL *qdpll)
              cleaned up because they did not have occurrences. */
           if (var->id)
             {
-              assert (var->is_cur_inactive_group_selector || QDPLL_VAR_ASSIGNED_FALSE (var));
-              assert (!var->is_cur_inactive_group_selector || QDPLL_VAR_ASSIGNED_TRUE (var));
+              assert (var->is_cur_inactive_group_selector || QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var));
+              assert (!var->is_cur_inactive_group_selector || QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var));
             }
         }
     }
@@ -772,8 +776,8 @@ assert_all_pure_literals_and_clause_watchers_integrity (QDPLL * qdpll)
           Var *var = VARID2VARPTR (vars, *p);
 
           assert (!QDPLL_VAR_MARKED_PROPAGATED (var)
-                  || QDPLL_VAR_ASSIGNED (var));
-          assert (QDPLL_VAR_ASSIGNED (var)
+                  || QDPLL_VAR_ASSIGNED (qdpll->pcnf, var));
+          assert (QDPLL_VAR_ASSIGNED (qdpll->pcnf, var)
                   || !QDPLL_VAR_MARKED_PROPAGATED (var));
 
           if (qdpll->options.no_pure_literals)
@@ -798,25 +802,19 @@ assert_all_pure_literals_and_clause_watchers_integrity (QDPLL * qdpll)
             {                   /* Pure: only negative occurrences left. */
               /* Variable must have been pushed, but not necessarily propagated already. */
               assert (find_in_assigned_vars (qdpll, var->id));
-              assert (QDPLL_VAR_ASSIGNED (var));
+              assert (QDPLL_VAR_ASSIGNED (qdpll->pcnf, var));
               assert (!QDPLL_VAR_EXISTS (var)
-                      || QDPLL_VAR_ASSIGNED_FALSE (var));
+                      || QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var));
               assert (!QDPLL_VAR_FORALL (var)
-                      || QDPLL_VAR_ASSIGNED_TRUE (var));
+                      || QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var));
 
               /* Exactly one watcher must be satisfied. */
               assert (!QDPLL_VAR_HAS_NEG_OCCS (var) ||
                       !is_clause_satisfied (qdpll,
-                                            BLIT_STRIP_PTR (var->
-                                                            neg_occ_clauses.
-                                                            start[0].
-                                                            constraint)));
+                                            BLIT_CONSTRAINT (qdpll->pcnf, var->neg_occ_clauses.start[0])));
               assert (!QDPLL_VAR_HAS_POS_OCCS (var)
                       || is_clause_satisfied (qdpll,
-                                              BLIT_STRIP_PTR (var->
-                                                              pos_occ_clauses.
-                                                              start[0].
-                                                              constraint)));
+                                              BLIT_CONSTRAINT (qdpll->pcnf, var->pos_occ_clauses.start[0])));
 
             }
           else if (!has_active_neg_occs_in_clauses
@@ -825,24 +823,18 @@ assert_all_pure_literals_and_clause_watchers_integrity (QDPLL * qdpll)
             {                   /* Pure: only pos occurrences left. */
               /* Variable must have been pushed, but not necessarily propagated already. */
               assert (find_in_assigned_vars (qdpll, var->id));
-              assert (QDPLL_VAR_ASSIGNED (var));
+              assert (QDPLL_VAR_ASSIGNED (qdpll->pcnf, var));
               assert (!QDPLL_VAR_EXISTS (var)
-                      || QDPLL_VAR_ASSIGNED_TRUE (var));
+                      || QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var));
               assert (!QDPLL_VAR_FORALL (var)
-                      || QDPLL_VAR_ASSIGNED_FALSE (var));
+                      || QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var));
               /* Exactly one watcher must be satisfied. */
               assert (!QDPLL_VAR_HAS_POS_OCCS (var) ||
                       !is_clause_satisfied (qdpll,
-                                            BLIT_STRIP_PTR (var->
-                                                            pos_occ_clauses.
-                                                            start[0].
-                                                            constraint)));
+                                            BLIT_CONSTRAINT (qdpll->pcnf, var->pos_occ_clauses.start[0])));
               assert (!QDPLL_VAR_HAS_NEG_OCCS (var)
                       || is_clause_satisfied (qdpll,
-                                              BLIT_STRIP_PTR (var->
-                                                              neg_occ_clauses.
-                                                              start[0].
-                                                              constraint)));
+                                              BLIT_CONSTRAINT (qdpll->pcnf, var->neg_occ_clauses.start[0])));
             }
           else if (!has_active_neg_occs_in_clauses
                    && !has_active_pos_occs_in_clauses
@@ -851,74 +843,49 @@ assert_all_pure_literals_and_clause_watchers_integrity (QDPLL * qdpll)
             {                   /* Eliminated: no occurrences left. */
               assert (!QDPLL_VAR_HAS_POS_OCCS (var)
                       || (!QDPLL_VAR_MARKED_PROPAGATED (var)
-                          || QDPLL_VAR_ASSIGNED_FALSE (var))
+                          || QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var))
                       || is_clause_satisfied (qdpll,
-                                              BLIT_STRIP_PTR (var->
-                                                              pos_occ_clauses.
-                                                              start[0].
-                                                              constraint)));
+                                              BLIT_CONSTRAINT (qdpll->pcnf, var->pos_occ_clauses.start[0])));
               assert (!QDPLL_VAR_HAS_NEG_OCCS (var)
                       || (!QDPLL_VAR_MARKED_PROPAGATED (var)
-                          || QDPLL_VAR_ASSIGNED_TRUE (var))
+                          || QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var))
                       || is_clause_satisfied (qdpll,
-                                              BLIT_STRIP_PTR (var->
-                                                              neg_occ_clauses.
-                                                              start[0].
-                                                              constraint)));
+                                              BLIT_CONSTRAINT (qdpll->pcnf, var->neg_occ_clauses.start[0])));
             }
           else
             {                   /* Neither pure nor eliminated: both types of occurrences left. */
               assert (!QDPLL_VAR_MARKED_PROPAGATED (var));
               assert (!QDPLL_VAR_HAS_POS_OCCS (var) ||
                       !is_clause_satisfied (qdpll,
-                                            BLIT_STRIP_PTR (var->
-                                                            pos_occ_clauses.
-                                                            start[0].
-                                                            constraint))
+                                            BLIT_CONSTRAINT (qdpll->pcnf, var->pos_occ_clauses.start[0]))
                       || has_active_pos_occs_in_cubes);
               assert (!QDPLL_VAR_HAS_NEG_OCCS (var)
                       || !is_clause_satisfied (qdpll,
-                                               BLIT_STRIP_PTR (var->
-                                                               neg_occ_clauses.
-                                                               start[0].
-                                                               constraint))
+                                               BLIT_CONSTRAINT (qdpll->pcnf, var->neg_occ_clauses.start[0]))
                       || has_active_neg_occs_in_cubes);
             }
 
           /* Check notify lists wrt. watched clauses. */
           if (QDPLL_VAR_HAS_NEG_OCCS (var)
-              && !(QDPLL_VAR_ASSIGNED (var) && var->decision_level == 0))
+              && !(QDPLL_VAR_ASSIGNED (qdpll->pcnf, var) && QDPLL_VAR_LEVEL (qdpll->pcnf, var) == 0))
             {
               if (!var->mark_is_neg_watching_cube)
                 assert_notify_lists_integrity_by_watcher (qdpll, -var->id,
-                                                          BLIT_STRIP_PTR
-                                                          (var->
-                                                           neg_occ_clauses.
-                                                           start[0].
-                                                           constraint));
+                                                          BLIT_CONSTRAINT (qdpll->pcnf, var->neg_occ_clauses.start[0]));
               else
                 assert_notify_lists_integrity_by_watcher (qdpll, -var->id,
-                                                          BLIT_STRIP_PTR
-                                                          (var->neg_occ_cubes.
-                                                           start[0].
-                                                           constraint));
+                                                          BLIT_CONSTRAINT (qdpll->pcnf, var->neg_occ_cubes.start[0]));
             }
 
           if (QDPLL_VAR_HAS_POS_OCCS (var)
-              && !(QDPLL_VAR_ASSIGNED (var) && var->decision_level == 0))
+              && !(QDPLL_VAR_ASSIGNED (qdpll->pcnf, var) && QDPLL_VAR_LEVEL (qdpll->pcnf, var) == 0))
             {
               if (!var->mark_is_pos_watching_cube)
                 assert_notify_lists_integrity_by_watcher (qdpll, var->id,
-                                                          BLIT_STRIP_PTR
-                                                          (var->pos_occ_clauses.
-                                                           start[0].
-                                                           constraint));
+                                                          BLIT_CONSTRAINT (qdpll->pcnf, var->pos_occ_clauses.start[0]));
               else
                 assert_notify_lists_integrity_by_watcher (qdpll, var->id,
-                                                          BLIT_STRIP_PTR
-                                                          (var->pos_occ_cubes.
-                                                           start[0].
-                                                           constraint));
+                                                          BLIT_CONSTRAINT (qdpll->pcnf, var->pos_occ_cubes.start[0]));
             }
         }
     }
@@ -937,14 +904,14 @@ is_constraint_decided (QDPLL * qdpll, Constraint * c)
       assert (var->id);
       if (!c->is_cube)
         {
-          if ((QDPLL_VAR_ASSIGNED_TRUE (var) && QDPLL_LIT_POS (lit)) ||
-              (QDPLL_VAR_ASSIGNED_FALSE (var) && QDPLL_LIT_NEG (lit)))
+          if ((QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var) && QDPLL_LIT_POS (lit)) ||
+              (QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var) && QDPLL_LIT_NEG (lit)))
             return 1;
         }
       else
         {
-          if ((QDPLL_VAR_ASSIGNED_TRUE (var) && QDPLL_LIT_NEG (lit)) ||
-              (QDPLL_VAR_ASSIGNED_FALSE (var) && QDPLL_LIT_POS (lit)))
+          if ((QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var) && QDPLL_LIT_NEG (lit)) ||
+              (QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var) && QDPLL_LIT_POS (lit)))
             return 1;
         }
     }
@@ -971,13 +938,13 @@ assert_constraint_ignore_lit_watchers (QDPLL * qdpll, Constraint * c)
         {
           if (QDPLL_LIT_NEG (lit))
             {
-              if (QDPLL_VAR_ASSIGNED_TRUE (var))
+              if (QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var))
                 return 1;
             }
           else
             {
               assert (QDPLL_LIT_POS (lit));
-              if (QDPLL_VAR_ASSIGNED_FALSE (var))
+              if (QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var))
                 return 1;
             }
         }
@@ -985,13 +952,13 @@ assert_constraint_ignore_lit_watchers (QDPLL * qdpll, Constraint * c)
         {
           if (QDPLL_LIT_NEG (lit))
             {
-              if (QDPLL_VAR_ASSIGNED_FALSE (var))
+              if (QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var))
                 return 1;
             }
           else
             {
               assert (QDPLL_LIT_POS (lit));
-              if (QDPLL_VAR_ASSIGNED_TRUE (var))
+              if (QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var))
                 return 1;
             }
         }
@@ -1057,8 +1024,8 @@ static void
       assert (!is_cube || QDPLL_VAR_FORALL (rwvar));
 
       int ignore = 0;
-      if (lwvar->decision_level != QDPLL_INVALID_DECISION_LEVEL ||
-          rwvar->decision_level != QDPLL_INVALID_DECISION_LEVEL)
+      if (QDPLL_VAR_LEVEL (qdpll->pcnf, lwvar) != QDPLL_INVALID_DECISION_LEVEL ||
+          QDPLL_VAR_LEVEL (qdpll->pcnf, rwvar) != QDPLL_INVALID_DECISION_LEVEL)
         {
           ignore = 1;
           /* Conjecture: this assertion-function is called only if BCP
@@ -1086,9 +1053,9 @@ static void
             }
         }
 
-      assert (!QDPLL_VAR_ASSIGNED (rwvar) || is_constraint_decided (qdpll, c)
+      assert (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, rwvar) || is_constraint_decided (qdpll, c)
               || has_constraint_spurious_pure_lit (qdpll, c));
-      assert (!QDPLL_VAR_ASSIGNED (lwvar) || is_constraint_decided (qdpll, c)
+      assert (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, lwvar) || is_constraint_decided (qdpll, c)
               || has_constraint_spurious_pure_lit (qdpll, c));
 
       BLitsOccStack *notify_list;
@@ -1105,9 +1072,7 @@ static void
                   QDPLL_COUNT_STACK (*notify_list));
           assert (QDPLL_COUNT_STACK (*notify_list) == 0
                   || c ==
-                  BLIT_STRIP_PTR (notify_list->
-                                  start[c->offset_in_notify_list[1]].
-                                  constraint));
+                  BLIT_CONSTRAINT (qdpll->pcnf, notify_list->start[c->offset_in_notify_list[1]]));
         }
       else
         {
@@ -1122,9 +1087,7 @@ static void
                   QDPLL_COUNT_STACK (*notify_list));
           assert (QDPLL_COUNT_STACK (*notify_list) == 0
                   || c ==
-                  BLIT_STRIP_PTR (notify_list->
-                                  start[c->offset_in_notify_list[1]].
-                                  constraint));
+                  BLIT_CONSTRAINT (qdpll->pcnf, notify_list->start[c->offset_in_notify_list[1]]));
         }
 
       if (QDPLL_LIT_NEG (lwlit))
@@ -1140,9 +1103,7 @@ static void
                   QDPLL_COUNT_STACK (*notify_list));
           assert (QDPLL_COUNT_STACK (*notify_list) == 0
                   || c ==
-                  BLIT_STRIP_PTR (notify_list->
-                                  start[c->offset_in_notify_list[0]].
-                                  constraint));
+                  BLIT_CONSTRAINT (qdpll->pcnf, notify_list->start[c->offset_in_notify_list[0]]));
         }
       else
         {
@@ -1157,9 +1118,7 @@ static void
                   QDPLL_COUNT_STACK (*notify_list));
           assert (QDPLL_COUNT_STACK (*notify_list) == 0
                   || c ==
-                  BLIT_STRIP_PTR (notify_list->
-                                  start[c->offset_in_notify_list[0]].
-                                  constraint));
+                  BLIT_CONSTRAINT (qdpll->pcnf, notify_list->start[c->offset_in_notify_list[0]]));
         }
 
       LitID *ip, *ie;
@@ -1221,7 +1180,7 @@ assert_candidates_on_pqueue (QDPLL * qdpll)
       /* All variables which are candidates must be either (already)
          assigned or must occur on priority queue. */
       if (p->id)
-        assert (!dm->is_candidate (dm, p->id) || QDPLL_VAR_ASSIGNED (p)
+        assert (!dm->is_candidate (dm, p->id) || QDPLL_VAR_ASSIGNED (qdpll->pcnf, p)
                 || p->priority_pos != QDPLL_INVALID_PQUEUE_POS);
     }
 }
@@ -1258,8 +1217,8 @@ assert_is_clause_satisfied_by_univ_lit (QDPLL * qdpll, LitID implied,
       if (lit != implied)
         {
           Var *var = LIT2VARPTR (vars, lit);
-          if ((QDPLL_LIT_NEG (lit) && QDPLL_VAR_ASSIGNED_FALSE (var)) ||
-              (QDPLL_LIT_POS (lit) && QDPLL_VAR_ASSIGNED_TRUE (var)))
+          if ((QDPLL_LIT_NEG (lit) && QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var)) ||
+              (QDPLL_LIT_POS (lit) && QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var)))
             {
               if (!QDPLL_SCOPE_FORALL (var->scope))
                 return 0;
@@ -1322,8 +1281,8 @@ assert_lits_unassigned (QDPLL * qdpll, LitID * lit_start, LitID * lit_end)
     {
       assert (*p);
       Var *pvar = LIT2VARPTR (vars, *p);
-      assert (!QDPLL_VAR_ASSIGNED (pvar));
-      assert (pvar->decision_level == QDPLL_INVALID_DECISION_LEVEL);
+      assert (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, pvar));
+      assert (QDPLL_VAR_LEVEL (qdpll->pcnf, pvar) == QDPLL_INVALID_DECISION_LEVEL);
     }
 }
 
@@ -1356,26 +1315,26 @@ assert_pushed_pure_lits (QDPLL * qdpll)
           assert (!(has_pos_occ_clauses && has_neg_occ_cubes));
           if (QDPLL_SCOPE_FORALL (var->scope))
             {
-              if (var->assignment == QDPLL_ASSIGNMENT_FALSE)
+              if (QDPLL_VAR_VALUE (qdpll->pcnf, var) == QDPLL_ASSIGNMENT_FALSE)
                 {
                   assert (!has_neg_occ_clauses && !has_neg_occ_cubes);
                 }
               else
                 {
-                  assert (var->assignment == QDPLL_ASSIGNMENT_TRUE);
+                  assert (QDPLL_VAR_VALUE (qdpll->pcnf, var) == QDPLL_ASSIGNMENT_TRUE);
                   assert (!has_pos_occ_clauses && !has_pos_occ_cubes);
                 }
             }
           else
             {
               assert (QDPLL_SCOPE_EXISTS (var->scope));
-              if (var->assignment == QDPLL_ASSIGNMENT_FALSE)
+              if (QDPLL_VAR_VALUE (qdpll->pcnf, var) == QDPLL_ASSIGNMENT_FALSE)
                 {
                   assert (!has_pos_occ_clauses && !has_pos_occ_cubes);
                 }
               else
                 {
-                  assert (var->assignment == QDPLL_ASSIGNMENT_TRUE);
+                  assert (QDPLL_VAR_VALUE (qdpll->pcnf, var) == QDPLL_ASSIGNMENT_TRUE);
                   assert (!has_neg_occ_clauses && !has_neg_occ_cubes);
                 }
             }
@@ -1409,7 +1368,7 @@ assert_stop_crit_data (QDPLL * qdpll, LitIDStack * lit_stack,
   Var *type_var =
     get_type_var_at_dec_level (qdpll, lit_stack->start, lit_stack->top,
                                max_type_level, type);
-  assert (type_var->decision_level == qdpll->hi_dl_type_var->decision_level);
+  assert (QDPLL_VAR_LEVEL (qdpll->pcnf, type_var) == QDPLL_VAR_LEVEL (qdpll->pcnf, qdpll->hi_dl_type_var));
   assert (count_type_lit_at_dec_level
           (qdpll, lit_stack->start, lit_stack->top, max_type_level,
            type) == qdpll->cnt_hi_dl_type_lits);
@@ -1428,7 +1387,7 @@ assert_is_lit_irreducible_aux (QDPLL * qdpll, LitID lit, LitID * start,
   for (p = start, e = end; p < e; p++)
     {
       Var *var = LIT2VARPTR (vars, *p);
-      if (!(QDPLL_VAR_ASSIGNED (var) && var->decision_level == 0)
+      if (!(QDPLL_VAR_ASSIGNED (qdpll->pcnf, var) && QDPLL_VAR_LEVEL (qdpll->pcnf, var) == 0)
           && dm->depends (dm, lit_var->id, var->id))
         break;
     }
@@ -1454,7 +1413,7 @@ assert_peek_taut_lit_irreducible_aux (QDPLL * qdpll, Var * taut_var,
       Var *var = LIT2VARPTR (vars, lit);
       if (var == taut_var)
         taut_lit_found = 1;
-      if (!(QDPLL_VAR_ASSIGNED (var) && var->decision_level == 0)
+      if (!(QDPLL_VAR_ASSIGNED (qdpll->pcnf, var) && QDPLL_VAR_LEVEL (qdpll->pcnf, var) == 0)
           && dm->depends (dm, taut_var->id, var->id))
         break;
     }
@@ -1504,59 +1463,86 @@ assert_internal_vars_integrity (QDPLL *qdpll)
 
 /* -------------------- START: TRACING-ONLY CODE -------------------- */
 
+/* Write 'x' in groups of 7 bits, least significant first. The highest
+   bit of a byte is set if more bytes follow. Same encoding as used for
+   binary traces by 'qdpll_trace_put_varint', used for binary QDIMACS
+   output, see 'qdpll_print_binary'. */
 static void
-encode_num (int num, int is_literal)
+encode_varint (unsigned int x, FILE * out)
 {
   unsigned char ch;
-  unsigned int x = num;
-
-  if (is_literal)
-    x = num < 0 ? (-x << 1) | 1 : x << 1;
 
   while (x & ~0x7f)
     {
       ch = (x & 0x7f) | 0x80;
-      putc (ch, stdout);
+      putc (ch, out);
       x >>= 7;
     }
   ch = x;
-  putc (ch, stdout);
+  putc (ch, out);
+}
+
+static void
+encode_num (QDPLLTraceWriter * tw, int num, int is_literal)
+{
+  unsigned int x = num;
+
+  if (is_literal)
+    x = num < 0 ? (-x << 1) | 1 : x << 1;
+
+  qdpll_trace_put_varint (tw, x);
 }
 
 static void
-print_qrp_constraint (ConstraintID id, LitID * lits, unsigned int num_lits,
-                      ConstraintID ant1, ConstraintID ant2)
+print_qrp_constraint (QDPLL * qdpll, ConstraintID id, LitID * lits,
+                      unsigned int num_lits, ConstraintID ant1,
+                      ConstraintID ant2)
 {
+  QDPLLTraceWriter *tw = qdpll->trace_writer;
   LitID *p;
 
-  fprintf (stdout, "%u ", id);
+  qdpll_trace_put_uint (tw, id);
+  QDPLL_TRACE_PUTC (tw, ' ');
   for (p = lits; p < lits + num_lits; p++)
     if (*p)                     /* skip deleted */
-      fprintf (stdout, "%d ", *p);
-  fprintf (stdout, "0 ");
+      {
+        qdpll_trace_put_int (tw, *p);
+        QDPLL_TRACE_PUTC (tw, ' ');
+      }
+  QDPLL_TRACE_PUTC (tw, '0');
+  QDPLL_TRACE_PUTC (tw, ' ');
   if (ant1)
-    fprintf (stdout, "%u ", ant1);
+    {
+      qdpll_trace_put_uint (tw, ant1);
+      QDPLL_TRACE_PUTC (tw, ' ');
+    }
   if (ant2)
-    fprintf (stdout, "%u ", ant2);
-  fprintf (stdout, "0\n");
+    {
+      qdpll_trace_put_uint (tw, ant2);
+      QDPLL_TRACE_PUTC (tw, ' ');
+    }
+  QDPLL_TRACE_PUTC (tw, '0');
+  QDPLL_TRACE_PUTC (tw, '\n');
 }
 
 static void
-print_bqrp_constraint (ConstraintID id, LitID * lits, unsigned int num_lits,
-                       ConstraintID ant1, ConstraintID ant2)
+print_bqrp_constraint (QDPLL * qdpll, ConstraintID id, LitID * lits,
+                       unsigned int num_lits, ConstraintID ant1,
+                       ConstraintID ant2)
 {
+  QDPLLTraceWriter *tw = qdpll->trace_writer;
   LitID *p;
 
-  encode_num (id, 0);
+  encode_num (tw, id, 0);
   for (p = lits; p < lits + num_lits; p++)
     if (*p)                     /* skip deleted */
-      encode_num (*p, 1);
-  encode_num (0, 0);
+      encode_num (tw, *p, 1);
+  encode_num (tw, 0, 0);
   if (ant1)
-    encode_num (ant1, 0);
+    encode_num (tw, ant1, 0);
   if (ant2)
-    encode_num (ant2, 0);
-  encode_num (0, 0);
+    encode_num (tw, ant2, 0);
+  encode_num (tw, 0, 0);
 }
 
 
@@ -1566,17 +1552,26 @@ print_qrp_full_cover_set (QDPLL * qdpll,
                           LitID * inner_lits, unsigned int num_inner_lits,
                           LitID * lits, unsigned int num_lits)
 {
+  QDPLLTraceWriter *tw = qdpll->trace_writer;
   LitID *p;
-  fprintf (stdout, "%u ", id);
+  qdpll_trace_put_uint (tw, id);
+  QDPLL_TRACE_PUTC (tw, ' ');
   for (p = inner_lits; p < inner_lits + num_inner_lits; p++)
     {
-      fprintf (stdout, "%d ", *p);
+      qdpll_trace_put_int (tw, *p);
+      QDPLL_TRACE_PUTC (tw, ' ');
       /* existential lits of innermost scope -> reset mark */
       (LIT2VARPTR (qdpll->pcnf.vars, *p))->mark_qrp = 0;
     }
   for (p = lits; p < lits + num_lits; p++)
-    fprintf (stdout, "%d ", *p);
-  fprintf (stdout, "0 0\n");
+    {
+      qdpll_trace_put_int (tw, *p);
+      QDPLL_TRACE_PUTC (tw, ' ');
+    }
+  QDPLL_TRACE_PUTC (tw, '0');
+  QDPLL_TRACE_PUTC (tw, ' ');
+  QDPLL_TRACE_PUTC (tw, '0');
+  QDPLL_TRACE_PUTC (tw, '\n');
 }
 
 
@@ -1586,51 +1581,59 @@ print_bqrp_full_cover_set (QDPLL * qdpll,
                            LitID * inner_lits, unsigned int num_inner_lits,
                            LitID * lits, unsigned int num_lits)
 {
+  QDPLLTraceWriter *tw = qdpll->trace_writer;
   LitID *p;
-  encode_num (id, 0);
+  encode_num (tw, id, 0);
   for (p = inner_lits; p < inner_lits + num_inner_lits; p++)
     {
-      encode_num (*p, 1);
+      encode_num (tw, *p, 1);
       /* existential lits of innermost scope -> reset mark */
       (LIT2VARPTR (qdpll->pcnf.vars, *p))->mark_qrp = 0;
     }
   for (p = lits; p < lits + num_lits; p++)
-    encode_num (*p, 1);
-  encode_num (0, 0);
-  encode_num (0, 0);
+    encode_num (tw, *p, 1);
+  encode_num (tw, 0, 0);
+  encode_num (tw, 0, 0);
 }
 
 
 static void
-print_qrp_scope (Scope * scope)
+print_qrp_scope (QDPLL * qdpll, Scope * scope)
 {
+  QDPLLTraceWriter *tw = qdpll->trace_writer;
   VarID *p;
 
   if (QDPLL_SCOPE_EXISTS (scope))
-    fprintf (stdout, "e");
+    QDPLL_TRACE_PUTC (tw, 'e');
   else
-    fprintf (stdout, "a");
+    QDPLL_TRACE_PUTC (tw, 'a');
 
   for (p = scope->vars.start; p < scope->vars.top; p++)
-    fprintf (stdout, " %u", *p);
-  fprintf (stdout, " 0\n");
+    {
+      QDPLL_TRACE_PUTC (tw, ' ');
+      qdpll_trace_put_uint (tw, *p);
+    }
+  QDPLL_TRACE_PUTC (tw, ' ');
+  QDPLL_TRACE_PUTC (tw, '0');
+  QDPLL_TRACE_PUTC (tw, '\n');
 }
 
 
 static void
-print_bqrp_scope (Scope * scope)
+print_bqrp_scope (QDPLL * qdpll, Scope * scope)
 {
+  QDPLLTraceWriter *tw = qdpll->trace_writer;
   VarID *p;
 
-  encode_num (0, 0);
+  encode_num (tw, 0, 0);
   if (QDPLL_SCOPE_EXISTS (scope))
-    fprintf (stdout, "e");
+    QDPLL_TRACE_PUTC (tw, 'e');
   else
-    fprintf (stdout, "a");
+    QDPLL_TRACE_PUTC (tw, 'a');
 
   for (p = scope->vars.start; p < scope->vars.top; p++)
-    encode_num (*p, 0);
-  encode_num (0, 0);
+    encode_num (tw, *p, 0);
+  encode_num (tw, 0, 0);
 }
 
 /* --------------------- END: TRACING-ONLY CODE --------------------- */
@@ -1673,7 +1676,7 @@ compute_constraint_lbd (QDPLL * qdpll, Constraint * c)
       LitID lit = *p;
       Var *var = LIT2VARPTR (vars, lit);
       unsigned int pos =
-        QDPLL_VAR_ASSIGNED (var) ? var->decision_level : dec_level + 1;
+        QDPLL_VAR_ASSIGNED (qdpll->pcnf, var) ? QDPLL_VAR_LEVEL (qdpll->pcnf, var) : dec_level + 1;
       assert (pos < dec_level + 2);
       level_classes[pos] = 1;
     }
@@ -1697,7 +1700,7 @@ var_pqueue_adjust (QDPLL * qdpll, unsigned int size)
 
   if ((old_size = qdpll->size_var_pqueue) < size)
     {
-      QDPLLMemMan *mm = qdpll->mm;
+      QDPLLMemMan *mm = PQUEUE_MM (qdpll);
       qdpll->var_pqueue = qdpll_realloc (mm, qdpll->var_pqueue,
                                          old_size * sizeof (VarID),
                                          size * sizeof (VarID));
@@ -2094,7 +2097,8 @@ enlarge_assigned_vars (QDPLL * qdpll)
   size_t old_old_bcp_index = qdpll->old_bcp_ptr - qdpll->assigned_vars;
   size_t new_size = old_size ? 2 * old_size : 1;
   qdpll->assigned_vars =
-    (VarID *) qdpll_realloc (qdpll->mm, qdpll->assigned_vars,
+    (VarID *) qdpll_realloc (TRAIL_MM (qdpll),
+                             qdpll->assigned_vars,
                              old_size * sizeof (VarID),
                              new_size * sizeof (VarID));
   qdpll->assigned_vars_end = qdpll->assigned_vars + new_size;
@@ -2113,8 +2117,8 @@ push_assigned_vars (QDPLL * qdpll, VarID id)
   assert (qdpll->assigned_vars <= qdpll->assigned_vars_top);
 
   Var *var = VARID2VARPTR (qdpll->pcnf.vars, id);
-  assert (var->trail_pos == QDPLL_INVALID_TRAIL_POS);
-  var->trail_pos = qdpll->assigned_vars_top - qdpll->assigned_vars;
+  assert (QDPLL_VAR_TRAIL_POS (qdpll->pcnf, var) == QDPLL_INVALID_TRAIL_POS);
+  QDPLL_VAR_TRAIL_POS (qdpll->pcnf, var) = qdpll->assigned_vars_top - qdpll->assigned_vars;
 
   *(qdpll->assigned_vars_top++) = id;
 }
@@ -2135,7 +2139,7 @@ is_clause_empty (QDPLL * qdpll, Constraint * clause)
       LitID lit = *p;
       Var *var = LIT2VARPTR (vars, lit);
 
-      if (!QDPLL_VAR_ASSIGNED (var))
+      if (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, var))
         {
           if (QDPLL_VAR_EXISTS (var))
             return 0;
@@ -2144,13 +2148,13 @@ is_clause_empty (QDPLL * qdpll, Constraint * clause)
         {
           if (QDPLL_LIT_NEG (lit))
             {
-              if (QDPLL_VAR_ASSIGNED_FALSE (var))
+              if (QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var))
                 return 0;
             }
           else
             {
               assert (QDPLL_LIT_POS (lit));
-              if (QDPLL_VAR_ASSIGNED_TRUE (var))
+              if (QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var))
                 return 0;
             }
         }
@@ -2203,7 +2207,7 @@ is_clause_satisfied (QDPLL * qdpll, Constraint * clause)
 
       if (QDPLL_LIT_NEG (wlit))
         {
-          if (QDPLL_VAR_ASSIGNED_FALSE (wvar))
+          if (QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, wvar))
             {
               assert (wvar->pos_notify_lit_watchers.start +
                       clause->offset_in_notify_list[0] <
@@ -2222,7 +2226,7 @@ is_clause_satisfied (QDPLL * qdpll, Constraint * clause)
       else
         {
           assert (QDPLL_LIT_POS (wlit));
-          if (QDPLL_VAR_ASSIGNED_TRUE (wvar))
+          if (QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, wvar))
             {
               assert (wvar->neg_notify_lit_watchers.start +
                       clause->offset_in_notify_list[0] <
@@ -2247,7 +2251,7 @@ is_clause_satisfied (QDPLL * qdpll, Constraint * clause)
 
       if (QDPLL_LIT_NEG (wlit))
         {
-          if (QDPLL_VAR_ASSIGNED_FALSE (wvar))
+          if (QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, wvar))
             {
               assert (wvar->pos_notify_lit_watchers.start +
                       clause->offset_in_notify_list[1] <
@@ -2266,7 +2270,7 @@ is_clause_satisfied (QDPLL * qdpll, Constraint * clause)
       else
         {
           assert (QDPLL_LIT_POS (wlit));
-          if (QDPLL_VAR_ASSIGNED_TRUE (wvar))
+          if (QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, wvar))
             {
               assert (wvar->neg_notify_lit_watchers.start +
                       clause->offset_in_notify_list[1] <
@@ -2297,7 +2301,7 @@ is_clause_satisfied (QDPLL * qdpll, Constraint * clause)
 
       if (QDPLL_LIT_NEG (lit))
         {
-          if (QDPLL_VAR_ASSIGNED_FALSE (var))
+          if (QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var))
             {
               return lit;
             }
@@ -2305,7 +2309,7 @@ is_clause_satisfied (QDPLL * qdpll, Constraint * clause)
       else
         {
           assert (QDPLL_LIT_POS (lit));
-          if (QDPLL_VAR_ASSIGNED_TRUE (var))
+          if (QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var))
             {
               return lit;
             }
@@ -2349,7 +2353,7 @@ is_clause_satisfied_by_prop_var (QDPLL * qdpll, Constraint * clause)
 
       if (QDPLL_LIT_NEG (wlit))
         {
-          if (QDPLL_VAR_ASSIGNED_FALSE (wvar)
+          if (QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, wvar)
               && QDPLL_VAR_MARKED_PROPAGATED (wvar))
             {
 #if COMPUTE_STATS
@@ -2361,7 +2365,7 @@ is_clause_satisfied_by_prop_var (QDPLL * qdpll, Constraint * clause)
       else
         {
           assert (QDPLL_LIT_POS (wlit));
-          if (QDPLL_VAR_ASSIGNED_TRUE (wvar)
+          if (QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, wvar)
               && QDPLL_VAR_MARKED_PROPAGATED (wvar))
             {
 #if COMPUTE_STATS
@@ -2379,7 +2383,7 @@ is_clause_satisfied_by_prop_var (QDPLL * qdpll, Constraint * clause)
 
       if (QDPLL_LIT_NEG (wlit))
         {
-          if (QDPLL_VAR_ASSIGNED_FALSE (wvar)
+          if (QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, wvar)
               && QDPLL_VAR_MARKED_PROPAGATED (wvar))
             {
 #if COMPUTE_STATS
@@ -2391,7 +2395,7 @@ is_clause_satisfied_by_prop_var (QDPLL * qdpll, Constraint * clause)
       else
         {
           assert (QDPLL_LIT_POS (wlit));
-          if (QDPLL_VAR_ASSIGNED_TRUE (wvar)
+          if (QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, wvar)
               && QDPLL_VAR_MARKED_PROPAGATED (wvar))
             {
 #if COMPUTE_STATS
@@ -2415,7 +2419,7 @@ is_clause_satisfied_by_prop_var (QDPLL * qdpll, Constraint * clause)
 
       if (QDPLL_LIT_NEG (lit))
         {
-          if (QDPLL_VAR_ASSIGNED_FALSE (var)
+          if (QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var)
               && QDPLL_VAR_MARKED_PROPAGATED (var))
             {
               return 1;
@@ -2424,7 +2428,7 @@ is_clause_satisfied_by_prop_var (QDPLL * qdpll, Constraint * clause)
       else
         {
           assert (QDPLL_LIT_POS (lit));
-          if (QDPLL_VAR_ASSIGNED_TRUE (var)
+          if (QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var)
               && QDPLL_VAR_MARKED_PROPAGATED (var))
             {
               return 1;
@@ -2452,7 +2456,7 @@ is_cube_satisfied (QDPLL * qdpll, Constraint * cube)
       /* Must check if all cube literals are both assigned and
          propagated. */
 
-      if (!QDPLL_VAR_ASSIGNED (var))
+      if (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, var))
         {
           if (QDPLL_VAR_FORALL (var))
             return 0;
@@ -2461,13 +2465,13 @@ is_cube_satisfied (QDPLL * qdpll, Constraint * cube)
         {
           if (QDPLL_LIT_NEG (lit))
             {
-              if (QDPLL_VAR_ASSIGNED_TRUE (var))
+              if (QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var))
                 return 0;
             }
           else
             {
               assert (QDPLL_LIT_POS (lit));
-              if (QDPLL_VAR_ASSIGNED_FALSE (var))
+              if (QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var))
                 return 0;
             }
         }
@@ -2503,7 +2507,7 @@ is_cube_empty (QDPLL * qdpll, Constraint * cube)
 
       if (QDPLL_LIT_NEG (wlit))
         {
-          if (QDPLL_VAR_ASSIGNED_TRUE (wvar))
+          if (QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, wvar))
             {
               assert (wvar->neg_notify_lit_watchers.start +
                       cube->offset_in_notify_list[0] <
@@ -2522,7 +2526,7 @@ is_cube_empty (QDPLL * qdpll, Constraint * cube)
       else
         {
           assert (QDPLL_LIT_POS (wlit));
-          if (QDPLL_VAR_ASSIGNED_FALSE (wvar))
+          if (QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, wvar))
             {
               assert (wvar->pos_notify_lit_watchers.start +
                       cube->offset_in_notify_list[0] <
@@ -2551,7 +2555,7 @@ is_cube_empty (QDPLL * qdpll, Constraint * cube)
 
       if (QDPLL_LIT_NEG (wlit))
         {
-          if (QDPLL_VAR_ASSIGNED_TRUE (wvar))
+          if (QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, wvar))
             {
               assert (wvar->neg_notify_lit_watchers.start +
                       cube->offset_in_notify_list[1] <
@@ -2570,7 +2574,7 @@ is_cube_empty (QDPLL * qdpll, Constraint * cube)
       else
         {
           assert (QDPLL_LIT_POS (wlit));
-          if (QDPLL_VAR_ASSIGNED_FALSE (wvar))
+          if (QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, wvar))
             {
               assert (wvar->pos_notify_lit_watchers.start +
                       cube->offset_in_notify_list[1] <
@@ -2600,7 +2604,7 @@ is_cube_empty (QDPLL * qdpll, Constraint * cube)
 
       if (QDPLL_LIT_NEG (lit))
         {
-          if (QDPLL_VAR_ASSIGNED_TRUE (var))
+          if (QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var))
             {
               return lit;
             }
@@ -2608,7 +2612,7 @@ is_cube_empty (QDPLL * qdpll, Constraint * cube)
       else
         {
           assert (QDPLL_LIT_POS (lit));
-          if (QDPLL_VAR_ASSIGNED_FALSE (var))
+          if (QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var))
             {
               return lit;
             }
@@ -2631,7 +2635,7 @@ is_cube_unit (QDPLL * qdpll, Constraint * cube)
     {
       LitID lit = *p;
       Var *var = LIT2VARPTR (vars, lit);
-      if (QDPLL_VAR_ASSIGNED (var))
+      if (QDPLL_VAR_ASSIGNED (qdpll->pcnf, var))
         {
           /* Must check if cube literals are both assigned and
              propagated. */
@@ -2639,19 +2643,19 @@ is_cube_unit (QDPLL * qdpll, Constraint * cube)
           /* Detect false literals. */
           if (QDPLL_LIT_NEG (lit))
             {
-              if (QDPLL_VAR_ASSIGNED_TRUE (var))
+              if (QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var))
                 return 0;
             }
           else
             {
               assert (QDPLL_LIT_POS (lit));
-              if (QDPLL_VAR_ASSIGNED_FALSE (var))
+              if (QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var))
                 return 0;
             }
         }
       else
         {
-          assert (!QDPLL_VAR_ASSIGNED (var));
+          assert (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, var));
           /* Find largest unassigned universal literal... */
           if (QDPLL_SCOPE_FORALL (var->scope))
             {
@@ -2661,7 +2665,7 @@ is_cube_unit (QDPLL * qdpll, Constraint * cube)
                 {
                   LitID lit2 = *p2;
                   Var *var2 = LIT2VARPTR (vars, lit2);
-                  if (QDPLL_VAR_ASSIGNED (var2))
+                  if (QDPLL_VAR_ASSIGNED (qdpll->pcnf, var2))
                     {
                       /* Must check if all cube literals are both assigned and
                          propagated. */
@@ -2669,20 +2673,20 @@ is_cube_unit (QDPLL * qdpll, Constraint * cube)
                       /* Detect false literals. */
                       if (QDPLL_LIT_NEG (lit2))
                         {
-                          if (QDPLL_VAR_ASSIGNED_TRUE (var2))
+                          if (QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var2))
                             return 0;
                         }
                       else
                         {
                           assert (QDPLL_LIT_POS (lit2));
-                          if (QDPLL_VAR_ASSIGNED_FALSE (var2))
+                          if (QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var2))
                             return 0;
                         }
                     }
                   else
                     {
                       /* Found a second unassigned literal. */
-                      assert (!QDPLL_VAR_ASSIGNED (var2));
+                      assert (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, var2));
                       return 0;
                     }
                 }
@@ -3057,15 +3061,15 @@ add_watching_var_to_notify_lists (QDPLL * qdpll, LitID signed_id,
           assert (count_in_notify_clause_watcher_list
                   (notify_list, signed_id) == 0);
           /* Store offsets. */
-          QDPLL_PUSH_STACK (mm, *offset_in_notify_list,
-                            QDPLL_COUNT_STACK (*notify_list));
-          QDPLL_PUSH_STACK (mm, *offset_in_watched_clause, offset);
-          QDPLL_PUSH_STACK (mm, *notify_list, signed_id);
+          QDPLL_PUSH_STACK_UNINIT (mm, *offset_in_notify_list,
+                                   QDPLL_COUNT_STACK (*notify_list));
+          QDPLL_PUSH_STACK_UNINIT (mm, *offset_in_watched_clause, offset);
+          QDPLL_PUSH_STACK_UNINIT (mm, *notify_list, signed_id);
           assert (count_in_notify_clause_watcher_list
                   (notify_list, signed_id) == 1);
         }
       else                      /* Push dummy entry. */
-        QDPLL_PUSH_STACK (mm, *offset_in_notify_list, 0);
+        QDPLL_PUSH_STACK_UNINIT (mm, *offset_in_notify_list, 0);
       offset++;
     }
   assert (QDPLL_COUNT_STACK (*offset_in_notify_list) ==
@@ -3085,7 +3089,7 @@ set_new_watcher (QDPLL * qdpll, LitID signed_id, BLitsOccStack * occ_list,
 
   /* Add watching variable's ID to notify-lists of variable in watched clause. */
   add_watching_var_to_notify_lists (qdpll, signed_id,
-                                    BLIT_STRIP_PTR (tmp.constraint));
+                                    BLIT_CONSTRAINT (qdpll->pcnf, tmp));
 }
 
 
@@ -3138,9 +3142,7 @@ find_and_set_new_watcher (QDPLL * qdpll, LitID lit, BLitsOccStack * occ_list,
           /* We have found a new watcher. */
           if (!init)
             remove_watching_var_from_notify_lists (qdpll, lit,
-                                                   BLIT_STRIP_PTR
-                                                   (old_watcher_list->
-                                                    start[0].constraint));
+                                                   BLIT_CONSTRAINT (qdpll->pcnf, old_watcher_list->start[0]));
           set_new_watcher (qdpll, lit, occ_list, bp);
           return c;
         }
@@ -3164,7 +3166,7 @@ update_empty_formula_watcher_toggle_var_marks (QDPLL *qdpll,
   assert (value == 0 || value == 1);
   if (!watched_blit)
     return;
-  Constraint *watched_clause = watched_blit->constraint;
+  Constraint *watched_clause = BLIT_CONSTRAINT (qdpll->pcnf, *watched_blit);
   LitID *p, *e;
   for (p = watched_clause->lits, e = p + watched_clause->num_lits; p < e; p++)
     {
@@ -3193,8 +3195,8 @@ static BLitsOcc *
 update_empty_formula_watcher (QDPLL *qdpll)
 {
   BLitsOcc *cur_watcher_p = qdpll->empty_formula_watcher;
-  assert (!cur_watcher_p || cur_watcher_p->constraint->qbcp_qbce_blocked || 
-          !is_clause_empty (qdpll, cur_watcher_p->constraint));
+  assert (!cur_watcher_p || BLIT_CONSTRAINT (qdpll->pcnf, *cur_watcher_p)->qbcp_qbce_blocked || 
+          !is_clause_empty (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, *cur_watcher_p)));
 #if COMPUTE_STATS
   qdpll->stats.empty_formula_watcher_total_update_calls++;
 #endif
@@ -3203,8 +3205,8 @@ update_empty_formula_watcher (QDPLL *qdpll)
       /* If no update is scheduled, then the current watched clause is still
          unsatisfied and non-blocked under the current assignment. */
       assert (cur_watcher_p || qdpll->pcnf.clauses.cnt == 0);
-      assert (!cur_watcher_p || !cur_watcher_p->constraint->qbcp_qbce_blocked);
-      assert (!cur_watcher_p || !is_clause_satisfied (qdpll, cur_watcher_p->constraint));
+      assert (!cur_watcher_p || !BLIT_CONSTRAINT (qdpll->pcnf, *cur_watcher_p)->qbcp_qbce_blocked);
+      assert (!cur_watcher_p || !is_clause_satisfied (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, *cur_watcher_p)));
       return cur_watcher_p;
     }
 #if COMPUTE_STATS
@@ -3230,9 +3232,9 @@ update_empty_formula_watcher (QDPLL *qdpll)
 #endif
       /* This branch should save calls of 'is_clause_satisfied'. */
       /* Must handle empty input clauses. */
-      assert (cur_watcher_p->blit || cur_watcher_p->constraint->num_lits == 0);
+      assert (cur_watcher_p->blit || BLIT_CONSTRAINT (qdpll->pcnf, *cur_watcher_p)->num_lits == 0);
       Constraint *cur_watcher = cur_watcher_p->blit ?
-        check_disabling_blocking_lit (qdpll, *cur_watcher_p, 0) : cur_watcher_p->constraint;
+        check_disabling_blocking_lit (qdpll, *cur_watcher_p, 0) : BLIT_CONSTRAINT (qdpll->pcnf, *cur_watcher_p);
           /* Check if clause is satisfied by cached literal. */
           if (!cur_watcher)
             {
@@ -3298,20 +3300,17 @@ notify_clause_watching_variables_aux (QDPLL * qdpll, LitID signed_id, Var *v)
           /* First search neg-occ cubes, then neg-occ clauses. */
           assert (is_cube_empty
                   (qdpll,
-                   BLIT_STRIP_PTR (v->neg_occ_cubes.start[0].
-                                   constraint)));
+                   BLIT_CONSTRAINT (qdpll->pcnf, v->neg_occ_cubes.start[0])));
           occs = &(v->neg_occ_cubes);
           next_occs = &(v->neg_occ_clauses);
         }
       else
         {
           /* First search neg-occ clauses, then neg-occ cubes. */
-          assert (BLIT_STRIP_PTR (v->neg_occ_clauses.start[0].
-                                   constraint)->qbcp_qbce_blocked || 
+          assert (BLIT_CONSTRAINT (qdpll->pcnf, v->neg_occ_clauses.start[0])->qbcp_qbce_blocked || 
                   is_clause_satisfied
                   (qdpll,
-                   BLIT_STRIP_PTR (v->neg_occ_clauses.start[0].
-                                   constraint)));
+                   BLIT_CONSTRAINT (qdpll->pcnf, v->neg_occ_clauses.start[0])));
           occs = &(v->neg_occ_clauses);
           next_occs = &(v->neg_occ_cubes);
         }
@@ -3327,20 +3326,17 @@ notify_clause_watching_variables_aux (QDPLL * qdpll, LitID signed_id, Var *v)
           /* First search pos-occ cubes, then pos-occ clauses. */
           assert (is_cube_empty
                   (qdpll,
-                   BLIT_STRIP_PTR (v->pos_occ_cubes.start[0].
-                                   constraint)));
+                   BLIT_CONSTRAINT (qdpll->pcnf, v->pos_occ_cubes.start[0])));
           occs = &(v->pos_occ_cubes);
           next_occs = &(v->pos_occ_clauses);
         }
       else
         {
           /* First search pos-occ clauses, then pos-occ cubes. */
-          assert (BLIT_STRIP_PTR (v->pos_occ_clauses.start[0].
-                                   constraint)->qbcp_qbce_blocked || 
+          assert (BLIT_CONSTRAINT (qdpll->pcnf, v->pos_occ_clauses.start[0])->qbcp_qbce_blocked || 
                   is_clause_satisfied
                   (qdpll,
-                   BLIT_STRIP_PTR (v->pos_occ_clauses.start[0].
-                                   constraint)));
+                   BLIT_CONSTRAINT (qdpll->pcnf, v->pos_occ_clauses.start[0])));
           occs = &(v->pos_occ_clauses);
           next_occs = &(v->pos_occ_cubes);
         }
@@ -3386,7 +3382,7 @@ notify_clause_watching_variables (QDPLL * qdpll, LitIDStack * notify_list)
       LitID signed_id = *p;
       v = LIT2VARPTR (vars, signed_id);
 
-      if (QDPLL_VAR_ASSIGNED (v))
+      if (QDPLL_VAR_ASSIGNED (qdpll->pcnf, v))
         continue;
 
 #ifndef NDEBUG
@@ -3426,9 +3422,9 @@ init_clause_watchers (QDPLL * qdpll)
           assert (!v->mark_is_neg_watching_cube);
           assert (!v->mark_is_pos_watching_cube);
 
-          if (QDPLL_VAR_ASSIGNED (v))
+          if (QDPLL_VAR_ASSIGNED (qdpll->pcnf, v))
             {
-              assert (v->decision_level == 0);
+              assert (QDPLL_VAR_LEVEL (qdpll->pcnf, v) == 0);
               continue;
             }
 
@@ -3447,7 +3443,7 @@ init_clause_watchers (QDPLL * qdpll)
             }
           else
             {                   /* Pure literal detected: variable has no negative occurrences. */
-              assert (!QDPLL_VAR_ASSIGNED (v));
+              assert (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, v));
               if (QDPLL_VAR_EXISTS (v))
                 {
                   push_assigned_variable (qdpll, v, QDPLL_ASSIGNMENT_TRUE,
@@ -3477,7 +3473,7 @@ init_clause_watchers (QDPLL * qdpll)
             }
           else
             {                   /* Pure literal detected: variable has no positive occurrences. */
-              assert (!QDPLL_VAR_ASSIGNED (v));
+              assert (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, v));
               if (QDPLL_VAR_EXISTS (v))
                 {
                   push_assigned_variable (qdpll, v, QDPLL_ASSIGNMENT_FALSE,
@@ -3505,36 +3501,35 @@ update_blocking_literal (QDPLL * qdpll, Var * vars, BLitsOcc * blit_ptr,
                          Var * disabling_var, const int is_cube)
 {
   assert (((QDPLL_LIT_NEG (disabling_lit) &&
-            ((!is_cube && QDPLL_VAR_ASSIGNED_FALSE (disabling_var)) ||
-             (is_cube && QDPLL_VAR_ASSIGNED_TRUE (disabling_var)))) ||
+            ((!is_cube && QDPLL_LIT_VAR_ASSIGNED_FALSE (qdpll->pcnf, disabling_lit)) ||
+             (is_cube && QDPLL_LIT_VAR_ASSIGNED_TRUE (qdpll->pcnf, disabling_lit)))) ||
            (QDPLL_LIT_POS (disabling_lit) &&
-            ((!is_cube && QDPLL_VAR_ASSIGNED_TRUE (disabling_var)) ||
-             (is_cube && QDPLL_VAR_ASSIGNED_FALSE (disabling_var))))));
+            ((!is_cube && QDPLL_LIT_VAR_ASSIGNED_TRUE (qdpll->pcnf, disabling_lit)) ||
+             (is_cube && QDPLL_LIT_VAR_ASSIGNED_FALSE (qdpll->pcnf, disabling_lit))))));
   assert (LIT2VARPTR (vars, disabling_lit) == disabling_var);
 #if COMPUTE_STATS
   qdpll->stats.blits_update_calls++;
 #endif
-  assert (!BLIT_MARKED_PTR (c));
-  assert (c == BLIT_STRIP_PTR (blit_ptr->constraint));
+  assert (c == BLIT_CONSTRAINT (qdpll->pcnf, *blit_ptr));
   assert (blit_ptr->blit);
-  assert (blit_ptr->constraint);
+  assert (BLIT_CONSTRAINT (qdpll->pcnf, *blit_ptr));
   LitID cur_blit = blit_ptr->blit;
   Var *cur_bvar = LIT2VARPTR (vars, cur_blit);
   int cur_non_disabling = ((QDPLL_LIT_NEG (cur_blit) &&
-                            ((!is_cube && QDPLL_VAR_ASSIGNED_TRUE (cur_bvar))
+                            ((!is_cube && QDPLL_LIT_VAR_ASSIGNED_TRUE (qdpll->pcnf, cur_blit))
                              || (is_cube
-                                 && QDPLL_VAR_ASSIGNED_FALSE (cur_bvar))))
+                                 && QDPLL_LIT_VAR_ASSIGNED_FALSE (qdpll->pcnf, cur_blit))))
                            || (QDPLL_LIT_POS (cur_blit)
                                &&
                                ((!is_cube
-                                 && QDPLL_VAR_ASSIGNED_FALSE (cur_bvar))
+                                 && QDPLL_LIT_VAR_ASSIGNED_FALSE (qdpll->pcnf, cur_blit))
                                 || (is_cube
-                                    && QDPLL_VAR_ASSIGNED_TRUE (cur_bvar)))));
+                                    && QDPLL_LIT_VAR_ASSIGNED_TRUE (qdpll->pcnf, cur_blit)))));
   /* Set blocking literal only if cur. blocking literal is unassigned,
      assigned but non-disabling or assigned disabling but at higher
      level -> want to keep "good" blocking literals. */
-  if (!QDPLL_VAR_ASSIGNED (cur_bvar) || cur_non_disabling ||
-      cur_bvar->decision_level > disabling_var->decision_level)
+  if (!QDPLL_LIT_VAR_ASSIGNED (qdpll->pcnf, cur_blit) || cur_non_disabling ||
+      QDPLL_VARID_LEVEL (qdpll->pcnf, LIT2VARID (cur_blit)) > QDPLL_VARID_LEVEL (qdpll->pcnf, LIT2VARID (disabling_lit)))
     {
 #if COMPUTE_STATS
       qdpll->stats.blits_update_done++;
@@ -3552,7 +3547,6 @@ find_watcher_pos (QDPLL * qdpll, const int is_cube, Var * vars,
                   Constraint * c, LitID * right, LitID * left,
                   const QDPLLQuantifierType qtype, BLitsOcc * blit_ptr)
 {
-  assert (!BLIT_MARKED_PTR (c));
 #if COMPUTE_STATS
   qdpll->stats.total_lit_watcher_find_calls++;
 #endif
@@ -3578,7 +3572,7 @@ find_watcher_pos (QDPLL * qdpll, const int is_cube, Var * vars,
       LitID lit = *right;
       assert (lit != 0);
       Var *var = LIT2VARPTR (vars, lit);
-      if (!QDPLL_VAR_ASSIGNED (var))
+      if (!QDPLL_LIT_VAR_ASSIGNED (qdpll->pcnf, lit))
         {
           /* Literal unassigned. */
           if (qtype == QDPLL_QTYPE_UNDEF || qtype == var->scope->type)
@@ -3609,8 +3603,8 @@ find_watcher_pos (QDPLL * qdpll, const int is_cube, Var * vars,
           /* Check if assigned literal satisfies clause / falsifies cube. */
           if (QDPLL_LIT_NEG (lit))
             {
-              if ((!is_cube && QDPLL_VAR_ASSIGNED_FALSE (var)) ||
-                  (is_cube && QDPLL_VAR_ASSIGNED_TRUE (var)))
+              if ((!is_cube && QDPLL_LIT_VAR_ASSIGNED_FALSE (qdpll->pcnf, lit)) ||
+                  (is_cube && QDPLL_LIT_VAR_ASSIGNED_TRUE (qdpll->pcnf, lit)))
                 {
                   update_blocking_literal (qdpll, vars, blit_ptr, c, lit, var,
                                            is_cube);
@@ -3620,8 +3614,8 @@ find_watcher_pos (QDPLL * qdpll, const int is_cube, Var * vars,
           else
             {
               assert (QDPLL_LIT_POS (lit));
-              if ((!is_cube && QDPLL_VAR_ASSIGNED_TRUE (var)) ||
-                  (is_cube && QDPLL_VAR_ASSIGNED_FALSE (var)))
+              if ((!is_cube && QDPLL_LIT_VAR_ASSIGNED_TRUE (qdpll->pcnf, lit)) ||
+                  (is_cube && QDPLL_LIT_VAR_ASSIGNED_FALSE (qdpll->pcnf, lit)))
                 {
                   update_blocking_literal (qdpll, vars, blit_ptr, c, lit, var,
                                            is_cube);
@@ -3643,7 +3637,6 @@ remove_clause_from_notify_list (QDPLL * qdpll, const int is_cube,
                                 int lit_is_rwlit, LitID lit,
                                 Constraint * clause)
 {
-  assert (!BLIT_MARKED_PTR (clause));
   Var *vars = qdpll->pcnf.vars;
   Var *var = LIT2VARPTR (vars, lit);
   BLitsOccStack *notify_list;
@@ -3666,9 +3659,8 @@ remove_clause_from_notify_list (QDPLL * qdpll, const int is_cube,
 
   unsigned int offset = clause->offset_in_notify_list[lit_is_rwlit];
   BLitsOcc last_occ = QDPLL_POP_STACK (*notify_list);
-  Constraint *last_occ_constr = last_occ.constraint;
-  int marked = BLIT_MARKED_PTR (last_occ_constr);
-  last_occ_constr = BLIT_STRIP_PTR (last_occ_constr);
+  Constraint *last_occ_constr = BLIT_CONSTRAINT (qdpll->pcnf, last_occ);
+  int marked = BLIT_MARKED_REF (last_occ.cref);
   assert (marked || !last_occ_constr->is_cube);
   assert (!marked || last_occ_constr->is_cube);
 
@@ -3677,10 +3669,10 @@ remove_clause_from_notify_list (QDPLL * qdpll, const int is_cube,
 
   const int same_types = (clause->is_cube == last_occ_constr->is_cube);
   /* Overwrite the current position with the last entry. */
-  assert (BLIT_STRIP_PTR (notify_list->start[offset].constraint) == clause);
+  assert (BLIT_CONSTRAINT (qdpll->pcnf, notify_list->start[offset]) == clause);
   notify_list->start[offset] = last_occ;
   assert (notify_list->start[offset].blit == last_occ.blit);
-  assert (notify_list->start[offset].constraint == last_occ.constraint);
+  assert (BLIT_CONSTRAINT (qdpll->pcnf, notify_list->start[offset]) == BLIT_CONSTRAINT (qdpll->pcnf, last_occ));
   /* Must update position information in the copied entry. */
   unsigned int *other_offsetp = last_occ_constr->offset_in_notify_list;
   LitID other_wlit = *(last_occ_constr->lits + last_occ_constr->lwatcher_pos);
@@ -3703,7 +3695,7 @@ static void
 add_clause_to_notify_list (QDPLL * qdpll, const int is_cube, int lit_is_rwlit,
                            LitID lit, Var * var, BLitsOcc blit)
 {
-  Constraint *clause = BLIT_STRIP_PTR (blit.constraint);
+  Constraint *clause = BLIT_CONSTRAINT (qdpll->pcnf, blit);
   QDPLLMemMan *mm = qdpll->mm;
   /* Add clause to notification list wrt. sign of literal. */
   BLitsOccStack *other_notify_list;
@@ -3727,7 +3719,7 @@ add_clause_to_notify_list (QDPLL * qdpll, const int is_cube, int lit_is_rwlit,
   /* Store clauses's position in notify-list. */
   clause->offset_in_notify_list[lit_is_rwlit] =
     QDPLL_COUNT_STACK (*other_notify_list);
-  QDPLL_PUSH_STACK (mm, *other_notify_list, blit);
+  QDPLL_PUSH_STACK_UNINIT (mm, *other_notify_list, blit);
   assert (count_in_notify_literal_watcher_list (other_notify_list, clause) ==
           1);
 }
@@ -3754,14 +3746,14 @@ has_constraint_spurious_pure_lit (QDPLL * qdpll, Constraint * c)
       Var *var = LIT2VARPTR (vars, lit);
       if (var->mode == QDPLL_VARMODE_PURE)
         {
-          assert (QDPLL_VAR_ASSIGNED (var));
+          assert (QDPLL_VAR_ASSIGNED (qdpll->pcnf, var));
           if (!is_cube && QDPLL_SCOPE_EXISTS (var->scope))
             {
               /* A false existential pure literal in a learnt clause
                  is always spurious. Normally, pure existential literals
                  always satisfy clauses. */
-              if ((QDPLL_LIT_NEG (lit) && QDPLL_VAR_ASSIGNED_TRUE (var)) ||
-                  (QDPLL_LIT_POS (lit) && QDPLL_VAR_ASSIGNED_FALSE (var)))
+              if ((QDPLL_LIT_NEG (lit) && QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var)) ||
+                  (QDPLL_LIT_POS (lit) && QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var)))
                 return 1;
             }
           else if (is_cube && QDPLL_SCOPE_FORALL (var->scope))
@@ -3769,8 +3761,8 @@ has_constraint_spurious_pure_lit (QDPLL * qdpll, Constraint * c)
               /* A true universal pure literal in a learnt cube
                  is always spurious. Normally, pure universal literals
                  always falsify cubes. */
-              if ((QDPLL_LIT_NEG (lit) && QDPLL_VAR_ASSIGNED_FALSE (var)) ||
-                  (QDPLL_LIT_POS (lit) && QDPLL_VAR_ASSIGNED_TRUE (var)))
+              if ((QDPLL_LIT_NEG (lit) && QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var)) ||
+                  (QDPLL_LIT_POS (lit) && QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var)))
                 return 1;
             }
         }
@@ -3784,7 +3776,7 @@ static Constraint *
 handle_detected_unit_constraint (QDPLL * qdpll, LitID lit, Var * var,
                                  Constraint * constraint)
 {
-  assert (!QDPLL_VAR_ASSIGNED (var));
+  assert (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, var));
   assert (!QDPLL_VAR_MARKED_PROPAGATED (var));
   assert (!constraint->qbcp_qbce_blocked);
 
@@ -3846,7 +3838,7 @@ update_literal_watchers (QDPLL * qdpll, Var * propagated_var,
                          BLitsOcc * blit_ptr)
 {
   BLitsOcc blit = *blit_ptr;
-  Constraint *clause = BLIT_STRIP_PTR (blit.constraint);
+  Constraint *clause = BLIT_CONSTRAINT (qdpll->pcnf, blit);
   assert (!clause->qbcp_qbce_blocked);
 
 #if COMPUTE_STATS
@@ -3860,7 +3852,7 @@ update_literal_watchers (QDPLL * qdpll, Var * propagated_var,
      to watch original unit clauses for UNSAT-checking. */
   assert (clause->num_lits > 1);
 
-  assert (QDPLL_VAR_ASSIGNED (propagated_var));
+  assert (QDPLL_VAR_ASSIGNED (qdpll->pcnf, propagated_var));
   assert (QDPLL_VAR_MARKED_PROPAGATED (propagated_var));
   assert (clause->num_lits == 1
           || clause->lwatcher_pos < clause->rwatcher_pos);
@@ -3878,8 +3870,8 @@ update_literal_watchers (QDPLL * qdpll, Var * propagated_var,
 
   if (QDPLL_LIT_NEG (lwlit))
     {
-      if ((!is_cube && QDPLL_VAR_ASSIGNED_FALSE (lwvar)) ||
-          (is_cube && QDPLL_VAR_ASSIGNED_TRUE (lwvar)))
+      if ((!is_cube && QDPLL_LIT_VAR_ASSIGNED_FALSE (qdpll->pcnf, lwlit)) ||
+          (is_cube && QDPLL_LIT_VAR_ASSIGNED_TRUE (qdpll->pcnf, lwlit)))
         {
           /* True watcher must not equal blocking lit, otherwise we
              should have detected that before. */
@@ -3895,8 +3887,8 @@ update_literal_watchers (QDPLL * qdpll, Var * propagated_var,
   else
     {
       assert (QDPLL_LIT_POS (lwlit));
-      if ((!is_cube && QDPLL_VAR_ASSIGNED_TRUE (lwvar)) ||
-          (is_cube && QDPLL_VAR_ASSIGNED_FALSE (lwvar)))
+      if ((!is_cube && QDPLL_LIT_VAR_ASSIGNED_TRUE (qdpll->pcnf, lwlit)) ||
+          (is_cube && QDPLL_LIT_VAR_ASSIGNED_FALSE (qdpll->pcnf, lwlit)))
         {
           /* True watcher must not equal blocking lit, otherwise we
              should have detected that before. */
@@ -3916,8 +3908,8 @@ update_literal_watchers (QDPLL * qdpll, Var * propagated_var,
 
   if (QDPLL_LIT_NEG (rwlit))
     {
-      if ((!is_cube && QDPLL_VAR_ASSIGNED_FALSE (rwvar)) ||
-          (is_cube && QDPLL_VAR_ASSIGNED_TRUE (rwvar)))
+      if ((!is_cube && QDPLL_LIT_VAR_ASSIGNED_FALSE (qdpll->pcnf, rwlit)) ||
+          (is_cube && QDPLL_LIT_VAR_ASSIGNED_TRUE (qdpll->pcnf, rwlit)))
         {
           /* True watcher must not equal blocking lit, otherwise we
              should have detected that before. */
@@ -3933,8 +3925,8 @@ update_literal_watchers (QDPLL * qdpll, Var * propagated_var,
   else
     {
       assert (QDPLL_LIT_POS (rwlit));
-      if ((!is_cube && QDPLL_VAR_ASSIGNED_TRUE (rwvar)) ||
-          (is_cube && QDPLL_VAR_ASSIGNED_FALSE (rwvar)))
+      if ((!is_cube && QDPLL_LIT_VAR_ASSIGNED_TRUE (qdpll->pcnf, rwlit)) ||
+          (is_cube && QDPLL_LIT_VAR_ASSIGNED_FALSE (qdpll->pcnf, rwlit)))
         {
           /* True watcher must not equal blocking lit, otherwise we
              should have detected that before. */
@@ -3950,24 +3942,24 @@ update_literal_watchers (QDPLL * qdpll, Var * propagated_var,
 
   assert (is_cube || QDPLL_VAR_EXISTS (rwvar));
   assert (!is_cube || QDPLL_VAR_FORALL (rwvar));
-  assert (QDPLL_VAR_ASSIGNED (lwvar) || QDPLL_VAR_ASSIGNED (rwvar));
+  assert (QDPLL_LIT_VAR_ASSIGNED (qdpll->pcnf, lwlit) || QDPLL_LIT_VAR_ASSIGNED (qdpll->pcnf, rwlit));
   assert (rwlit != 0);
   assert (lwlit != 0);
   assert (clause->num_lits == 1 || rwlit != lwlit);
   assert (clause->num_lits == 1 || -rwlit != lwlit);
 
-  if (!QDPLL_VAR_ASSIGNED (rwvar))
+  if (!QDPLL_LIT_VAR_ASSIGNED (qdpll->pcnf, rwlit))
     {
       /* Left watcher assigned. Here, conflicts/solutions can NOT occur. */
       assert (lwvar == propagated_var);
       assert (is_cube || QDPLL_LIT_POS (lwlit)
-              || QDPLL_VAR_ASSIGNED_TRUE (lwvar));
+              || QDPLL_LIT_VAR_ASSIGNED_TRUE (qdpll->pcnf, lwlit));
       assert (is_cube || QDPLL_LIT_NEG (lwlit)
-              || QDPLL_VAR_ASSIGNED_FALSE (lwvar));
+              || QDPLL_LIT_VAR_ASSIGNED_FALSE (qdpll->pcnf, lwlit));
       assert (!is_cube || QDPLL_LIT_POS (lwlit)
-              || QDPLL_VAR_ASSIGNED_FALSE (lwvar));
+              || QDPLL_LIT_VAR_ASSIGNED_FALSE (qdpll->pcnf, lwlit));
       assert (!is_cube || QDPLL_LIT_NEG (lwlit)
-              || QDPLL_VAR_ASSIGNED_TRUE (lwvar));
+              || QDPLL_LIT_VAR_ASSIGNED_TRUE (qdpll->pcnf, lwlit));
 
       if ((newlwpos =
            find_watcher_pos (qdpll, is_cube, vars, clause,
@@ -4081,14 +4073,14 @@ update_literal_watchers (QDPLL * qdpll, Var * propagated_var,
     {
       /* Right watcher assigned. Here, both unit literals and conflicts can occur. */
       assert (is_cube || QDPLL_LIT_POS (rwlit)
-              || QDPLL_VAR_ASSIGNED_TRUE (rwvar));
+              || QDPLL_LIT_VAR_ASSIGNED_TRUE (qdpll->pcnf, rwlit));
       assert (is_cube || QDPLL_LIT_NEG (rwlit)
-              || QDPLL_VAR_ASSIGNED_FALSE (rwvar));
+              || QDPLL_LIT_VAR_ASSIGNED_FALSE (qdpll->pcnf, rwlit));
       assert (!is_cube || QDPLL_LIT_POS (rwlit)
-              || QDPLL_VAR_ASSIGNED_FALSE (rwvar));
+              || QDPLL_LIT_VAR_ASSIGNED_FALSE (qdpll->pcnf, rwlit));
       assert (!is_cube || QDPLL_LIT_NEG (rwlit)
-              || QDPLL_VAR_ASSIGNED_TRUE (rwvar));
-      assert (QDPLL_VAR_ASSIGNED (lwvar) || rwvar == propagated_var);
+              || QDPLL_LIT_VAR_ASSIGNED_TRUE (qdpll->pcnf, rwlit));
+      assert (QDPLL_LIT_VAR_ASSIGNED (qdpll->pcnf, lwlit) || rwvar == propagated_var);
 
       if ((newrwpos =
            find_watcher_pos (qdpll, is_cube, vars, clause,
@@ -4231,10 +4223,10 @@ init_literal_watcher (QDPLL * qdpll, Constraint * c, unsigned int left_offset,
     }
   assert (count_in_notify_literal_watcher_list (notify_list, c) == 0);
   /* For initialization, simply use watched literal as blocking literal. */
-  BLitsOcc occ = { lit, is_cube ? BLIT_MARK_PTR (c) : c };
+  BLitsOcc occ = { lit, c->ref };
   /* Store clauses's position in notify-list. */
   c->offset_in_notify_list[1] = QDPLL_COUNT_STACK (*notify_list);
-  QDPLL_PUSH_STACK (mm, *notify_list, occ);
+  QDPLL_PUSH_STACK_UNINIT (mm, *notify_list, occ);
   assert (count_in_notify_literal_watcher_list (notify_list, c) == 1);
 
   /* Set left watcher. */
@@ -4268,11 +4260,11 @@ init_literal_watcher (QDPLL * qdpll, Constraint * c, unsigned int left_offset,
   assert (num_lits == 1
           || count_in_notify_literal_watcher_list (notify_list, c) == 0);
   occ.blit = lit;
-  assert (!is_cube || occ.constraint == BLIT_MARK_PTR (c));
-  assert (is_cube || occ.constraint == c);
+  assert (!BLIT_MARKED_REF (occ.cref) == !is_cube);
+  assert (BLIT_CONSTRAINT (qdpll->pcnf, occ) == c);
   /* Store clauses's position in notify-list. */
   c->offset_in_notify_list[0] = QDPLL_COUNT_STACK (*notify_list);
-  QDPLL_PUSH_STACK (mm, *notify_list, occ);
+  QDPLL_PUSH_STACK_UNINIT (mm, *notify_list, occ);
   assert (num_lits == 1
           || count_in_notify_literal_watcher_list (notify_list, c) == 1);
 }
@@ -4310,7 +4302,7 @@ find_init_watcher_pos (QDPLL * qdpll, const int is_cube, Var * vars,
       assert (lit != 0);
       Var *var = LIT2VARPTR (vars, lit);
       assert (QDPLL_VAR_HAS_OCCS (var));
-      if (!QDPLL_VAR_ASSIGNED (var))
+      if (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, var))
         {
           /* Literal unassigned. */
           if (qtype == QDPLL_QTYPE_UNDEF || qtype == var->scope->type)
@@ -4339,15 +4331,15 @@ find_init_watcher_pos (QDPLL * qdpll, const int is_cube, Var * vars,
           /* Check if assigned literal satisfies clause / falsifies cube. */
           if (QDPLL_LIT_NEG (lit))
             {
-              if ((!is_cube && QDPLL_VAR_ASSIGNED_FALSE (var)) ||
-                  (is_cube && QDPLL_VAR_ASSIGNED_TRUE (var)))
+              if ((!is_cube && QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var)) ||
+                  (is_cube && QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var)))
                 return QDPLL_WATCHER_SAT;
             }
           else
             {
               assert (QDPLL_LIT_POS (lit));
-              if ((!is_cube && QDPLL_VAR_ASSIGNED_TRUE (var)) ||
-                  (is_cube && QDPLL_VAR_ASSIGNED_FALSE (var)))
+              if ((!is_cube && QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var)) ||
+                  (is_cube && QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var)))
                 return QDPLL_WATCHER_SAT;
             }
         }
@@ -4557,12 +4549,13 @@ delete_variable (QDPLL * qdpll, Var * var)
   QDPLL_DELETE_STACK (mm, var->neg_occ_cubes);
   QDPLL_DELETE_STACK (mm, var->pos_occ_cubes);
   QDPLL_DELETE_STACK (mm, var->type_red_member_lits);
-  QDPLL_DELETE_STACK (mm, var->qbcp_qbce_watched_neg_occ_clauses);
-  QDPLL_DELETE_STACK (mm, var->qbcp_qbce_watched_pos_occ_clauses);
-  QDPLL_DELETE_STACK (mm, var->qbcp_qbce_offset_of_neg_lit_in_watched_occ);
-  QDPLL_DELETE_STACK (mm, var->qbcp_qbce_offset_of_pos_lit_in_watched_occ);
-  QDPLL_DELETE_STACK (mm, var->qbcp_qbce_prepro_pos_blocking_lit_clauses);
-  QDPLL_DELETE_STACK (mm, var->qbcp_qbce_prepro_neg_blocking_lit_clauses);
+  QDPLLMemMan *qbce_mm = QBCE_MM (qdpll);
+  QDPLL_DELETE_STACK (qbce_mm, var->qbcp_qbce_watched_neg_occ_clauses);
+  QDPLL_DELETE_STACK (qbce_mm, var->qbcp_qbce_watched_pos_occ_clauses);
+  QDPLL_DELETE_STACK (qbce_mm, var->qbcp_qbce_offset_of_neg_lit_in_watched_occ);
+  QDPLL_DELETE_STACK (qbce_mm, var->qbcp_qbce_offset_of_pos_lit_in_watched_occ);
+  QDPLL_DELETE_STACK (qbce_mm, var->qbcp_qbce_prepro_pos_blocking_lit_clauses);
+  QDPLL_DELETE_STACK (qbce_mm, var->qbcp_qbce_prepro_neg_blocking_lit_clauses);
 
   QDPLLDepManGeneric *dm = qdpll->dm;
   assert (dm);
@@ -4570,16 +4563,55 @@ delete_variable (QDPLL * qdpll, Var * var)
 }
 
 
+/* Clear the state of 'var' which is kept in the arrays of 'pcnf'. */
+static void
+clear_var_hot_state (QDPLL * qdpll, Var * var)
+{
+  QDPLL_VAR_VALUE (qdpll->pcnf, var) = QDPLL_ASSIGNMENT_UNDEF;
+  QDPLL_VAR_LEVEL (qdpll->pcnf, var) = 0;
+  QDPLL_VAR_TRAIL_POS (qdpll->pcnf, var) = 0;
+}
+
+
 static void
 reset_variable (QDPLL * qdpll, Var * var)
 {
   delete_variable (qdpll, var);
   assert (qdpll->pcnf.used_vars != 0);
   qdpll->pcnf.used_vars--;
+  clear_var_hot_state (qdpll, var);
   memset (var, 0, sizeof (Var));
 }
 
 
+/* Enlarge the variable table and the parallel arrays of hot variable
+   state to 'new_size_vars' entries. New entries are zeroed. */
+static void
+enlarge_vars (QDPLL * qdpll, VarID new_size_vars)
+{
+  QDPLLMemMan *mm = qdpll->mm;
+  QDPLLPCNF *pcnf = &(qdpll->pcnf);
+  const VarID cur_size_vars = pcnf->size_vars;
+  assert (cur_size_vars <= new_size_vars);
+  pcnf->vars = (Var *) qdpll_realloc (mm, pcnf->vars,
+                                      cur_size_vars * sizeof (Var),
+                                      new_size_vars * sizeof (Var));
+  pcnf->var_values =
+    (signed char *) qdpll_realloc (mm, pcnf->var_values,
+                                   cur_size_vars * sizeof (signed char),
+                                   new_size_vars * sizeof (signed char));
+  pcnf->var_levels =
+    (unsigned int *) qdpll_realloc (mm, pcnf->var_levels,
+                                    cur_size_vars * sizeof (unsigned int),
+                                    new_size_vars * sizeof (unsigned int));
+  pcnf->var_trail_pos =
+    (unsigned int *) qdpll_realloc (mm, pcnf->var_trail_pos,
+                                    cur_size_vars * sizeof (unsigned int),
+                                    new_size_vars * sizeof (unsigned int));
+  pcnf->size_vars = new_size_vars;
+}
+
+
 static VarID
 find_max_declared_user_var_id (QDPLL *qdpll, Var *start)
 {
@@ -4654,7 +4686,7 @@ cleanup_no_occ_variables (QDPLL * qdpll, const int cleanup_user_prefix)
              'v->is_cur_used_internal_var'. */
           if (v->id && !QDPLL_VAR_HAS_OCCS (v) && !v->is_cur_used_internal_var)
             {
-              assert (!QDPLL_VAR_ASSIGNED(v));
+              assert (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, v));
               /* Bug fix: in incremental mode, user variables might lose all
                  their occs if clauses are popped off. */
               if (v->priority_pos != QDPLL_INVALID_PQUEUE_POS)
@@ -4866,10 +4898,10 @@ declare_and_init_variable (QDPLL * qdpll, Scope * scope,
   var->priority_pos = QDPLL_INVALID_PQUEUE_POS;
   assert (!var->priority);
   var->priority = 1;
-  assert (!var->decision_level);
-  var->decision_level = QDPLL_INVALID_DECISION_LEVEL;
-  assert (!var->trail_pos);
-  var->trail_pos = QDPLL_INVALID_TRAIL_POS;
+  assert (!QDPLL_VAR_LEVEL (qdpll->pcnf, var));
+  QDPLL_VAR_LEVEL (qdpll->pcnf, var) = QDPLL_INVALID_DECISION_LEVEL;
+  assert (!QDPLL_VAR_TRAIL_POS (qdpll->pcnf, var));
+  QDPLL_VAR_TRAIL_POS (qdpll->pcnf, var) = QDPLL_INVALID_TRAIL_POS;
   var->is_internal = is_var_internal;
 
   /* Set internal or user-scope for internal/user variables. Internal
@@ -5341,21 +5373,21 @@ cleanup_constraint (QDPLL * qdpll, Constraint * constr)
           /* Constr was reduced; add and trace explicit reduction step. */
           assert (constr->id == (qdpll->cur_constraint_id));
           /* Trace constr before reduction. */
-          qdpll->trace_constraint (constr->id,
+          qdpll->trace_constraint (qdpll, constr->id,
                                    constr->lits, num_lits_before_red, 0, 0);
           unsigned int old_constr_id = constr->id;
           constr->id = ++qdpll->cur_constraint_id;
           assert (constr->id == old_constr_id + 1);
           assert (qdpll->cur_constraint_id == constr->id);
           /* Trace reduction step, using new ID of reduced constr. */
-          qdpll->trace_constraint (constr->id,
+          qdpll->trace_constraint (qdpll, constr->id,
                                    constr->lits, constr->num_lits, old_constr_id, 0);
         }
       else
         {
           /* Constr unchanged, trace original constr as is. */
           assert (constr->num_lits == num_lits_before_red);
-          qdpll->trace_constraint (constr->id, constr->lits, constr->num_lits, 0, 0);
+          qdpll->trace_constraint (qdpll, constr->id, constr->lits, constr->num_lits, 0, 0);
         }
     }
 
@@ -5364,6 +5396,22 @@ cleanup_constraint (QDPLL * qdpll, Constraint * constr)
 
 static void increase_var_activity (QDPLL * qdpll, Var * var, Scope *s);
 
+/* Get the QBCE state of clause 'c', which is allocated on first use. QBCE
+   only considers original clauses, hence learned constraints and original
+   clauses solved without QBCE never get such a state. */
+static QBCEConstraintState *
+qbcp_qbce_get_state (QDPLL *qdpll, Constraint *c)
+{
+  if (!c->qbce)
+    {
+      assert (!c->is_cube);
+      c->qbce = 
+        (QBCEConstraintState *) qdpll_malloc (QBCE_MM (qdpll), sizeof (QBCEConstraintState));
+    }
+  return c->qbce;
+}
+
+
 static void
 qbcp_qbce_setup_first_call_aux (QDPLL *qdpll, Constraint *c)
 {
@@ -5374,7 +5422,7 @@ qbcp_qbce_setup_first_call_aux (QDPLL *qdpll, Constraint *c)
      initialization. Hence no clause must be blocked or satisfied already. */
   assert (!c->qbcp_qbce_blocked);
   assert (!is_clause_satisfied (qdpll, c));
-  assert (QDPLL_EMPTY_STACK (c->qbcp_qbce_notify_maybe_blocked_clauses));
+  assert (!c->qbce || QDPLL_EMPTY_STACK (c->qbce->qbcp_qbce_notify_maybe_blocked_clauses));
 
   if (qdpll->options.qbcp_qbce_max_clause_size && 
       c->num_lits > qdpll->options.qbcp_qbce_max_clause_size)
@@ -5394,10 +5442,10 @@ qbcp_qbce_setup_first_call_aux (QDPLL *qdpll, Constraint *c)
   /* Set member 'non_blocking_literal' in 'pair' to 0 to indicate that we
      want to check every existential literal in 'c' if it is a blocking
      literal. */
-  QBCENonBlockedWitness pair = {0, {c->num_lits > 0 ? c->lits[0] : 0, c}, 
+  QBCENonBlockedWitness pair = {0, {c->num_lits > 0 ? c->lits[0] : 0, c->ref}, 
                                 {QDPLL_INVALID_WATCHER_POS}, 
                                 QDPLL_COUNT_STACK (qdpll->qbcp_qbce_maybe_blocked_clauses)};
-  QDPLL_PUSH_STACK(qdpll->mm, qdpll->qbcp_qbce_maybe_blocked_clauses, pair);
+  QDPLL_PUSH_STACK(QBCE_MM (qdpll), qdpll->qbcp_qbce_maybe_blocked_clauses, pair);
 }
 
 /* Push constraint given through API on constraint stack, update occ_lists if
@@ -5416,13 +5464,14 @@ import_original_constraint (QDPLL * qdpll, Constraint * constr)
     QDPLL_COUNT_STACK (qdpll->qbcp_qbce_blocked_clauses.start[0]);
   QDPLLMemMan *mm = qdpll->mm;
   Var *vars = qdpll->pcnf.vars;
+  qdpll->state.qbce_closed = 0;
   if (!constr->is_cube)
     {
       LINK_LAST (qdpll->pcnf.clauses, constr, link);
       if (qdpll->options.empty_formula_watching)
         {
           /* Store pair of clause and one of its literals for better cache performance. */
-          BLitsOcc occ = {constr->num_lits > 0 ? constr->lits[0] : 0, constr};
+          BLitsOcc occ = {constr->num_lits > 0 ? constr->lits[0] : 0, constr->ref};
           QDPLL_PUSH_STACK (mm, qdpll->empty_formula_watching_blit_occs, occ);
           assert (qdpll->pcnf.clauses.cnt == 
                   (unsigned int) QDPLL_COUNT_STACK (qdpll->empty_formula_watching_blit_occs));
@@ -5457,7 +5506,7 @@ import_original_constraint (QDPLL * qdpll, Constraint * constr)
               if (!var->neg_lit_in_new_input_clause && 
                   !var->pos_lit_in_new_input_clause)
                 QDPLL_PUSH_STACK 
-                  (qdpll->mm, qdpll->qbcp_qbce_relevant_vars_in_new_input_clauses, var->id);
+                  (QBCE_MM (qdpll), qdpll->qbcp_qbce_relevant_vars_in_new_input_clauses, var->id);
               if (QDPLL_LIT_NEG (lit))
                 var->neg_lit_in_new_input_clause = 1;
               else            
@@ -5481,7 +5530,7 @@ import_original_constraint (QDPLL * qdpll, Constraint * constr)
         }
       /* FIX: Increase variable priority. */
       increase_var_activity (qdpll, var, var->user_scope ? var->user_scope : var->scope);
-      BLitsOcc blit = {lit, constr};
+      BLitsOcc blit = {lit, constr->ref};
       /* Add all literals to occurrence stacks. */
       if (QDPLL_LIT_NEG (lit))
         QDPLL_PUSH_STACK (mm, var->neg_occ_clauses, blit);
@@ -5491,18 +5540,93 @@ import_original_constraint (QDPLL * qdpll, Constraint * constr)
 }
 
 
-static Constraint *
-create_constraint (QDPLL * qdpll, unsigned int num_lits, int is_cube)
+/* Size of the memory block of a constraint with 'size_lits' literals. */
+#define CONSTRAINT_BYTES(size_lits) \
+  (sizeof (Constraint) + (size_lits) * sizeof (LitID))
+
+/* Blocks in the learnt-constraint arena are aligned like slab blocks. */
+#define LEARNT_ARENA_ALIGN(bytes) \
+  (((bytes) + QDPLL_SLAB_GRANULE - 1) & ~((size_t) QDPLL_SLAB_GRANULE - 1))
+
+/* Memory category of learned clauses or cubes. */
+#define LEARNT_MEM_CATEGORY(is_cube) \
+  ((is_cube) ? QDPLL_MEM_LEARNT_CUBES : QDPLL_MEM_LEARNT_CLAUSES)
+
+
+/* Set the reference of 'c' from its offset in the region. */
+static void
+register_constraint_ref (QDPLL * qdpll, Constraint * c)
+{
+  size_t offset = (char *) c - qdpll->pcnf.constraint_base;
+  assert (offset > 0 && offset % QDPLL_SLAB_GRANULE == 0);
+  assert (offset / QDPLL_SLAB_GRANULE <= (UINT_MAX >> 1));
+  c->ref = BLIT_REF_OF_OFFSET (offset, c->is_cube);
+  assert (BLIT_REF2CONSTRAINT (qdpll->pcnf, c->ref) == c);
+}
+
+
+/* Deleted constraints in arenas are recognized by invalid references,
+   see 'compact_learnt_constraints'. */
+static void
+unregister_constraint_ref (QDPLL * qdpll, Constraint * c)
+{
+  assert (BLIT_REF2CONSTRAINT (qdpll->pcnf, c->ref) == c);
+  c->ref = QDPLL_INVALID_CONSTRAINT_REF;
+}
+
+
+static void
+init_constraint (QDPLL * qdpll, Constraint * result, unsigned int num_lits,
+                 int is_cube, QDPLLMemCategory category)
 {
-  QDPLLMemMan *mm = qdpll->mm;
-  Constraint *result = qdpll_malloc (mm,
-                                     sizeof (Constraint) +
-                                     num_lits * sizeof (LitID));
   result->id = ++(qdpll->cur_constraint_id);
+  result->mem_category = category;
   result->size_lits = num_lits;
   result->is_cube = is_cube;
   result->num_lits = num_lits;
   result->rwatcher_pos = result->lwatcher_pos = QDPLL_INVALID_WATCHER_POS;
+  register_constraint_ref (qdpll, result);
+}
+
+
+/* Create a constraint accounted to memory category 'category', which is
+   'QDPLL_MEM_PCNF' for original clauses and the learned category for
+   all derived constraints, even if these are not added to the learned
+   constraints eventually. */
+static Constraint *
+create_constraint (QDPLL * qdpll, unsigned int num_lits, int is_cube,
+                   QDPLLMemCategory category)
+{
+  QDPLLMemMan *mm = qdpll_mem_view (qdpll->mm, category);
+  /* Constraints are taken from the slab allocator, where the size class is
+     determined by 'num_lits'. Learned constraints are created and deleted
+     at high rates, which we do not want to pass on to 'malloc'. */
+  Constraint *result = qdpll_slab_malloc (mm, CONSTRAINT_BYTES (num_lits));
+  init_constraint (qdpll, result, num_lits, is_cube, category);
+  return result;
+}
+
+
+/* Create a learned constraint at the end of the arena of learned clauses
+   or cubes, such that learned constraints are stored in the order in which
+   they are learned. If the arena is full, the constraint is taken from the
+   slab allocator. */
+static Constraint *
+create_learnt_constraint (QDPLL * qdpll, unsigned int num_lits, int is_cube)
+{
+  QDPLLMemMan *mm = qdpll_mem_view (qdpll->mm, LEARNT_MEM_CATEGORY (is_cube));
+  Constraint *result = (Constraint *)
+    qdpll_arena_malloc (mm, is_cube,
+                        LEARNT_ARENA_ALIGN (CONSTRAINT_BYTES (num_lits)));
+  if (!result)
+    return create_constraint (qdpll, num_lits, is_cube,
+                              LEARNT_MEM_CATEGORY (is_cube));
+  /* Arena memory is not initialized. Literals are written by the caller,
+     hence only the header must be cleared. */
+  memset (result, 0, sizeof (Constraint));
+  init_constraint (qdpll, result, num_lits, is_cube,
+                   LEARNT_MEM_CATEGORY (is_cube));
+  result->in_learnt_arena = 1;
   return result;
 }
 
@@ -5511,11 +5635,21 @@ static void
 delete_constraint (QDPLL * qdpll, Constraint * constraint)
 {
   QDPLLMemMan *mm = qdpll->mm;
-  QDPLL_DELETE_STACK (mm, constraint->qbcp_qbce_notify_maybe_blocked_clauses);
-  QDPLL_DELETE_STACK (mm, constraint->qbcp_qbce_witness_clauses);
-  QDPLL_DELETE_STACK (mm, constraint->qbcp_qbce_offset_of_witness_in_watched_occs);
-  qdpll_free (mm, constraint,
-              sizeof (Constraint) + constraint->size_lits * sizeof (LitID));
+  QBCEConstraintState *qbce = constraint->qbce;
+  if (qbce)
+    {
+      QDPLLMemMan *qbce_mm = QBCE_MM (qdpll);
+      QDPLL_DELETE_STACK (qbce_mm, qbce->qbcp_qbce_notify_maybe_blocked_clauses);
+      QDPLL_DELETE_STACK (qbce_mm, qbce->qbcp_qbce_witness_clauses);
+      QDPLL_DELETE_STACK (qbce_mm, qbce->qbcp_qbce_offset_of_witness_in_watched_occs);
+      qdpll_free (qbce_mm, qbce, sizeof (QBCEConstraintState));
+    }
+  unregister_constraint_ref (qdpll, constraint);
+  /* Memory of constraints in the arena is reclaimed by the next
+     compaction, which still needs 'size_lits' to skip the constraint. */
+  if (!constraint->in_learnt_arena)
+    qdpll_slab_free (qdpll_mem_view (mm, constraint->mem_category), constraint,
+                     CONSTRAINT_BYTES (constraint->size_lits));
 }
 
 
@@ -5560,7 +5694,7 @@ import_added_ids (QDPLL * qdpll)
         }
 
       if (qdpll->options.trace)
-        qdpll->trace_scope (scope);
+        qdpll->trace_scope (qdpll, scope);
 
       qdpll->state.scope_opened = 0;
       qdpll->state.scope_opened_ptr = 0;
@@ -5572,7 +5706,7 @@ import_added_ids (QDPLL * qdpll)
       /* For incremental solving: add space to add selector variable. */
       if (qdpll->state.cur_open_group_id > 0)
         num_lits++;
-      Constraint *constr = create_constraint (qdpll, num_lits, 0);
+      Constraint *constr = create_constraint (qdpll, num_lits, 0, QDPLL_MEM_PCNF);
       LitID *p = constr->lits;
 
       /* For incremental solving: add literal of selector variable. */
@@ -5647,7 +5781,7 @@ static int
 has_variable_active_occs_in_cubes (QDPLL * qdpll, Var * var,
                                    BLitsOccStack * occ_cubes)
 {
-  if (QDPLL_VAR_ASSIGNED (var) /* && QDPLL_VAR_MARKED_PROPAGATED (var) */ )
+  if (QDPLL_VAR_ASSIGNED (qdpll->pcnf, var) /* && QDPLL_VAR_MARKED_PROPAGATED (var) */ )
     return 0;
 
   LitID lit = occ_cubes == &(var->neg_occ_cubes) ? -var->id : var->id;
@@ -5655,8 +5789,8 @@ has_variable_active_occs_in_cubes (QDPLL * qdpll, Var * var,
   BLitsOcc *bp, *be;
   for (bp = occ_cubes->start, be = occ_cubes->top; bp < be; bp++)
     {
-      assert (!is_cube_satisfied (qdpll, BLIT_STRIP_PTR (bp->constraint)));
-      if (!is_cube_empty (qdpll, BLIT_STRIP_PTR (bp->constraint)))
+      assert (!is_cube_satisfied (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, *bp)));
+      if (!is_cube_empty (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, *bp)))
         return 1;
     }
 
@@ -5722,7 +5856,7 @@ qbcp_qbce_init_stack_of_stacks_of_next_dec_level (QDPLL *qdpll,
       cstack = *(stack->top);
     }
   assert (QDPLL_EMPTY_STACK (cstack));
-  QDPLL_PUSH_STACK (qdpll->mm, *stack, cstack);
+  QDPLL_PUSH_STACK (QBCE_MM (qdpll), *stack, cstack);
 }
 
 static void
@@ -5733,11 +5867,11 @@ push_assigned_variable (QDPLL * qdpll, Var * var, QDPLLAssignment assignment,
   assert (mode > 0 && mode <= 5);
   assert (mode != QDPLL_VARMODE_UNDEF);
   assert (assignment != QDPLL_ASSIGNMENT_UNDEF);
-  assert (var->assignment == QDPLL_ASSIGNMENT_UNDEF);
+  assert (QDPLL_VAR_VALUE (qdpll->pcnf, var) == QDPLL_ASSIGNMENT_UNDEF);
   assert (var->mode == QDPLL_VARMODE_UNDEF);
-  assert (!QDPLL_VAR_ASSIGNED (var));
+  assert (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, var));
   assert (!QDPLL_VAR_MARKED_PROPAGATED (var));
-  assert (var->decision_level == QDPLL_INVALID_DECISION_LEVEL);
+  assert (QDPLL_VAR_LEVEL (qdpll->pcnf, var) == QDPLL_INVALID_DECISION_LEVEL);
 
   /* An internal variable must only be assigned by assumptions. */
   assert (!var->is_internal || mode == QDPLL_VARMODE_ASSUMED);
@@ -5773,14 +5907,14 @@ push_assigned_variable (QDPLL * qdpll, Var * var, QDPLLAssignment assignment,
     var->cached_assignment = assignment;
 
   var->mode = mode;
-  var->assignment = assignment;
+  QDPLL_VAR_VALUE (qdpll->pcnf, var) = assignment;
 
   if (qdpll->options.empty_formula_watching)
     {
       /* If the current assignment satisfies the clause being watched for empty
          formula detection, then schedule a watcher update. */
-      if ((var->empty_formula_watcher_pos_occ && QDPLL_VAR_ASSIGNED_TRUE (var)) || 
-          (var->empty_formula_watcher_neg_occ && QDPLL_VAR_ASSIGNED_FALSE (var)))
+      if ((var->empty_formula_watcher_pos_occ && QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var)) || 
+          (var->empty_formula_watcher_neg_occ && QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var)))
         qdpll->state.empty_formula_watcher_scheduled_update = 1;
     }
 
@@ -5798,7 +5932,7 @@ push_assigned_variable (QDPLL * qdpll, Var * var, QDPLLAssignment assignment,
     {
       assert (mode == QDPLL_VARMODE_UNIT || mode == QDPLL_VARMODE_PURE || 
               mode == QDPLL_VARMODE_ASSUMED);
-      var->decision_level = qdpll->state.decision_level;
+      QDPLL_VAR_LEVEL (qdpll->pcnf, var) = qdpll->state.decision_level;
     }
   else
     {
@@ -5811,7 +5945,7 @@ push_assigned_variable (QDPLL * qdpll, Var * var, QDPLLAssignment assignment,
           assert (!qdpll->options.empty_formula_watching || 
                   qdpll->empty_formula_watcher);
           assert (!qdpll->options.empty_formula_watching || 
-                  !qdpll->empty_formula_watcher->constraint->qbcp_qbce_blocked);
+                  !BLIT_CONSTRAINT (qdpll->pcnf, *(qdpll->empty_formula_watcher))->qbcp_qbce_blocked);
           /* Initialize stack of blocked clauses found at next decision level. */
           assert (QDPLL_COUNT_STACK (qdpll->qbcp_qbce_blocked_clauses) == 
                   qdpll->state.decision_level + 2);
@@ -5827,16 +5961,16 @@ push_assigned_variable (QDPLL * qdpll, Var * var, QDPLLAssignment assignment,
       if (qdpll->options.empty_formula_watching)
         {
           assert (qdpll->empty_formula_watcher);
-          assert (!qdpll->empty_formula_watcher->constraint->qbcp_qbce_blocked);
+          assert (!BLIT_CONSTRAINT (qdpll->pcnf, *(qdpll->empty_formula_watcher))->qbcp_qbce_blocked);
           assert (QDPLL_COUNT_STACK 
                   (qdpll->empty_formula_watchers_per_dec_level) == 
                   qdpll->state.decision_level);
-          QDPLL_PUSH_STACK (qdpll->mm, qdpll->empty_formula_watchers_per_dec_level, 
-                            qdpll->empty_formula_watcher);
+          QDPLL_PUSH_STACK_UNINIT (qdpll->mm, qdpll->empty_formula_watchers_per_dec_level, 
+                                   qdpll->empty_formula_watcher);
         }
 
-      var->decision_level = ++qdpll->state.decision_level;
-      QDPLL_PUSH_STACK (qdpll->mm, qdpll->dec_vars, var->id);
+      QDPLL_VAR_LEVEL (qdpll->pcnf, var) = ++qdpll->state.decision_level;
+      QDPLL_PUSH_STACK_UNINIT (TRAIL_MM (qdpll), qdpll->dec_vars, var->id);
       assert (qdpll->dec_vars.start[qdpll->state.decision_level - 1] ==
               var->id);
     }
@@ -5860,7 +5994,7 @@ push_assigned_variable (QDPLL * qdpll, Var * var, QDPLLAssignment assignment,
       fprintf (stderr,
                "push assigned var.: id=%d, type=%c(%d), dlevel=%d, val=%d, mode=%d\n",
                var->id, QDPLL_SCOPE_EXISTS (var->scope) ? 'E' : 'A',
-               var->scope->nesting, var->decision_level, var->assignment,
+               var->scope->nesting, QDPLL_VAR_LEVEL (qdpll->pcnf, var), QDPLL_VAR_VALUE (qdpll->pcnf, var),
                var->mode);
     }
 #ifndef NDEBUG
@@ -5880,7 +6014,7 @@ has_variable_active_occs_in_clauses (QDPLL * qdpll, Var * var,
                                      const int check_prop)
 {
   assert (!check_prop);
-  if (QDPLL_VAR_ASSIGNED (var))
+  if (QDPLL_VAR_ASSIGNED (qdpll->pcnf, var))
     return 0;
 
   LitID lit = occ_clauses == &(var->neg_occ_clauses) ? -var->id : var->id;
@@ -5888,19 +6022,18 @@ has_variable_active_occs_in_clauses (QDPLL * qdpll, Var * var,
   BLitsOcc *bp, *be;
   for (bp = occ_clauses->start, be = occ_clauses->top; bp < be; bp++)
     {
-      if (BLIT_STRIP_PTR (bp->constraint)->qbcp_qbce_blocked)
+      if (BLIT_CONSTRAINT (qdpll->pcnf, *bp)->qbcp_qbce_blocked)
         continue;
-      assert (!BLIT_STRIP_PTR (bp->constraint)->is_cube);
+      assert (!BLIT_CONSTRAINT (qdpll->pcnf, *bp)->is_cube);
       /* Assertion need NOT hold when bcp is NOT saturated. */
       assert (qdpll->bcp_ptr != qdpll->assigned_vars_top
-              || !is_clause_empty (qdpll, BLIT_STRIP_PTR (bp->constraint)));
+              || !is_clause_empty (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, *bp)));
 
       if ((!check_prop
-           && !is_clause_satisfied (qdpll, BLIT_STRIP_PTR (bp->constraint)))
+           && !is_clause_satisfied (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, *bp)))
           || (check_prop
               && !is_clause_satisfied_by_prop_var (qdpll,
-                                                   BLIT_STRIP_PTR (bp->
-                                                                   constraint))))
+                                                   BLIT_CONSTRAINT (qdpll->pcnf, *bp))))
         return 1;
     }
 
@@ -5943,7 +6076,7 @@ get_reason_asserting_level (QDPLL * qdpll, LitID * lit_start, LitID * lit_end,
     {
       LitID lit = *p;
       Var *var = LIT2VARPTR (vars, lit);
-      level = var->decision_level;
+      level = QDPLL_VAR_LEVEL (qdpll->pcnf, var);
 
       if (type != var->scope->type
           && !dm->depends (dm, var->id, implied_var->id))
@@ -6085,7 +6218,7 @@ update_stop_crit_data (QDPLL * qdpll, Var * vars, LitID lit,
   const QDPLLQuantifierType var_type = var->scope->type;
   if (var_type == type)
     {
-      unsigned int cur_dl = var->decision_level;
+      unsigned int cur_dl = QDPLL_VAR_LEVEL (qdpll->pcnf, var);
       if (cur_dl > qdpll->hi_type_dl || !qdpll->hi_dl_type_var)
         {
           qdpll->hi_type_dl = cur_dl;
@@ -6095,7 +6228,7 @@ update_stop_crit_data (QDPLL * qdpll, Var * vars, LitID lit,
       else if (cur_dl == qdpll->hi_type_dl)
         {
           assert (qdpll->hi_dl_type_var);
-          assert (qdpll->hi_type_dl == qdpll->hi_dl_type_var->decision_level);
+          assert (qdpll->hi_type_dl == QDPLL_VAR_LEVEL (qdpll->pcnf, qdpll->hi_dl_type_var));
           qdpll->cnt_hi_dl_type_lits++;
         }
     }
@@ -6103,15 +6236,15 @@ update_stop_crit_data (QDPLL * qdpll, Var * vars, LitID lit,
     {
       /* Collect literals of other type which potentially violate
          stop-crit. in the end. */
-      if (!QDPLL_VAR_ASSIGNED (var)
-          || var->decision_level >= qdpll->hi_type_dl
+      if (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, var)
+          || QDPLL_VAR_LEVEL (qdpll->pcnf, var) >= qdpll->hi_type_dl
           ||
           ((type == QDPLL_QTYPE_FORALL
-            && ((QDPLL_VAR_ASSIGNED_FALSE (var) && QDPLL_LIT_NEG (lit))
-                || (QDPLL_VAR_ASSIGNED_TRUE (var) && QDPLL_LIT_POS (lit))))
+            && ((QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var) && QDPLL_LIT_NEG (lit))
+                || (QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var) && QDPLL_LIT_POS (lit))))
            || (type == QDPLL_QTYPE_EXISTS
-               && ((QDPLL_VAR_ASSIGNED_FALSE (var) && QDPLL_LIT_POS (lit))
-                   || (QDPLL_VAR_ASSIGNED_TRUE (var)
+               && ((QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var) && QDPLL_LIT_POS (lit))
+                   || (QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var)
                        && QDPLL_LIT_NEG (lit))))))
         QDPLL_PUSH_STACK (mm, qdpll->smaller_type_lits, lit);
     }
@@ -6123,8 +6256,8 @@ update_stop_crit_data (QDPLL * qdpll, Var * vars, LitID lit,
   if (!qdpll->options.depman_simple)
     {
       /* Update data for type-reduce. */
-      assert (qdpll->state.decision_level != 0 || var->decision_level == 0 ||
-              var->decision_level == QDPLL_INVALID_DECISION_LEVEL);
+      assert (qdpll->state.decision_level != 0 || QDPLL_VAR_LEVEL (qdpll->pcnf, var) == 0 ||
+              QDPLL_VAR_LEVEL (qdpll->pcnf, var) == QDPLL_INVALID_DECISION_LEVEL);
       assert (LEARN_VAR_MARKED (var));
       assert (QDPLL_LIT_POS (lit) || LEARN_VAR_NEG_MARKED (var));
       assert (QDPLL_LIT_NEG (lit) || LEARN_VAR_POS_MARKED (var));
@@ -6181,21 +6314,21 @@ cover_by_clauses_collect_lit (QDPLL * qdpll, QDPLLMemMan * mm,
           qdpll->pcnf.user_scopes.last != var->user_scope);
   assert (COLLECT_FULL_COVER_SETS || !qdpll->options.no_qbce_dynamic || 
           qdpll->pcnf.scopes.last != var->scope);
-  assert ((QDPLL_LIT_NEG (lit) && QDPLL_VAR_ASSIGNED_FALSE (var)) ||
-          (QDPLL_LIT_POS (lit) && QDPLL_VAR_ASSIGNED_TRUE (var)));
+  assert ((QDPLL_LIT_NEG (lit) && QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var)) ||
+          (QDPLL_LIT_POS (lit) && QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var)));
   assert (!LEARN_VAR_MARKED (var));
   if (QDPLL_LIT_POS (lit))
     LEARN_VAR_POS_MARK (var);
   else
     LEARN_VAR_NEG_MARK (var);
   if (var->is_internal)
-    QDPLL_PUSH_STACK (mm, qdpll->internal_cover_lits, lit);
+    QDPLL_PUSH_STACK_UNINIT (mm, qdpll->internal_cover_lits, lit);
   else if (var->user_scope)
-    QDPLL_PUSH_STACK (mm, var->user_scope->cover_lits, lit);
+    QDPLL_PUSH_STACK_UNINIT (mm, var->user_scope->cover_lits, lit);
   else
     {
       assert (var->scope && var->scope == qdpll->pcnf.scopes.first);
-      QDPLL_PUSH_STACK (mm, var->scope->cover_lits, lit);
+      QDPLL_PUSH_STACK_UNINIT (mm, var->scope->cover_lits, lit);
     }
 }
 
@@ -6210,12 +6343,12 @@ cover_by_clauses_collect_lits_sorted_aux (QDPLL * qdpll, QDPLLMemMan * mm,
       LitID lit = *p;
       Var *v = LIT2VARPTR (qdpll->pcnf.vars, lit);
       assert (LEARN_VAR_MARKED (v));
-      assert ((QDPLL_VAR_ASSIGNED_TRUE (v) && LEARN_VAR_POS_MARKED (v)) ||
-              (QDPLL_VAR_ASSIGNED_FALSE (v) && LEARN_VAR_NEG_MARKED (v)));
+      assert ((QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, v) && LEARN_VAR_POS_MARKED (v)) ||
+              (QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, v) && LEARN_VAR_NEG_MARKED (v)));
       assert (cover_lits == &qdpll->internal_cover_lits || !v->is_internal);
       assert (cover_lits != &qdpll->internal_cover_lits || v->is_internal);
       update_stop_crit_data (qdpll, qdpll->pcnf.vars, lit, QDPLL_QTYPE_FORALL);
-      QDPLL_PUSH_STACK (mm, *lit_stack, lit);
+      QDPLL_PUSH_STACK_UNINIT (mm, *lit_stack, lit);
     }
   QDPLL_RESET_STACK (*cover_lits);
 }
@@ -6318,8 +6451,8 @@ cover_by_assignment_is_univ_var_orig_occ_covered (QDPLL *qdpll,
       Var *var = LIT2VARPTR (qdpll->pcnf.vars, lit);
       /* Check if a collected variable satisfies 'c'. */
       if (var != univ_var && LEARN_VAR_MARKED (var) && 
-          ((QDPLL_LIT_NEG (lit) && QDPLL_VAR_ASSIGNED_FALSE (var)) || 
-           (QDPLL_LIT_POS (lit) && QDPLL_VAR_ASSIGNED_TRUE (var))))
+          ((QDPLL_LIT_NEG (lit) && QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var)) || 
+           (QDPLL_LIT_POS (lit) && QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var))))
         {
           if (qdpll->options.verbosity >= 2)
             fprintf (stderr, "  ...which is satisfied by collected literal\n");
@@ -6356,8 +6489,8 @@ cover_by_assignment_check_blocked_clauses_aux
       Var *var = LIT2VARPTR (qdpll->pcnf.vars, lit);
       /* Check if a collected variable satisfies 'c'. */
       if (var != univ_var && LEARN_VAR_MARKED (var) && 
-          ((QDPLL_LIT_NEG (lit) && QDPLL_VAR_ASSIGNED_FALSE (var)) || 
-           (QDPLL_LIT_POS (lit) && QDPLL_VAR_ASSIGNED_TRUE (var))))
+          ((QDPLL_LIT_NEG (lit) && QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var)) || 
+           (QDPLL_LIT_POS (lit) && QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var))))
         {
           if (qdpll->options.verbosity >= 2)
             fprintf (stderr, "  ...which is satisfied by a collected literal\n");
@@ -6375,7 +6508,7 @@ cover_by_assignment_check_blocked_clauses_aux
   LitID blocking_lit = blocked_clause->qbcp_qbce_blocking_lit;
   assert (blocking_lit);
   Var *blocking_var = LIT2VARPTR (qdpll->pcnf.vars, blocking_lit);
-  if (!QDPLL_VAR_ASSIGNED (blocking_var))
+  if (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, blocking_var))
     {
       if (qdpll->options.verbosity >= 2)
         fprintf (stderr, "  ...which is blocked with UNassigned blocking literal %d\n", blocking_lit);
@@ -6412,7 +6545,7 @@ cover_by_assignment_push_blocked_clauses_of_exists_var (QDPLL *qdpll,
       qdpll->stats.elim_univ_vars_clauses_seen++;
 #endif
       BLitsOcc occ = *op;
-      Constraint *c = occ.constraint;
+      Constraint *c = BLIT_CONSTRAINT (qdpll->pcnf, occ);
       if (qdpll->options.verbosity >= 2)
         {
           fprintf (stderr, "  cover-by-assignment: exists-var occurrence ");
@@ -6539,10 +6672,10 @@ cover_by_assignment_keep_univ_var (QDPLL *qdpll, Var *univ_var,
   if (qdpll->options.verbosity >= 2)
     fprintf (stderr, "cover-by-assignment: checking to eliminate variable %d\n", univ_var->id);
 
-  assert (QDPLL_VAR_ASSIGNED (univ_var));
+  assert (QDPLL_VAR_ASSIGNED (qdpll->pcnf, univ_var));
   assert (QDPLL_VAR_FORALL (univ_var));
   assert (univ_var->mode != QDPLL_VARMODE_PURE);
-  BLitsOccStack *orig_occs = QDPLL_VAR_ASSIGNED_FALSE (univ_var) ? 
+  BLitsOccStack *orig_occs = QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, univ_var) ? 
     &univ_var->neg_occ_clauses : &univ_var->pos_occ_clauses;
 
   if (qdpll->options.verbosity >= 2)
@@ -6559,7 +6692,7 @@ cover_by_assignment_keep_univ_var (QDPLL *qdpll, Var *univ_var,
       qdpll->stats.elim_univ_vars_clauses_seen++;
 #endif
       BLitsOcc occ = *op;
-      Constraint *c = occ.constraint;
+      Constraint *c = BLIT_CONSTRAINT (qdpll->pcnf, occ);
       if (!cover_by_assignment_is_univ_var_orig_occ_covered (qdpll, univ_var, c))
         result = 1;
       else
@@ -6607,8 +6740,8 @@ cover_by_assignment_collect_univ_vars_from_orig_occ (QDPLL *qdpll, Constraint *c
       LitID lit = *p;
       Var *var = LIT2VARPTR (qdpll->pcnf.vars, lit);
       /* Search for satisfying literals. */
-      if ((QDPLL_LIT_NEG (lit) && QDPLL_VAR_ASSIGNED_FALSE (var)) || 
-          (QDPLL_LIT_POS (lit) && QDPLL_VAR_ASSIGNED_TRUE (var)))
+      if ((QDPLL_LIT_NEG (lit) && QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var)) || 
+          (QDPLL_LIT_POS (lit) && QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var)))
         {
           if (LEARN_VAR_MARKED (var))
             {
@@ -6649,10 +6782,10 @@ cover_by_assignment_collect_univ_vars_from_orig_occ (QDPLL *qdpll, Constraint *c
       assert (min_sat_univ_var);
       if (qdpll->options.verbosity >= 2)
         fprintf (stderr, "cover-by-assignment: collecting univ %d\n", 
-                 QDPLL_VAR_ASSIGNED_FALSE (min_sat_univ_var) ? 
+                 QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, min_sat_univ_var) ? 
                  -min_sat_univ_var->id : min_sat_univ_var->id);
       cover_by_clauses_collect_lit (qdpll, qdpll->mm, min_sat_univ_var, 
-                                    QDPLL_VAR_ASSIGNED_FALSE (min_sat_univ_var) ? 
+                                    QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, min_sat_univ_var) ? 
                                     -min_sat_univ_var->id : min_sat_univ_var->id);
       qdpll->state.univ_vars_cur_collected++;
     }
@@ -6669,7 +6802,7 @@ cover_by_assignment_collect_univ_vars_init_blocked_clause (QDPLL *qdpll, Constra
 
   /* If the blocking literal of 'c' is unassigned then the clause is blocked
      under the current assignment and hence no actions are required. */
-  if (!QDPLL_VAR_ASSIGNED (blocking_var))
+  if (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, blocking_var))
     return 0;
 
   LitID *p, *e;
@@ -6680,8 +6813,8 @@ cover_by_assignment_collect_univ_vars_init_blocked_clause (QDPLL *qdpll, Constra
       /* Search for literals which have been collected and which satisfy the
          clause. */
       if (LEARN_VAR_MARKED (var) && 
-          ((QDPLL_LIT_NEG (lit) && QDPLL_VAR_ASSIGNED_FALSE (var)) || 
-           (QDPLL_LIT_POS (lit) && QDPLL_VAR_ASSIGNED_TRUE (var))))
+          ((QDPLL_LIT_NEG (lit) && QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var)) || 
+           (QDPLL_LIT_POS (lit) && QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var))))
         return 0;
     }
 
@@ -6701,8 +6834,8 @@ cover_by_assignment_collect_univ_vars (QDPLL *qdpll,
   for (vp = univ_vars_stack->start, ve = univ_vars_stack->top; vp < ve; vp++)
     {
       Var *var = *vp;
-      assert (QDPLL_VAR_ASSIGNED (var));
-      BLitsOccStack *occs = QDPLL_VAR_ASSIGNED_FALSE (var) ? 
+      assert (QDPLL_VAR_ASSIGNED (qdpll->pcnf, var));
+      BLitsOccStack *occs = QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var) ? 
         &var->neg_occ_clauses : &var->pos_occ_clauses;
       BLitsOcc *op, *oe;
       for (op = occs->start, oe = occs->top; op < oe; op++)
@@ -6711,7 +6844,7 @@ cover_by_assignment_collect_univ_vars (QDPLL *qdpll,
           qdpll->stats.elim_univ_vars_clauses_seen++;
 #endif
           BLitsOcc occ = *op;
-          Constraint *c = occ.constraint;
+          Constraint *c = BLIT_CONSTRAINT (qdpll->pcnf, occ);
           if (!c->qbcp_qbce_blocked && !c->qbcp_qbce_elim_univ_mark)
             {
               c->qbcp_qbce_elim_univ_mark = 1;
@@ -6799,7 +6932,7 @@ cover_by_assignment_collect_univ_vars (QDPLL *qdpll,
               qdpll->stats.elim_univ_vars_clauses_seen++;
 #endif
               BLitsOcc occ = *op;
-              Constraint *c = occ.constraint;
+              Constraint *c = BLIT_CONSTRAINT (qdpll->pcnf, occ);
               if (!c->qbcp_qbce_elim_univ_mark)
                 {
                   if (qdpll->options.verbosity >= 2)
@@ -6828,18 +6961,18 @@ cover_by_assignment_collect_univ_vars (QDPLL *qdpll,
             {
               LitID lit = *p;
               Var *var  = LIT2VARPTR (qdpll->pcnf.vars, lit);
-              if ((QDPLL_LIT_NEG (lit) && QDPLL_VAR_ASSIGNED_FALSE (var)) || 
-                   (QDPLL_LIT_POS (lit) && QDPLL_VAR_ASSIGNED_TRUE (var)))
+              if ((QDPLL_LIT_NEG (lit) && QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var)) || 
+                   (QDPLL_LIT_POS (lit) && QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var)))
                 {
                   if (QDPLL_VAR_FORALL (var) && !LEARN_VAR_MARKED (var) &&
                       var->mode != QDPLL_VARMODE_PURE)
                     {
                       if (qdpll->options.verbosity >= 2)
                         fprintf (stderr, "cover-by-assignment: collecting univ %d\n", 
-                                 QDPLL_VAR_ASSIGNED_FALSE (var) ? 
+                                 QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var) ? 
                                  -var->id : var->id);
                       cover_by_clauses_collect_lit (qdpll, qdpll->mm, var, 
-                                                    QDPLL_VAR_ASSIGNED_FALSE (var) ? 
+                                                    QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var) ? 
                                                     -var->id : var->id);
                       qdpll->state.univ_vars_cur_collected++;
                     }
@@ -6850,7 +6983,7 @@ cover_by_assignment_collect_univ_vars (QDPLL *qdpll,
                          pure, and that pure assignment in turn might have
                          produced further blocked clauses. Hence we might have to
                          collect that universal variable. */
-                      BLitsOccStack *occs = QDPLL_VAR_ASSIGNED_FALSE (var) ? 
+                      BLitsOccStack *occs = QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var) ? 
                         &var->pos_occ_clauses : &var->neg_occ_clauses;
                       BLitsOcc *op, *oe;
                       for (op = occs->start, oe = occs->top; op < oe; op++)
@@ -6859,7 +6992,7 @@ cover_by_assignment_collect_univ_vars (QDPLL *qdpll,
                           qdpll->stats.elim_univ_vars_clauses_seen++;
 #endif
                           BLitsOcc occ = *op;
-                          Constraint *c = occ.constraint;
+                          Constraint *c = BLIT_CONSTRAINT (qdpll->pcnf, occ);
                           if (!c->qbcp_qbce_elim_univ_mark)
                             {
                               if (qdpll->options.verbosity >= 2)
@@ -6955,7 +7088,7 @@ cover_by_assignment (QDPLL * qdpll, LitIDStack * lit_stack)
     {
       VarID vid = *p;
       Var *var = VARID2VARPTR (qdpll->pcnf.vars, vid);
-      assert (QDPLL_VAR_ASSIGNED (var));
+      assert (QDPLL_VAR_ASSIGNED (qdpll->pcnf, var));
       if ((!QBCP_QBCE_DYNAMIC_ASSIGNMENT_ELIM_UNIV_VARS || QDPLL_VAR_FORALL(var)) && 
           var->mode == QDPLL_VARMODE_PURE)
         continue;
@@ -6971,10 +7104,10 @@ cover_by_assignment (QDPLL * qdpll, LitIDStack * lit_stack)
 
       if (qdpll->options.verbosity >= 2)
         fprintf (stderr, "cover-by-assignment: collecting %d\n", 
-                 QDPLL_VAR_ASSIGNED_FALSE (var) ? -vid : vid);
+                 QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var) ? -vid : vid);
 
       cover_by_clauses_collect_lit (qdpll, mm, var, 
-                                    QDPLL_VAR_ASSIGNED_FALSE (var) ? -vid : vid);
+                                    QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var) ? -vid : vid);
     }
 
 #if QBCP_QBCE_DYNAMIC_ASSIGNMENT_ELIM_UNIV_VARS
@@ -6994,14 +7127,14 @@ cover_by_assignment (QDPLL * qdpll, LitIDStack * lit_stack)
       for (vp = univ_vars_stack.start, ve = univ_vars_stack.top; vp < ve; vp++)
         {
           Var *var = *vp;
-          assert (QDPLL_VAR_ASSIGNED (var));
+          assert (QDPLL_VAR_ASSIGNED (qdpll->pcnf, var));
           assert (QDPLL_VAR_FORALL (var));
           assert (var->mode != QDPLL_VARMODE_PURE);
           if (qdpll->options.verbosity >= 2)
             fprintf (stderr, "cover-by-assignment: collecting univ %d\n", 
-                     QDPLL_VAR_ASSIGNED_FALSE (var) ? -var->id : var->id);
+                     QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var) ? -var->id : var->id);
           cover_by_clauses_collect_lit (qdpll, mm, var, 
-                                        QDPLL_VAR_ASSIGNED_FALSE (var) ? -var->id : var->id);
+                                        QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var) ? -var->id : var->id);
           qdpll->state.univ_vars_cur_collected++;
         }
     }
@@ -7105,8 +7238,8 @@ cover_by_clauses (QDPLL * qdpll, LitIDStack * lit_stack,
               && lit_var->mode == QDPLL_VARMODE_PURE)
             continue;
           /* Search for positive literals. */
-          if ((QDPLL_LIT_NEG (lit) && QDPLL_VAR_ASSIGNED_FALSE (lit_var)) ||
-              (QDPLL_LIT_POS (lit) && QDPLL_VAR_ASSIGNED_TRUE (lit_var)))
+          if ((QDPLL_LIT_NEG (lit) && QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, lit_var)) ||
+              (QDPLL_LIT_POS (lit) && QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, lit_var)))
             {
               clause_cover_lits_cnt++;
               /* Skip clauses that are already covered by collected
@@ -7121,16 +7254,16 @@ cover_by_clauses (QDPLL * qdpll, LitIDStack * lit_stack,
                       if (qdpll->options.trace && !lit_var->mark_qrp)
                         {
                           lit_var->mark_qrp = 1;        /* prevent duplicates  */
-                          QDPLL_PUSH_STACK (mm, *lit_stack_tmp,
-                                            QDPLL_VAR_ASSIGNED_TRUE (lit_var)
-                                            ? lit_var->id : -lit_var->id);
+                          QDPLL_PUSH_STACK_UNINIT (mm, *lit_stack_tmp,
+                                                   QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, lit_var)
+                                                   ? lit_var->id : -lit_var->id);
                         }
 #if COMPUTE_STATS
                       /* BUG-FIX: must not count literal multiple times! */
                       if (!lit_var->mark_stats_type_reduce_lits)
                         {
                           lit_var->mark_stats_type_reduce_lits = 1;
-                          QDPLL_PUSH_STACK (mm, qdpll->wreason_a, lit_var);
+                          QDPLL_PUSH_STACK_UNINIT (mm, qdpll->wreason_a, lit_var);
                         }
 #endif
                     }
@@ -7237,7 +7370,8 @@ store_cover_set_aux (QDPLL *qdpll)
 static void
 store_cover_set (QDPLL *qdpll, LitIDStack *lit_stack)
 {
-  Constraint *cover_set = create_constraint (qdpll, QDPLL_COUNT_STACK(*lit_stack), 1);
+  Constraint *cover_set = create_constraint (qdpll, QDPLL_COUNT_STACK(*lit_stack), 1,
+                                             QDPLL_MEM_LEARNT_CUBES);
   cover_set->learnt = 1;
   assert (cover_set->is_cube);
   LitID *p, *e, *dest = cover_set->lits;
@@ -7300,7 +7434,7 @@ get_initial_reason (QDPLL * qdpll, LitIDStack ** lit_stack,
             LEARN_VAR_NEG_MARK (var);
           else
             LEARN_VAR_POS_MARK (var);
-          QDPLL_PUSH_STACK (mm, *stack, lit);
+          QDPLL_PUSH_STACK_UNINIT (mm, *stack, lit);
           update_stop_crit_data (qdpll, vars, lit, type);
         }
       /* Working reason is already sorted here. */
@@ -7349,7 +7483,7 @@ get_initial_reason (QDPLL * qdpll, LitIDStack ** lit_stack,
 
       if (qdpll->options.trace && nlits - (QDPLL_COUNT_STACK (**lit_stack)))
         {
-          qdpll->trace_constraint (++(qdpll->cur_constraint_id),
+          qdpll->trace_constraint (qdpll, ++(qdpll->cur_constraint_id),
                                    (*lit_stack)->start,
                                    QDPLL_COUNT_STACK (**lit_stack), cid, 0);
           qdpll->res_cons_id = qdpll->cur_constraint_id;
@@ -7371,7 +7505,7 @@ get_initial_reason (QDPLL * qdpll, LitIDStack ** lit_stack,
       if (qdpll->options.trace && QDPLL_COUNT_STACK (**lit_stack)
           && (nlits - QDPLL_COUNT_STACK (**lit_stack)))
         {
-          qdpll->trace_constraint (qdpll->cur_constraint_id + 1,
+          qdpll->trace_constraint (qdpll, qdpll->cur_constraint_id + 1,
                                    (*lit_stack)->start,
                                    QDPLL_COUNT_STACK (**lit_stack),
                                    qdpll->cur_constraint_id, 0);
@@ -7391,8 +7525,8 @@ static int
 is_var_at_type_dec_level_adv (QDPLL * qdpll, Var * var,
                               const QDPLLQuantifierType type)
 {
-  assert (var->decision_level != QDPLL_INVALID_DECISION_LEVEL);
-  assert (var->decision_level <= qdpll->state.decision_level);
+  assert (QDPLL_VAR_LEVEL (qdpll->pcnf, var) != QDPLL_INVALID_DECISION_LEVEL);
+  assert (QDPLL_VAR_LEVEL (qdpll->pcnf, var) <= qdpll->state.decision_level);
   assert ((unsigned int) QDPLL_COUNT_STACK (qdpll->dec_vars) ==
           qdpll->state.decision_level);
 
@@ -7400,13 +7534,13 @@ is_var_at_type_dec_level_adv (QDPLL * qdpll, Var * var,
      keep them in working reason. The following two lines make sure that we
      continue resolution if the working reason reason contains only literals
      from top-level. */
-  if (var->decision_level == 0)
+  if (QDPLL_VAR_LEVEL (qdpll->pcnf, var) == 0)
     return 0;
 
   Var *dec_var =
     VARID2VARPTR (qdpll->pcnf.vars,
-                  qdpll->dec_vars.start[var->decision_level - 1]);
-  assert (dec_var->decision_level == var->decision_level);
+                  qdpll->dec_vars.start[QDPLL_VAR_LEVEL (qdpll->pcnf, var) - 1]);
+  assert (QDPLL_VAR_LEVEL (qdpll->pcnf, dec_var) == QDPLL_VAR_LEVEL (qdpll->pcnf, var));
   assert (dec_var->mode == QDPLL_VARMODE_LBRANCH
           || dec_var->mode == QDPLL_VARMODE_RBRANCH);
   return dec_var->scope->type == type;
@@ -7438,7 +7572,7 @@ all_smaller_type_lits_have_value_adv (QDPLL * qdpll,    /*LitIDStack * lit_stack
   assert (type == QDPLL_QTYPE_FORALL || type == QDPLL_QTYPE_EXISTS);
   Var *hi_dl_var = qdpll->hi_dl_type_var;
   const VarID hi_dl_var_id = hi_dl_var->id;
-  const unsigned int hi_dl_var_dec_level = hi_dl_var->decision_level;
+  const unsigned int hi_dl_var_dec_level = QDPLL_VAR_LEVEL (qdpll->pcnf, hi_dl_var);
   assert (hi_dl_var->scope->type != type);
   assert (hi_dl_var_dec_level == qdpll->hi_type_dl);
   assert (qdpll->cnt_hi_dl_type_lits == 1);
@@ -7451,15 +7585,15 @@ all_smaller_type_lits_have_value_adv (QDPLL * qdpll,    /*LitIDStack * lit_stack
       LitID lit = *p;
       Var *var = LIT2VARPTR (vars, lit);
       assert (var->scope->type == type);
-      if ((!QDPLL_VAR_ASSIGNED (var)
-           || var->decision_level >= qdpll->hi_type_dl
+      if ((!QDPLL_VAR_ASSIGNED (qdpll->pcnf, var)
+           || QDPLL_VAR_LEVEL (qdpll->pcnf, var) >= qdpll->hi_type_dl
            ||
            ((type == QDPLL_QTYPE_FORALL
-             && ((QDPLL_VAR_ASSIGNED_FALSE (var) && QDPLL_LIT_NEG (lit))
-                 || (QDPLL_VAR_ASSIGNED_TRUE (var) && QDPLL_LIT_POS (lit))))
+             && ((QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var) && QDPLL_LIT_NEG (lit))
+                 || (QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var) && QDPLL_LIT_POS (lit))))
             || (type == QDPLL_QTYPE_EXISTS
-                && ((QDPLL_VAR_ASSIGNED_FALSE (var) && QDPLL_LIT_POS (lit))
-                    || (QDPLL_VAR_ASSIGNED_TRUE (var)
+                && ((QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var) && QDPLL_LIT_POS (lit))
+                    || (QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var)
                         && QDPLL_LIT_NEG (lit))))))
           && dm->depends (dm, var->id, hi_dl_var_id))
         return 0;
@@ -7487,7 +7621,7 @@ check_marks_and_push (QDPLL * qdpll, Var * var, LitID lit, LitIDStack * stack,
       if (!LEARN_VAR_MARKED (var))
         {
           LEARN_VAR_NEG_MARK (var);
-          QDPLL_PUSH_STACK (qdpll->mm, *stack, lit);
+          QDPLL_PUSH_STACK_UNINIT (qdpll->mm, *stack, lit);
           update_stop_crit_data (qdpll, qdpll->pcnf.vars, lit, type);
           if (!qdpll->options.bump_vars_once)
             increase_var_activity (qdpll, var, var->scope);
@@ -7501,7 +7635,7 @@ check_marks_and_push (QDPLL * qdpll, Var * var, LitID lit, LitIDStack * stack,
           if (!LEARN_VAR_NEG_MARKED (var))
             {
               LEARN_VAR_NEG_MARK (var);
-              QDPLL_PUSH_STACK (qdpll->mm, *stack, lit);
+              QDPLL_PUSH_STACK_UNINIT (qdpll->mm, *stack, lit);
               /* NOTE: we do not call update_stop_crit here since the literal
                  of the other phase has been collected already. */
               if (!qdpll->options.bump_vars_once)
@@ -7515,7 +7649,7 @@ check_marks_and_push (QDPLL * qdpll, Var * var, LitID lit, LitIDStack * stack,
       if (!LEARN_VAR_MARKED (var))
         {
           LEARN_VAR_POS_MARK (var);
-          QDPLL_PUSH_STACK (qdpll->mm, *stack, lit);
+          QDPLL_PUSH_STACK_UNINIT (qdpll->mm, *stack, lit);
           update_stop_crit_data (qdpll, qdpll->pcnf.vars, lit, type);
           if (!qdpll->options.bump_vars_once)
             increase_var_activity (qdpll, var, var->scope);
@@ -7529,7 +7663,7 @@ check_marks_and_push (QDPLL * qdpll, Var * var, LitID lit, LitIDStack * stack,
           if (!LEARN_VAR_POS_MARKED (var))
             {
               LEARN_VAR_POS_MARK (var);
-              QDPLL_PUSH_STACK (qdpll->mm, *stack, lit);
+              QDPLL_PUSH_STACK_UNINIT (qdpll->mm, *stack, lit);
               /* NOTE: we do not call update_stop_crit here since the literal
                  of the other phase has been collected already. */
               if (!qdpll->options.bump_vars_once)
@@ -7622,7 +7756,7 @@ resolve_and_reduce (QDPLL * qdpll, ConstraintID ant1_id,
           /* Must ignore pivot variable. */
           if (var1 != var)
             {
-              QDPLL_PUSH_STACK (mm, *tmp, lit1);
+              QDPLL_PUSH_STACK_UNINIT (mm, *tmp, lit1);
               update_stop_crit_data (qdpll, vars, lit1, type);
             }
           else
@@ -7666,7 +7800,7 @@ resolve_and_reduce (QDPLL * qdpll, ConstraintID ant1_id,
       /* Must ignore pivot variable. */
       if (var1 != var)
         {
-          QDPLL_PUSH_STACK (mm, *tmp, lit1);
+          QDPLL_PUSH_STACK_UNINIT (mm, *tmp, lit1);
           update_stop_crit_data (qdpll, vars, lit1, type);
         }
       else
@@ -7707,7 +7841,7 @@ resolve_and_reduce (QDPLL * qdpll, ConstraintID ant1_id,
   qdpll->dm->reduce_lits (qdpll->dm, lit_stack, lit_stack_tmp, type, 1);
 
   if (qdpll->options.trace)
-    qdpll->trace_constraint (res_id, (*lit_stack)->start,
+    qdpll->trace_constraint (qdpll, res_id, (*lit_stack)->start,
                              QDPLL_COUNT_STACK (**lit_stack), ant1_id,
                              var->antecedent->id);
 
@@ -7810,9 +7944,9 @@ choose_var (QDPLL * qdpll, LitIDStack * lit_stack,
       var = LIT2VARPTR (vars, lit);
       if (var->mode == QDPLL_VARMODE_UNIT && var->scope->type == type)
         {
-          assert (var->trail_pos != QDPLL_INVALID_TRAIL_POS);
-          assert (!pivot || pivot->trail_pos != QDPLL_INVALID_TRAIL_POS);
-          if (!pivot || pivot->trail_pos < var->trail_pos)
+          assert (QDPLL_VAR_TRAIL_POS (qdpll->pcnf, var) != QDPLL_INVALID_TRAIL_POS);
+          assert (!pivot || QDPLL_VAR_TRAIL_POS (qdpll->pcnf, pivot) != QDPLL_INVALID_TRAIL_POS);
+          if (!pivot || QDPLL_VAR_TRAIL_POS (qdpll->pcnf, pivot) < QDPLL_VAR_TRAIL_POS (qdpll->pcnf, var))
             pivot = var;
         }
     }
@@ -7831,7 +7965,7 @@ choose_var (QDPLL * qdpll, LitIDStack * lit_stack,
           var = LIT2VARPTR (vars, lit);
           if (var->mode == QDPLL_VARMODE_UNIT && var->scope->type == type)
             {
-              if (!pivot || pivot->trail_pos < var->trail_pos)
+              if (!pivot || QDPLL_VAR_TRAIL_POS (qdpll->pcnf, pivot) < QDPLL_VAR_TRAIL_POS (qdpll->pcnf, var))
                 if (qdpll->dm->depends (qdpll->dm, blocking->id, var->id) &&
                     !peek_tautology (qdpll, lit_stack, var))
                   pivot = var;
@@ -7921,7 +8055,7 @@ AGAIN:
       if (qdpll->options.trace && is_init_reason_empty
           && (qdpll->result_constraint == NULL ||
               qdpll->result_constraint->size_lits))
-        qdpll->trace_constraint (++(qdpll->cur_constraint_id),
+        qdpll->trace_constraint (qdpll, ++(qdpll->cur_constraint_id),
                                  (*lit_stack)->start,
                                  QDPLL_COUNT_STACK (**lit_stack), cid, 0);
       return 0;
@@ -7972,13 +8106,13 @@ set_learnt_constraint_lit_watchers (QDPLL * qdpll,
                                     Var * implied,
                                     const QDPLLQuantifierType type)
 {
-  assert (implied->decision_level != QDPLL_INVALID_DECISION_LEVEL &&
-          implied->decision_level > asserting_level);
+  assert (QDPLL_VAR_LEVEL (qdpll->pcnf, implied) != QDPLL_INVALID_DECISION_LEVEL &&
+          QDPLL_VAR_LEVEL (qdpll->pcnf, implied) > asserting_level);
   assert (learnt_constraint->is_cube || type == QDPLL_QTYPE_EXISTS);
   assert (!learnt_constraint->is_cube || type == QDPLL_QTYPE_FORALL);
   Var *vars = qdpll->pcnf.vars;
   QDPLLDepManGeneric *dm = qdpll->dm;
-  const unsigned int implied_level = implied->decision_level;
+  const unsigned int implied_level = QDPLL_VAR_LEVEL (qdpll->pcnf, implied);
   const VarID implied_id = implied->id;
   assert (implied_level > asserting_level &&
           implied_level != QDPLL_INVALID_DECISION_LEVEL);
@@ -7990,7 +8124,7 @@ set_learnt_constraint_lit_watchers (QDPLL * qdpll,
     {
       LitID lit = *p;
       Var *var = LIT2VARPTR (vars, lit);
-      const unsigned int level = var->decision_level;
+      const unsigned int level = QDPLL_VAR_LEVEL (qdpll->pcnf, var);
       assert (level != QDPLL_INVALID_DECISION_LEVEL
               || type != var->scope->type);
       /* Assumes that constraint is asserting. */
@@ -8060,12 +8194,12 @@ chron_backtracking (QDPLL * qdpll, const QDPLLQuantifierType type)
     {
       id = *p;
       Var *assigned_var = VARID2VARPTR (vars, id);
-      assert (QDPLL_VAR_ASSIGNED (assigned_var));
+      assert (QDPLL_VAR_ASSIGNED (qdpll->pcnf, assigned_var));
       assert (assigned_var->mode != QDPLL_VARMODE_UNDEF);
       if (type == assigned_var->scope->type
           && assigned_var->mode == QDPLL_VARMODE_LBRANCH)
         {
-          assert (assigned_var->decision_level !=
+          assert (QDPLL_VAR_LEVEL (qdpll->pcnf, assigned_var) !=
                   QDPLL_INVALID_DECISION_LEVEL);
           assert (!qdpll->state.forced_assignment.antecedent);
           assert (!qdpll->state.forced_assignment.var);
@@ -8074,9 +8208,9 @@ chron_backtracking (QDPLL * qdpll, const QDPLLQuantifierType type)
           /* Set forced assignment (flipping decision variable) to be enqueued afterwards. */
           qdpll->state.forced_assignment.var = assigned_var;
           qdpll->state.forced_assignment.assignment =
-            -assigned_var->assignment;
+            -QDPLL_VAR_VALUE (qdpll->pcnf, assigned_var);
           qdpll->state.forced_assignment.mode = QDPLL_VARMODE_RBRANCH;
-          return assigned_var->decision_level;
+          return QDPLL_VAR_LEVEL (qdpll->pcnf, assigned_var);
         }
     }
 
@@ -8181,15 +8315,15 @@ qpup_res_unmark_var (Var *var)
 static void
 qpup_collect_qpup_node (QDPLL *qdpll, Var *var)
 {
-  pqueue_insert (qdpll->mm, qdpll->qpup_nodes, var, var->trail_pos);
-  assert (var->decision_level != QDPLL_INVALID_DECISION_LEVEL);
-  if (!qdpll->qpup_var_at_max_dec_level || qdpll->qpup_var_at_max_dec_level->decision_level < var->decision_level)
+  pqueue_insert (qdpll->mm, qdpll->qpup_nodes, var, QDPLL_VAR_TRAIL_POS (qdpll->pcnf, var));
+  assert (QDPLL_VAR_LEVEL (qdpll->pcnf, var) != QDPLL_INVALID_DECISION_LEVEL);
+  if (!qdpll->qpup_var_at_max_dec_level || QDPLL_VAR_LEVEL (qdpll->pcnf, qdpll->qpup_var_at_max_dec_level) < QDPLL_VAR_LEVEL (qdpll->pcnf, var))
     {
       /* Found new maximum decision level. */
       qdpll->qpup_var_at_max_dec_level = var;
       qdpll->qpup_cnt_at_max_dec_level = 1;
     }
-  else if (qdpll->qpup_var_at_max_dec_level->decision_level == var->decision_level)
+  else if (QDPLL_VAR_LEVEL (qdpll->pcnf, qdpll->qpup_var_at_max_dec_level) == QDPLL_VAR_LEVEL (qdpll->pcnf, var))
     qdpll->qpup_cnt_at_max_dec_level++;
 }
 
@@ -8223,14 +8357,14 @@ qpup_check_marks_and_collect (QDPLL * qdpll, LitID lit, Var *implied_var, const
         {
           /* Collect universal (existential) literals in CDCL (SDCL) for dependency checking. */
           qpup_mark_var_by_lit (var, lit);
-          QDPLL_PUSH_STACK(mm, qdpll->qpup_vars, var);
+          QDPLL_PUSH_STACK_UNINIT(QPUP_MM (qdpll), qdpll->qpup_vars, var);
           /* Collect universal (existential) decision variables. IMPORTANT: we
              might see a universal literal of a decision variable in an
              antecedent although that literal was implicitly reduced during QBCP. In this
              case we do not collect the universal variable if it was assigned at
              a larger decision level. This amount to checking if the literal was
              reduced implicitly. */
-          if ((!implied_var || var->decision_level <= implied_var->decision_level) && 
+          if ((!implied_var || QDPLL_VAR_LEVEL (qdpll->pcnf, var) <= QDPLL_VAR_LEVEL (qdpll->pcnf, implied_var)) && 
               (var->mode == QDPLL_VARMODE_LBRANCH || var->mode == QDPLL_VARMODE_RBRANCH || 
                var->mode == QDPLL_VARMODE_ASSUMED))
             qpup_collect_qpup_node (qdpll, var);
@@ -8248,7 +8382,7 @@ qpup_traverse_implication_graph_push_nodes (QDPLL * qdpll, LitID *lits_start, Li
   assert (type == QDPLL_QTYPE_FORALL || type == QDPLL_QTYPE_EXISTS);
   assert (lits_start || !lits_end);
   assert (lits_start <= lits_end);
-  assert (!implied_var || QDPLL_VAR_ASSIGNED(implied_var));
+  assert (!implied_var || QDPLL_VAR_ASSIGNED (qdpll->pcnf, implied_var));
   assert (!implied_var || implied_var->scope->type == type);
   assert (!implied_var || implied_var->mode == QDPLL_VARMODE_UNIT);
 
@@ -8285,7 +8419,7 @@ qpup_select_next_node (QDPLL *qdpll)
       for (p = qdpll->qpup_nodes->queue, e = p + qdpll->qpup_nodes->cnt; p < e; p++)
         {
           Var *var = p->data;
-          fprintf (stderr, "(%d,%d) ", var->id, var->trail_pos);
+          fprintf (stderr, "(%d,%d) ", var->id, QDPLL_VAR_TRAIL_POS (qdpll->pcnf, var));
         }
       fprintf (stderr, "\n");
     }
@@ -8317,14 +8451,14 @@ qpup_find_unique_var_at_max_dec_level (QDPLL *qdpll)
       for (p = qdpll->qpup_nodes->queue, e = p + qdpll->qpup_nodes->cnt; p < e; p++)
         {
           Var *var = p->data;
-          assert (var->decision_level != QDPLL_INVALID_DECISION_LEVEL);
-          if (!var_at_max_dec_level || var_at_max_dec_level->decision_level < var->decision_level)
+          assert (QDPLL_VAR_LEVEL (qdpll->pcnf, var) != QDPLL_INVALID_DECISION_LEVEL);
+          if (!var_at_max_dec_level || QDPLL_VAR_LEVEL (qdpll->pcnf, var_at_max_dec_level) < QDPLL_VAR_LEVEL (qdpll->pcnf, var))
             {
               /* Found new maximum decision level. */
               var_at_max_dec_level = var;
               cnt_at_max_dec_level = 1;
             }
-          else if (var_at_max_dec_level->decision_level == var->decision_level)
+          else if (QDPLL_VAR_LEVEL (qdpll->pcnf, var_at_max_dec_level) == QDPLL_VAR_LEVEL (qdpll->pcnf, var))
             cnt_at_max_dec_level++;
         }
       qdpll->qpup_var_at_max_dec_level = var_at_max_dec_level;
@@ -8334,12 +8468,12 @@ qpup_find_unique_var_at_max_dec_level (QDPLL *qdpll)
   /* Explicitly handle decision level 0: if the maximum decision level is 0
      then we want to continue anyway to derive the empty
      constraint. This is relevant only if a trace is printed out. */
-  if (!qdpll->qpup_var_at_max_dec_level || qdpll->qpup_var_at_max_dec_level->decision_level == 0)
+  if (!qdpll->qpup_var_at_max_dec_level || QDPLL_VAR_LEVEL (qdpll->pcnf, qdpll->qpup_var_at_max_dec_level) == 0)
     return 0;
   else
     {
       assert (qdpll->qpup_var_at_max_dec_level);
-      assert (qdpll->qpup_var_at_max_dec_level->decision_level != QDPLL_INVALID_DECISION_LEVEL);
+      assert (QDPLL_VAR_LEVEL (qdpll->pcnf, qdpll->qpup_var_at_max_dec_level) != QDPLL_INVALID_DECISION_LEVEL);
       assert (qdpll->qpup_cnt_at_max_dec_level > 0);
       if (qdpll->qpup_cnt_at_max_dec_level == 1)
         {
@@ -8413,7 +8547,7 @@ qpup_check_dependency (QDPLL *qdpll, Var *var, const QDPLLQuantifierType type)
              tautology; check whether 'u' would prevent learnt clause from
              being asserting. */
 
-          if ((!(QDPLL_VAR_ASSIGNED(u) && u->decision_level < var->decision_level)) 
+          if ((!(QDPLL_VAR_ASSIGNED (qdpll->pcnf, u) && QDPLL_VAR_LEVEL (qdpll->pcnf, u) < QDPLL_VAR_LEVEL (qdpll->pcnf, var))) 
               && dm->depends(dm, u->id, var->id))
             return u;
         }
@@ -8448,13 +8582,13 @@ qpup_find_and_check_uip_candidate(QDPLL *qdpll, const QDPLLQuantifierType type)
 
       /* Check if 'uip_candidate' is assigned at a decision level
          where the decision variable is existential (universal) in CDCL (SDCL). */
-      assert (uip_candidate->decision_level >= 1);
+      assert (QDPLL_VAR_LEVEL (qdpll->pcnf, uip_candidate) >= 1);
       assert (uip_candidate->mode == QDPLL_VARMODE_UNIT || 
               uip_candidate->mode == QDPLL_VARMODE_LBRANCH || uip_candidate->mode == QDPLL_VARMODE_RBRANCH);
       Var *decision_var =
         VARID2VARPTR (qdpll->pcnf.vars,
-                      qdpll->dec_vars.start[uip_candidate->decision_level - 1]);
-      assert (decision_var->decision_level == uip_candidate->decision_level);
+                      qdpll->dec_vars.start[QDPLL_VAR_LEVEL (qdpll->pcnf, uip_candidate) - 1]);
+      assert (QDPLL_VAR_LEVEL (qdpll->pcnf, decision_var) == QDPLL_VAR_LEVEL (qdpll->pcnf, uip_candidate));
       assert (decision_var->mode == QDPLL_VARMODE_LBRANCH
               || decision_var->mode == QDPLL_VARMODE_RBRANCH);
       if (decision_var->scope->type == type)
@@ -8513,14 +8647,14 @@ qpup_find_relevant_uip (QDPLL *qdpll, const QDPLLQuantifierType type)
   Var *cur;
   while (!qpup_find_and_check_uip_candidate(qdpll, type) && (cur = qpup_select_next_node (qdpll)))
     {
-      assert (QDPLL_VAR_ASSIGNED(cur));
+      assert (QDPLL_VAR_ASSIGNED (qdpll->pcnf, cur));
       assert (cur->mode == QDPLL_VARMODE_LBRANCH || cur->mode == QDPLL_VARMODE_RBRANCH || 
               cur->mode == QDPLL_VARMODE_UNIT || 
               (qdpll->state.assumptions_given && cur->mode == QDPLL_VARMODE_ASSUMED));
 
       if (qdpll->options.verbosity >= 2)
         fprintf (stderr, "\nQPUP UIP search: cur node = %d, decision level %d, trail position %d\n", 
-                 cur->id, cur->decision_level, cur->trail_pos);
+                 cur->id, QDPLL_VAR_LEVEL (qdpll->pcnf, cur), QDPLL_VAR_TRAIL_POS (qdpll->pcnf, cur));
 
       if (cur->mode == QDPLL_VARMODE_LBRANCH || cur->mode == QDPLL_VARMODE_RBRANCH || 
           cur->mode == QDPLL_VARMODE_ASSUMED)
@@ -8549,7 +8683,7 @@ qpup_find_relevant_uip (QDPLL *qdpll, const QDPLLQuantifierType type)
                                                 cur, type);
           /* Collect traversed units on separate stack. That is used later for
              the actual production of QPUP clauses. */
-          QDPLL_PUSH_STACK(qdpll->mm, qdpll->qpup_units, cur);
+          QDPLL_PUSH_STACK(QPUP_MM (qdpll), qdpll->qpup_units, cur);
         }
     }
 
@@ -8568,13 +8702,13 @@ static void
 qpup_collect_weak_predict_lits_push (QDPLL *qdpll, Var *var, LitID lit)
 {
   if (var->is_internal)
-    QDPLL_PUSH_STACK(qdpll->mm, qdpll->internal_cover_lits, lit);
+    QDPLL_PUSH_STACK_UNINIT(qdpll->mm, qdpll->internal_cover_lits, lit);
   else if (var->user_scope)
-    QDPLL_PUSH_STACK(qdpll->mm, var->user_scope->cover_lits, lit);
+    QDPLL_PUSH_STACK_UNINIT(qdpll->mm, var->user_scope->cover_lits, lit);
   else
     {
       assert (var->scope == qdpll->pcnf.scopes.first);
-      QDPLL_PUSH_STACK(qdpll->mm, var->scope->cover_lits, lit);
+      QDPLL_PUSH_STACK_UNINIT(qdpll->mm, var->scope->cover_lits, lit);
     }
 }
 
@@ -8597,10 +8731,10 @@ qpup_collect_weak_predict_lits (QDPLL *qdpll, Var *var, LitID lit, const QDPLLQu
       lit = var->id;
       if (type == QDPLL_QTYPE_EXISTS)
         {
-          if (var->assignment == QDPLL_ASSIGNMENT_TRUE)
+          if (QDPLL_VAR_VALUE (qdpll->pcnf, var) == QDPLL_ASSIGNMENT_TRUE)
             lit = -lit;
         }
-      else if (var->assignment == QDPLL_ASSIGNMENT_FALSE)
+      else if (QDPLL_VAR_VALUE (qdpll->pcnf, var) == QDPLL_ASSIGNMENT_FALSE)
         lit = -lit;
     }
 
@@ -8615,13 +8749,13 @@ qpup_collect_weak_predict_lits (QDPLL *qdpll, Var *var, LitID lit, const QDPLLQu
       else
         var->qpup_pos_predict_mark = 1;
       if (var->is_internal)
-        QDPLL_PUSH_STACK(qdpll->mm, qdpll->internal_cover_lits, lit);
+        QDPLL_PUSH_STACK_UNINIT(qdpll->mm, qdpll->internal_cover_lits, lit);
       else if (var->user_scope)
-        QDPLL_PUSH_STACK(qdpll->mm, var->user_scope->cover_lits, lit);
+        QDPLL_PUSH_STACK_UNINIT(qdpll->mm, var->user_scope->cover_lits, lit);
       else
         {
           assert (var->scope == qdpll->pcnf.scopes.first);
-          QDPLL_PUSH_STACK(qdpll->mm, var->scope->cover_lits, lit);
+          QDPLL_PUSH_STACK_UNINIT(qdpll->mm, var->scope->cover_lits, lit);
         }
     }
   else
@@ -8638,7 +8772,7 @@ qpup_collect_weak_predict_lits (QDPLL *qdpll, Var *var, LitID lit, const QDPLLQu
          backtracking to the asserting level and thus the learned constraint
          would not be asserting. Hence these literals cannot occur in the
          learned clause. */
-      if ((!(QDPLL_VAR_ASSIGNED(var) && var->decision_level < qdpll->qpup_uip->decision_level)) 
+      if ((!(QDPLL_VAR_ASSIGNED (qdpll->pcnf, var) && QDPLL_VAR_LEVEL (qdpll->pcnf, var) < QDPLL_VAR_LEVEL (qdpll->pcnf, qdpll->qpup_uip))) 
           && qdpll->dm->depends(qdpll->dm, var->id, qdpll->qpup_uip->id))
         return;
       /* Otherwise, collect literal if not already present. Must also handle
@@ -8697,7 +8831,7 @@ qpup_collect_weak_predict_lits_aux_collect (QDPLL *qdpll, LitIDStack *cover_lits
         {
           /* Cannot use "KEEP-ONE_SELECTOR-LITERAL" optimization if clause
              groups are used. */
-          QDPLL_PUSH_STACK(qdpll->mm, qdpll->qpup_weak_predict_lits, lit);
+          QDPLL_PUSH_STACK_UNINIT(QPUP_MM (qdpll), qdpll->qpup_weak_predict_lits, lit);
           if (!qdpll->options.bump_vars_once)
             increase_var_activity (qdpll, var, var->scope);
         }
@@ -8706,8 +8840,8 @@ qpup_collect_weak_predict_lits_aux_collect (QDPLL *qdpll, LitIDStack *cover_lits
           if (var->is_internal && type == QDPLL_QTYPE_EXISTS)
             {
               assert (!var->is_internal || 
-                      (QDPLL_LIT_NEG(lit) && QDPLL_VAR_ASSIGNED_TRUE(var)) || 
-                      (QDPLL_LIT_POS(lit) && QDPLL_VAR_ASSIGNED_FALSE(var)));
+                      (QDPLL_LIT_NEG(lit) && QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var)) || 
+                      (QDPLL_LIT_POS(lit) && QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var)));
               assert (var->scope == qdpll->pcnf.scopes.first);
               assert (var->clause_group_id > 0);
               assert (qdpll->state.cur_used_internal_vars.start[var->clause_group_id - 1] == var->id);
@@ -8720,7 +8854,7 @@ qpup_collect_weak_predict_lits_aux_collect (QDPLL *qdpll, LitIDStack *cover_lits
           else
             {
               /* Same code as in branch 'if (clause_group_api_called)' above. */
-              QDPLL_PUSH_STACK(qdpll->mm, qdpll->qpup_weak_predict_lits, lit);
+              QDPLL_PUSH_STACK_UNINIT(QPUP_MM (qdpll), qdpll->qpup_weak_predict_lits, lit);
               if (!qdpll->options.bump_vars_once)
                 increase_var_activity (qdpll, var, var->scope);
             }
@@ -8734,7 +8868,7 @@ qpup_collect_weak_predict_lits_aux_collect (QDPLL *qdpll, LitIDStack *cover_lits
           assert (cover_lits == &qdpll->internal_cover_lits);
           assert (kept_selector_lit);
           /* Same code as in branch 'if (clause_group_api_called)' above. */
-          QDPLL_PUSH_STACK(qdpll->mm, qdpll->qpup_weak_predict_lits, kept_selector_lit);
+          QDPLL_PUSH_STACK_UNINIT(QPUP_MM (qdpll), qdpll->qpup_weak_predict_lits, kept_selector_lit);
           if (!qdpll->options.bump_vars_once)
             increase_var_activity (qdpll, kept_selector_var, kept_selector_var->scope);
           kept_selector_var = 0;
@@ -8828,14 +8962,14 @@ qpup_print_info_kept_literals (QDPLL *qdpll, Var * var, const QDPLLQuantifierTyp
   LitID lit = var->id;
   if (type == QDPLL_QTYPE_EXISTS)
     {
-      if (var->assignment == QDPLL_ASSIGNMENT_TRUE)
+      if (QDPLL_VAR_VALUE (qdpll->pcnf, var) == QDPLL_ASSIGNMENT_TRUE)
         lit = -lit;
     }
-  else if (var->assignment == QDPLL_ASSIGNMENT_FALSE)
+  else if (QDPLL_VAR_VALUE (qdpll->pcnf, var) == QDPLL_ASSIGNMENT_FALSE)
     lit = -lit;
   fprintf (stderr, "%s lit. %d: DEFINITELY IN\n", type_string, lit);
   /* Here, no double pushing can occur. */
-  QDPLL_PUSH_STACK(qdpll->mm, qdpll->qpup_kept_lits, lit);
+  QDPLL_PUSH_STACK(QPUP_MM (qdpll), qdpll->qpup_kept_lits, lit);
 }
 
 
@@ -8858,7 +8992,7 @@ qpup_check_remaining_nodes (QDPLL *qdpll, const QDPLLQuantifierType type)
       assert (qdpll->qpup_uip);
       if (qdpll->options.verbosity >= 2)
         fprintf (stderr, "QPUP node checking: cur node = %d, decision level %d, trail position %d\n", 
-                 cur->id, cur->decision_level, cur->trail_pos);
+                 cur->id, QDPLL_VAR_LEVEL (qdpll->pcnf, cur), QDPLL_VAR_TRAIL_POS (qdpll->pcnf, cur));
 
       /* Ignore found UIP. */
       if (cur == qdpll->qpup_uip)
@@ -8873,9 +9007,9 @@ qpup_check_remaining_nodes (QDPLL *qdpll, const QDPLLQuantifierType type)
           continue;
         }
 
-      assert (QDPLL_VAR_ASSIGNED(cur));
-      assert (QDPLL_VAR_ASSIGNED(qdpll->qpup_uip));
-      assert (cur->decision_level < qdpll->qpup_uip->decision_level);
+      assert (QDPLL_VAR_ASSIGNED (qdpll->pcnf, cur));
+      assert (QDPLL_VAR_ASSIGNED (qdpll->pcnf, qdpll->qpup_uip));
+      assert (QDPLL_VAR_LEVEL (qdpll->pcnf, cur) < QDPLL_VAR_LEVEL (qdpll->pcnf, qdpll->qpup_uip));
 
       if (cur->mode == QDPLL_VARMODE_LBRANCH || cur->mode == QDPLL_VARMODE_RBRANCH || 
           cur->mode == QDPLL_VARMODE_ASSUMED)
@@ -8925,7 +9059,7 @@ qpup_check_remaining_nodes (QDPLL *qdpll, const QDPLLQuantifierType type)
                                                     cur, type);
               /* Collect traversed units on separate stack. That is used later for
                  the actual production of QPUP clauses. */
-              QDPLL_PUSH_STACK(qdpll->mm, qdpll->qpup_units, cur);
+              QDPLL_PUSH_STACK(QPUP_MM (qdpll), qdpll->qpup_units, cur);
             }
         }
     }
@@ -8943,7 +9077,7 @@ qpup_print_info_literals (QDPLL *qdpll, LitID lit, LitID *ante_lits_start,
   assert (qdpll->options.verbosity >= 2);
   assert (ante_lits_start <= ante_lits_end);
   assert (qdpll->qpup_uip);
-  assert (QDPLL_VAR_ASSIGNED(qdpll->qpup_uip));
+  assert (QDPLL_VAR_ASSIGNED (qdpll->pcnf, qdpll->qpup_uip));
   Var *var = LIT2VARPTR(qdpll->pcnf.vars, lit);
   const char *type_string = type == QDPLL_QTYPE_EXISTS ? "QPUP predict univ." : "QPUP predict exist.";
 
@@ -9129,8 +9263,8 @@ qpup_res_reduce_by_depschemes_aux (QDPLL *qdpll, LitID lit, const QDPLLQuantifie
   else
     LEARN_VAR_POS_MARK (var);
 
-  assert (qdpll->state.decision_level != 0 || var->decision_level == 0 ||
-          var->decision_level == QDPLL_INVALID_DECISION_LEVEL);
+  assert (qdpll->state.decision_level != 0 || QDPLL_VAR_LEVEL (qdpll->pcnf, var) == 0 ||
+          QDPLL_VAR_LEVEL (qdpll->pcnf, var) == QDPLL_INVALID_DECISION_LEVEL);
   assert (LEARN_VAR_MARKED (var));
   assert (QDPLL_LIT_POS (lit) || LEARN_VAR_NEG_MARKED (var));
   assert (QDPLL_LIT_NEG (lit) || LEARN_VAR_POS_MARKED (var));
@@ -9144,10 +9278,10 @@ qpup_res_reduce_by_depschemes_aux (QDPLL *qdpll, LitID lit, const QDPLLQuantifie
         {
           QDPLL_VAR_POS_MARK (rep);
           assert (QDPLL_COUNT_STACK (rep->type_red_member_lits) == 0);
-          QDPLL_PUSH_STACK (mm, qdpll->wreason_a, rep);
+          QDPLL_PUSH_STACK_UNINIT (mm, qdpll->wreason_a, rep);
         }
       /* Collect class members. */
-      QDPLL_PUSH_STACK (mm, rep->type_red_member_lits, lit);
+      QDPLL_PUSH_STACK_UNINIT (mm, rep->type_red_member_lits, lit);
     }
   else
     {
@@ -9161,10 +9295,10 @@ qpup_res_reduce_by_depschemes_aux (QDPLL *qdpll, LitID lit, const QDPLLQuantifie
         {
           QDPLL_VAR_POS_MARK (rep);
           assert (QDPLL_COUNT_STACK (rep->type_red_member_lits) == 0);
-          QDPLL_PUSH_STACK (mm, qdpll->wreason_e, rep);
+          QDPLL_PUSH_STACK_UNINIT (mm, qdpll->wreason_e, rep);
         }
       /* Collect class members. */
-      QDPLL_PUSH_STACK (mm, rep->type_red_member_lits, lit);
+      QDPLL_PUSH_STACK_UNINIT (mm, rep->type_red_member_lits, lit);
     }
 }
 
@@ -9251,7 +9385,7 @@ qpup_res_reduce (QDPLL *qdpll, LitIDStack *stack, const ConstraintID trace_id, c
         {
           /* Trace reduced constraint. */
           qdpll->cur_constraint_id++;
-          qdpll->trace_constraint (qdpll->cur_constraint_id, stack->start,
+          qdpll->trace_constraint (qdpll, qdpll->cur_constraint_id, stack->start,
                                    QDPLL_COUNT_STACK (*stack), trace_id, 0);
         }
       else
@@ -9284,7 +9418,7 @@ qpup_res_merge_lits_aux (QDPLL *qdpll, QDPLLMemMan *mm, Var *vars, LitIDStack *s
               if (!qpup_res_is_var_neg_marked(v))
                 {
                   qpup_res_mark_var (v, 0);
-                  QDPLL_PUSH_STACK(mm, *stack, lit);
+                  QDPLL_PUSH_STACK_UNINIT(mm, *stack, lit);
                   if (!qdpll->options.bump_vars_once)
                     increase_var_activity (qdpll, v, v->scope);
                 }
@@ -9295,7 +9429,7 @@ qpup_res_merge_lits_aux (QDPLL *qdpll, QDPLLMemMan *mm, Var *vars, LitIDStack *s
               if (!qpup_res_is_var_pos_marked(v))
                 {
                   qpup_res_mark_var (v, 1);
-                  QDPLL_PUSH_STACK(mm, *stack, lit);
+                  QDPLL_PUSH_STACK_UNINIT(mm, *stack, lit);
                   if (!qdpll->options.bump_vars_once)
                     increase_var_activity (qdpll, v, v->scope);
 
@@ -9305,7 +9439,7 @@ qpup_res_merge_lits_aux (QDPLL *qdpll, QDPLLMemMan *mm, Var *vars, LitIDStack *s
       else
         {
           assert (qpup_res_is_var_marked(v));
-          QDPLL_PUSH_STACK(mm, *stack, lit);
+          QDPLL_PUSH_STACK_UNINIT(mm, *stack, lit);
         }
     }
   else
@@ -9350,7 +9484,7 @@ qpup_res_merge_literals (QDPLL *qdpll, Var *pivot, LitIDStack *resolvent_lits,
   assert_lits_sorted (qdpll, start1, end1);
   assert_lits_sorted (qdpll, start2, end2);
 #endif
-  QDPLLMemMan *mm = qdpll->mm;
+  QDPLLMemMan *mm = QPUP_MM (qdpll);
   Var *vars = qdpll->pcnf.vars;
   LitIDStack tmp;
   QDPLL_INIT_STACK(tmp);
@@ -9467,7 +9601,7 @@ qpup_compute (QDPLL *qdpll, Var *pivot, LitIDStack *resolvent_lits,
       assert (!QDPLL_LIT_NEG (lit) || !qpup_res_is_var_neg_marked (v));
       assert (!QDPLL_LIT_POS (lit) || !qpup_res_is_var_pos_marked (v));
       qpup_res_mark_var_by_lit(v, lit);
-      QDPLL_PUSH_STACK(qdpll->mm, *resolvent_lits, lit);
+      QDPLL_PUSH_STACK(QPUP_MM (qdpll), *resolvent_lits, lit);
       /* NOTE: can omit if-statement when permanently using qpup learning. */
       if (!qdpll->options.bump_vars_once)
         increase_var_activity (qdpll, v, v->scope);
@@ -9502,7 +9636,7 @@ qpup_compute (QDPLL *qdpll, Var *pivot, LitIDStack *resolvent_lits,
           if (qdpll->options.trace)
             {
               qdpll->cur_constraint_id++;
-              qdpll->trace_constraint (qdpll->cur_constraint_id, resolvent_lits->start,
+              qdpll->trace_constraint (qdpll, qdpll->cur_constraint_id, resolvent_lits->start,
                                        QDPLL_COUNT_STACK (*resolvent_lits), ante_trace_id,
                                        v->qpup_constraint->id);
               ante_trace_id = qdpll->cur_constraint_id;
@@ -9538,7 +9672,7 @@ qpup_compute (QDPLL *qdpll, Var *pivot, LitIDStack *resolvent_lits,
       if (ante_trace_id == trace_id)
         {
           qdpll->cur_constraint_id++;
-          qdpll->trace_constraint (qdpll->cur_constraint_id, resolvent_lits->start,
+          qdpll->trace_constraint (qdpll, qdpll->cur_constraint_id, resolvent_lits->start,
                                    QDPLL_COUNT_STACK (*resolvent_lits), ante_trace_id,
                                    0);
           ante_trace_id = qdpll->cur_constraint_id;
@@ -9636,7 +9770,8 @@ qpup_do_forward_resolutions (QDPLL *qdpll, LitIDStack *empty_constraint_lits, co
 
           /* Allocate QPUP constraint of variable 'unit' and copy literals. */
           assert (!unit->qpup_constraint);
-          unit->qpup_constraint = create_constraint (qdpll, QDPLL_COUNT_STACK(qpup_constraint_lits), type == QDPLL_QTYPE_FORALL);
+          unit->qpup_constraint = create_constraint (qdpll, QDPLL_COUNT_STACK(qpup_constraint_lits), type == QDPLL_QTYPE_FORALL,
+                                                     LEARNT_MEM_CATEGORY (type == QDPLL_QTYPE_FORALL));
           memcpy (unit->qpup_constraint->lits, qpup_constraint_lits.start, 
                   QDPLL_COUNT_STACK(qpup_constraint_lits) * sizeof (LitID));
 
@@ -9663,11 +9798,12 @@ qpup_do_forward_resolutions (QDPLL *qdpll, LitIDStack *empty_constraint_lits, co
       qdpll->cur_constraint_id--;
     }
 
-  Constraint *qpup_learnt_constraint = create_constraint (qdpll, QDPLL_COUNT_STACK(qpup_constraint_lits), type == QDPLL_QTYPE_FORALL);
+  Constraint *qpup_learnt_constraint = create_constraint (qdpll, QDPLL_COUNT_STACK(qpup_constraint_lits), type == QDPLL_QTYPE_FORALL,
+                                                          LEARNT_MEM_CATEGORY (type == QDPLL_QTYPE_FORALL));
   memcpy (qpup_learnt_constraint->lits, qpup_constraint_lits.start, 
           QDPLL_COUNT_STACK(qpup_constraint_lits) * sizeof (LitID));
 
-  QDPLL_DELETE_STACK(qdpll->mm, qpup_constraint_lits);
+  QDPLL_DELETE_STACK(QPUP_MM (qdpll), qpup_constraint_lits);
 
   if (qdpll->options.verbosity >= 2)
     {
@@ -9729,7 +9865,7 @@ qpup_compute_asserting_level (QDPLL *qdpll, Var *asserted_var,
     {
       LitID lit = *p;
       Var *var = LIT2VARPTR(qdpll->pcnf.vars, lit);
-      unsigned int cur_level = var->decision_level;
+      unsigned int cur_level = QDPLL_VAR_LEVEL (qdpll->pcnf, var);
 
       if (type == var->scope->type
           || dm->depends (dm, var->id, asserted_var->id))
@@ -9864,7 +10000,7 @@ qpup_import_learnt_constraint (QDPLL *qdpll, Constraint *qpup_constraint,
       if (qdpll->options.no_spure_literals &&
           !qdpll->options.no_pure_literals)
         {
-          BLitsOcc blit = {lit, qpup_constraint};
+          BLitsOcc blit = {lit, qpup_constraint->ref};
           /* Add all literals to occurrence stacks. 
              POSSIBLE OPTIMIZATION: could factor out code. */
           if (!qpup_constraint->is_cube)
@@ -9876,7 +10012,6 @@ qpup_import_learnt_constraint (QDPLL *qdpll, Constraint *qpup_constraint,
             }
           else
             {
-              blit.constraint = BLIT_MARK_PTR(blit.constraint);
               if (QDPLL_LIT_NEG (lit))
                 QDPLL_PUSH_STACK(mm, var->neg_occ_cubes, blit);
               else
@@ -9915,8 +10050,8 @@ qpup_cleanup_aux_constraints (QDPLL *qdpll, Constraint *learnt_constraint,
               check_invariant_qpup_is_subseteq (qdpll, v->qpup_constraint, 
                                                 learnt_constraint, 
                                                 type == QDPLL_QTYPE_EXISTS ? 
-                                                (v->assignment == QDPLL_ASSIGNMENT_FALSE ? -v->id : v->id) : 
-                                                (v->assignment == QDPLL_ASSIGNMENT_FALSE ? v->id : -v->id), type));
+                                                (QDPLL_VAR_VALUE (qdpll->pcnf, v) == QDPLL_ASSIGNMENT_FALSE ? -v->id : v->id) : 
+                                                (QDPLL_VAR_VALUE (qdpll->pcnf, v) == QDPLL_ASSIGNMENT_FALSE ? v->id : -v->id), type));
       delete_constraint (qdpll, v->qpup_constraint);
       v->qpup_constraint = 0;
     }
@@ -10030,7 +10165,8 @@ qpup_compute_learnt_constraint (QDPLL *qdpll, LitIDStack *empty_constraint_lits,
 
       qpup_learnt_constraint = 
         create_constraint (qdpll, QDPLL_COUNT_STACK(qdpll->qpup_weak_predict_lits), 
-                           type == QDPLL_QTYPE_FORALL);
+                           type == QDPLL_QTYPE_FORALL,
+                           LEARNT_MEM_CATEGORY (type == QDPLL_QTYPE_FORALL));
       memcpy (qpup_learnt_constraint->lits, qdpll->qpup_weak_predict_lits.start, 
               QDPLL_COUNT_STACK(qdpll->qpup_weak_predict_lits) * sizeof (LitID));
     }
@@ -10191,9 +10327,9 @@ generate_and_add_reason (QDPLL * qdpll, const QDPLLQuantifierType type)
           /* Set assignment to be forced by learnt constraint. */
           assert (!qdpll->state.forced_assignment.var);
           qdpll->state.forced_assignment.var = qdpll->qpup_uip;
-          assert (QDPLL_VAR_ASSIGNED(qdpll->qpup_uip));
+          assert (QDPLL_VAR_ASSIGNED (qdpll->pcnf, qdpll->qpup_uip));
           assert (!qdpll->state.forced_assignment.assignment);
-          qdpll->state.forced_assignment.assignment = -qdpll->qpup_uip->assignment;
+          qdpll->state.forced_assignment.assignment = -QDPLL_VAR_VALUE (qdpll->pcnf, qdpll->qpup_uip);
           assert (!qdpll->state.forced_assignment.mode);
           qdpll->state.forced_assignment.mode = QDPLL_VARMODE_UNIT;
           assert (!qdpll->state.forced_assignment.antecedent);
@@ -10303,8 +10439,8 @@ generate_and_add_reason (QDPLL * qdpll, const QDPLLQuantifierType type)
                                            resolving */
       Constraint *learnt_constraint = 0;
       learnt_constraint =
-        create_constraint (qdpll, QDPLL_COUNT_STACK (*lit_stack),
-                           type == QDPLL_QTYPE_FORALL);
+        create_learnt_constraint (qdpll, QDPLL_COUNT_STACK (*lit_stack),
+                                  type == QDPLL_QTYPE_FORALL);
 #if COMPUTE_STATS
       learnt_constraint->is_taut = is_taut;
 #endif
@@ -10345,7 +10481,7 @@ generate_and_add_reason (QDPLL * qdpll, const QDPLLQuantifierType type)
 
           /* Compute asserting level. */
           var = LIT2VARPTR (vars, lit);
-          get_assert_level = var->decision_level;
+          get_assert_level = QDPLL_VAR_LEVEL (qdpll->pcnf, var);
           if (type == var->scope->type
               || dm->depends (dm, var->id, type_var_id))
             {
@@ -10365,23 +10501,22 @@ generate_and_add_reason (QDPLL * qdpll, const QDPLLQuantifierType type)
           if (qdpll->options.no_spure_literals &&
               !qdpll->options.no_pure_literals)
             {
-              BLitsOcc blit = { lit, learnt_constraint };
+              BLitsOcc blit = { lit, learnt_constraint->ref };
               /* Add all literals to occurrence stacks. 
                  POSSIBLE OPTIMIZATION: could factor out code. */
               if (type == QDPLL_QTYPE_EXISTS)
                 {
                   if (QDPLL_LIT_NEG (lit))
-                    QDPLL_PUSH_STACK (mm, var->neg_occ_clauses, blit);
+                    QDPLL_PUSH_STACK_UNINIT (mm, var->neg_occ_clauses, blit);
                   else
-                    QDPLL_PUSH_STACK (mm, var->pos_occ_clauses, blit);
+                    QDPLL_PUSH_STACK_UNINIT (mm, var->pos_occ_clauses, blit);
                 }
               else
                 {
-                  blit.constraint = BLIT_MARK_PTR (blit.constraint);
                   if (QDPLL_LIT_NEG (lit))
-                    QDPLL_PUSH_STACK (mm, var->neg_occ_cubes, blit);
+                    QDPLL_PUSH_STACK_UNINIT (mm, var->neg_occ_cubes, blit);
                   else
-                    QDPLL_PUSH_STACK (mm, var->pos_occ_cubes, blit);
+                    QDPLL_PUSH_STACK_UNINIT (mm, var->pos_occ_cubes, blit);
                 }
             }
         }
@@ -10397,7 +10532,7 @@ generate_and_add_reason (QDPLL * qdpll, const QDPLLQuantifierType type)
           LINK_FIRST (qdpll->pcnf.learnt_cubes, learnt_constraint, link);
         }
 
-      assert (QDPLL_VAR_ASSIGNED (type_var));
+      assert (QDPLL_VAR_ASSIGNED (qdpll->pcnf, type_var));
       /* Set forced assignment (by asserting reason) to be enqueued afterwards. */
       assert (type == type_var->scope->type);
       assert (!qdpll->state.forced_assignment.antecedent);
@@ -10405,7 +10540,7 @@ generate_and_add_reason (QDPLL * qdpll, const QDPLLQuantifierType type)
       assert (!qdpll->state.forced_assignment.assignment);
       assert (!qdpll->state.forced_assignment.mode);
       qdpll->state.forced_assignment.var = type_var;
-      qdpll->state.forced_assignment.assignment = -type_var->assignment;
+      qdpll->state.forced_assignment.assignment = -QDPLL_VAR_VALUE (qdpll->pcnf, type_var);
       qdpll->state.forced_assignment.mode = QDPLL_VARMODE_UNIT;
 
       assert (asserting_level ==
@@ -10450,7 +10585,8 @@ generate_and_add_reason (QDPLL * qdpll, const QDPLLQuantifierType type)
           QDPLL_ABORT_QDPLL(qdpll->assumption_lits_constraint, "must call 'qdpll_reset' before 'qdpll_sat'!");
           qdpll->assumption_lits_constraint = 
             create_constraint (qdpll, QDPLL_COUNT_STACK(*lit_stack), 
-                               type == QDPLL_QTYPE_FORALL);
+                               type == QDPLL_QTYPE_FORALL,
+                               LEARNT_MEM_CATEGORY (type == QDPLL_QTYPE_FORALL));
           memcpy (qdpll->assumption_lits_constraint->lits, (*lit_stack).start, 
                   QDPLL_COUNT_STACK(*lit_stack) * sizeof (LitID));
         }
@@ -10581,15 +10717,15 @@ qbcp_qbce_backtrack_clear_stack_of_stacks (QDPLL *qdpll, ConstraintPtrStackStack
 static void
 backtrack_undo_assignment (QDPLL * qdpll, Var * var, const int notify_active)
 {
-  assert (QDPLL_VAR_ASSIGNED (var));
-  assert (var->assignment != QDPLL_ASSIGNMENT_UNDEF);
+  assert (QDPLL_VAR_ASSIGNED (qdpll->pcnf, var));
+  assert (QDPLL_VAR_VALUE (qdpll->pcnf, var) != QDPLL_ASSIGNMENT_UNDEF);
   assert (var->mode != QDPLL_VARMODE_UNDEF);
-  assert (var->decision_level > 0);
-  assert (var->decision_level != QDPLL_INVALID_DECISION_LEVEL);
-  assert (var->trail_pos != QDPLL_INVALID_TRAIL_POS);
-  assert (var->trail_pos <
+  assert (QDPLL_VAR_LEVEL (qdpll->pcnf, var) > 0);
+  assert (QDPLL_VAR_LEVEL (qdpll->pcnf, var) != QDPLL_INVALID_DECISION_LEVEL);
+  assert (QDPLL_VAR_TRAIL_POS (qdpll->pcnf, var) != QDPLL_INVALID_TRAIL_POS);
+  assert (QDPLL_VAR_TRAIL_POS (qdpll->pcnf, var) <
           (unsigned int) (qdpll->assigned_vars_top - qdpll->assigned_vars));
-  assert (qdpll->assigned_vars[var->trail_pos] == var->id);
+  assert (qdpll->assigned_vars[QDPLL_VAR_TRAIL_POS (qdpll->pcnf, var)] == var->id);
   QDPLLDepManGeneric *dm = qdpll->dm;
 
   if (var->mode == QDPLL_VARMODE_LBRANCH
@@ -10601,7 +10737,7 @@ backtrack_undo_assignment (QDPLL * qdpll, Var * var, const int notify_active)
       QDPLL_POP_STACK (qdpll->dec_vars);
       if (qdpll->options.empty_formula_watching)
         {
-          assert (var->decision_level == 
+          assert (QDPLL_VAR_LEVEL (qdpll->pcnf, var) == 
                   QDPLL_COUNT_STACK (qdpll->empty_formula_watchers_per_dec_level));
           assert (!QDPLL_EMPTY_STACK (qdpll->empty_formula_watchers_per_dec_level));
           qdpll->empty_formula_watcher = 
@@ -10612,18 +10748,18 @@ backtrack_undo_assignment (QDPLL * qdpll, Var * var, const int notify_active)
           /* Remove stack of clauses blocked at decision level of 'var' and reset
              blocked-flag of clauses. */
           qbcp_qbce_backtrack_clear_stack_of_stacks 
-            (qdpll, &qdpll->qbcp_qbce_blocked_clauses, 1, var->decision_level);
+            (qdpll, &qdpll->qbcp_qbce_blocked_clauses, 1, QDPLL_VAR_LEVEL (qdpll->pcnf, var));
           /* Remove stack of clauses marked at decision level of 'var' and reset
              marked-flag of clauses. */
           qbcp_qbce_backtrack_clear_stack_of_stacks 
-            (qdpll, &qdpll->qbcp_qbce_marked_clauses, 0, var->decision_level);
+            (qdpll, &qdpll->qbcp_qbce_marked_clauses, 0, QDPLL_VAR_LEVEL (qdpll->pcnf, var));
         }
     }
 
   var->mode = QDPLL_VARMODE_UNDEF;
-  var->assignment = QDPLL_ASSIGNMENT_UNDEF;
-  var->decision_level = QDPLL_INVALID_DECISION_LEVEL;
-  var->trail_pos = QDPLL_INVALID_TRAIL_POS;
+  QDPLL_VAR_VALUE (qdpll->pcnf, var) = QDPLL_ASSIGNMENT_UNDEF;
+  QDPLL_VAR_LEVEL (qdpll->pcnf, var) = QDPLL_INVALID_DECISION_LEVEL;
+  QDPLL_VAR_TRAIL_POS (qdpll->pcnf, var) = QDPLL_INVALID_TRAIL_POS;
   if (var->antecedent)
     {
       assert (!var->antecedent->qbcp_qbce_blocked);
@@ -10659,31 +10795,31 @@ qbcp_qbce_reset_offset_in_working_queue (QDPLL *qdpll, QBCENonBlockedWitness pai
       fprintf (stderr, "WATCHING: reset queue offset of maybe-blocked pair\n");
     }
   /* Reset offset-in-working-queue of 'pair' on notify list. */
-  Constraint *c = pair.blit_occ.constraint;
+  Constraint *c = BLIT_CONSTRAINT (qdpll->pcnf, pair.blit_occ);
   if (qdpll->options.verbosity >= 3)
     {
       fprintf (stderr, "WATCHING:   non-bl-lit %d, wo-value %d and clause: ", pair.non_blocking_lit, pair.offset.witness_in_witness_list);
       print_constraint (qdpll, c);
     }
   assert (pair.offset.witness_in_witness_list < 
-          QDPLL_COUNT_STACK (c->qbcp_qbce_witness_clauses));
+          QDPLL_COUNT_STACK (c->qbce->qbcp_qbce_witness_clauses));
   QBCENonBlockedWitness witness_pair = 
-    c->qbcp_qbce_witness_clauses.start[pair.offset.witness_in_witness_list];
+    qbcp_qbce_get_state (qdpll, c)->qbcp_qbce_witness_clauses.start[pair.offset.witness_in_witness_list];
   assert (witness_pair.non_blocking_lit == pair.non_blocking_lit);
   if (qdpll->options.verbosity >= 3)
     {
       fprintf (stderr, "WATCHING:   witness clause with mo-offset %d: ", witness_pair.offset.maybe_blocked_clause_in_notify_list);
-      print_constraint (qdpll, witness_pair.blit_occ.constraint);
+      print_constraint (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, witness_pair.blit_occ));
     }
   unsigned int offset_of_pair_in_notify_list = 
     witness_pair.offset.maybe_blocked_clause_in_notify_list;
   assert (offset_of_pair_in_notify_list != QDPLL_INVALID_WATCHER_POS);
-  Constraint *w = witness_pair.blit_occ.constraint;
+  Constraint *w = BLIT_CONSTRAINT (qdpll->pcnf, witness_pair.blit_occ);
   assert (offset_of_pair_in_notify_list < 
-          QDPLL_COUNT_STACK (w->qbcp_qbce_notify_maybe_blocked_clauses));
-  assert (w->qbcp_qbce_notify_maybe_blocked_clauses.start
+          QDPLL_COUNT_STACK (w->qbce->qbcp_qbce_notify_maybe_blocked_clauses));
+  assert (w->qbce->qbcp_qbce_notify_maybe_blocked_clauses.start
           [offset_of_pair_in_notify_list].offset_in_working_queue != QDPLL_INVALID_WATCHER_POS);
-  w->qbcp_qbce_notify_maybe_blocked_clauses.start
+  qbcp_qbce_get_state (qdpll, w)->qbcp_qbce_notify_maybe_blocked_clauses.start
     [offset_of_pair_in_notify_list].offset_in_working_queue = QDPLL_INVALID_WATCHER_POS;
 }
 
@@ -10751,16 +10887,16 @@ backtrack (QDPLL * qdpll, unsigned int backtrack_level)
        p--)
     {
       Var *assigned_var = VARID2VARPTR (vars, *p);
-      assert (QDPLL_VAR_ASSIGNED (assigned_var));
-      assert (assigned_var->assignment != QDPLL_ASSIGNMENT_UNDEF);
-      assert (assigned_var->decision_level != QDPLL_INVALID_DECISION_LEVEL);
+      assert (QDPLL_VAR_ASSIGNED (qdpll->pcnf, assigned_var));
+      assert (QDPLL_VAR_VALUE (qdpll->pcnf, assigned_var) != QDPLL_ASSIGNMENT_UNDEF);
+      assert (QDPLL_VAR_LEVEL (qdpll->pcnf, assigned_var) != QDPLL_INVALID_DECISION_LEVEL);
       assert (assigned_var->mode != QDPLL_VARMODE_UNDEF);
       assert (assigned_var->mode != QDPLL_VARMODE_LBRANCH
               || !assigned_var->antecedent);
       assert (assigned_var->mode != QDPLL_VARMODE_RBRANCH
               || !assigned_var->antecedent);
 
-      unsigned int var_decision_level = assigned_var->decision_level;
+      unsigned int var_decision_level = QDPLL_VAR_LEVEL (qdpll->pcnf, assigned_var);
       if (var_decision_level >= backtrack_level)
         backtrack_undo_assignment (qdpll, assigned_var, p < old_bcp_ptr);
       else
@@ -10780,8 +10916,8 @@ backtrack (QDPLL * qdpll, unsigned int backtrack_level)
       /* Set marks of variables appearing in the clause currently being
          watched. The watched clause was updated during backtracking. */
       update_empty_formula_watcher_toggle_var_marks (qdpll, qdpll->empty_formula_watcher, 1);
-      assert (!qdpll->empty_formula_watcher->constraint->qbcp_qbce_blocked);
-      assert (!is_clause_satisfied (qdpll, qdpll->empty_formula_watcher->constraint));
+      assert (!BLIT_CONSTRAINT (qdpll->pcnf, *(qdpll->empty_formula_watcher))->qbcp_qbce_blocked);
+      assert (!is_clause_satisfied (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, *(qdpll->empty_formula_watcher))));
       assert (QDPLL_COUNT_STACK 
               (qdpll->empty_formula_watchers_per_dec_level) == 
               qdpll->state.decision_level);
@@ -10816,7 +10952,7 @@ select_decision_variable (QDPLL * qdpll)
       candidate_var = VARID2VARPTR (vars, candidate);
       assert (dm->is_candidate (dm, candidate));
 
-      if (!QDPLL_VAR_ASSIGNED (candidate_var) &&
+      if (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, candidate_var) &&
           candidate_var->priority_pos == QDPLL_INVALID_PQUEUE_POS)
         var_pqueue_insert (qdpll, candidate_var->id, candidate_var->priority);
     }
@@ -10837,12 +10973,12 @@ select_decision_variable (QDPLL * qdpll)
       /* Candidates on queue possibly already assigned (unit or pure literals). */
       assert (decision_var->priority_pos == QDPLL_INVALID_PQUEUE_POS);
     }
-  while (QDPLL_VAR_ASSIGNED (decision_var)
+  while (QDPLL_VAR_ASSIGNED (qdpll->pcnf, decision_var)
          || !dm->is_candidate (dm, decision_var_id));
 
   assert (decision_var->mode == QDPLL_VARMODE_UNDEF);
-  assert (!QDPLL_VAR_ASSIGNED (decision_var));
-  assert (decision_var->decision_level == QDPLL_INVALID_DECISION_LEVEL);
+  assert (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, decision_var));
+  assert (QDPLL_VAR_LEVEL (qdpll->pcnf, decision_var) == QDPLL_INVALID_DECISION_LEVEL);
 
   return decision_var;
 }
@@ -10861,8 +10997,8 @@ compute_sdcl_score_from_clause (QDPLL * qdpll, Var * var, Constraint * clause)
       if (v != var)
         {
           /* Clause is already satisfied by another literal. */
-          if ((QDPLL_LIT_NEG (lit) && QDPLL_VAR_ASSIGNED_FALSE (v)) ||
-              (QDPLL_LIT_POS (lit) && QDPLL_VAR_ASSIGNED_TRUE (v)))
+          if ((QDPLL_LIT_NEG (lit) && QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, v)) ||
+              (QDPLL_LIT_POS (lit) && QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, v)))
             return 1;
         }
     }
@@ -10876,10 +11012,10 @@ compute_sdcl_score (QDPLL * qdpll, Var * var, LitID lit, BLitsOccStack * occs)
   BLitsOcc *bp, *be;
   for (bp = occs->start, be = occs->top; bp < be; bp++)
     {
-      if (bp->constraint->qbcp_qbce_blocked)
+      if (BLIT_CONSTRAINT (qdpll->pcnf, *bp)->qbcp_qbce_blocked)
         continue;
-      assert (!BLIT_MARKED_PTR (bp->constraint));
-      sum += compute_sdcl_score_from_clause (qdpll, var, bp->constraint);
+      assert (!BLIT_MARKED_REF (bp->cref));
+      sum += compute_sdcl_score_from_clause (qdpll, var, BLIT_CONSTRAINT (qdpll->pcnf, *bp));
     }
   return sum;
 }
@@ -10908,13 +11044,13 @@ compute_qtype_score (QDPLL * qdpll, Var * var, LitID lit,
   BLitsOcc *bp, *be;
   for (bp = occs->start, be = occs->top; bp < be; bp++)
     {
-      assert (!BLIT_MARKED_PTR (bp->constraint));
-      assert (!bp->constraint->is_cube);
-      if (bp->constraint->qbcp_qbce_blocked)
+      assert (!BLIT_MARKED_REF (bp->cref));
+      assert (!BLIT_CONSTRAINT (qdpll->pcnf, *bp)->is_cube);
+      if (BLIT_CONSTRAINT (qdpll->pcnf, *bp)->qbcp_qbce_blocked)
         continue;
-      if (!is_clause_satisfied (qdpll, bp->constraint))
+      if (!is_clause_satisfied (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, *bp)))
         {
-          assert (!is_clause_empty (qdpll, bp->constraint));
+          assert (!is_clause_empty (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, *bp)));
           sum++;
         }
     }
@@ -11031,19 +11167,19 @@ check_disabling_blocking_lit (QDPLL * qdpll, BLitsOcc blit_occ,
     qdpll->stats.blits_tested++;
 #endif
   assert (blit_occ.blit);
-  assert (blit_occ.constraint);
+  assert (BLIT_CONSTRAINT (qdpll->pcnf, blit_occ));
   /* Blocking literal must occur in constraint. If the blocking literal is a
      literal of an internal variable then we must properly rename them if the
      variable is enlarged dynamically. */
-  assert (constraint_has_lit (BLIT_STRIP_PTR(blit_occ.constraint), blit_occ.blit));
-  Constraint *constraint = blit_occ.constraint;
+  assert (constraint_has_lit (BLIT_CONSTRAINT (qdpll->pcnf, blit_occ), blit_occ.blit));
   LitID lit = blit_occ.blit;
-  Var *var = LIT2VARPTR (qdpll->pcnf.vars, lit);
-  const int is_cube = BLIT_MARKED_PTR (constraint);
+  const QDPLLAssignment value =
+    QDPLL_VARID_VALUE (qdpll->pcnf, LIT2VARID (lit));
+  const int is_cube = BLIT_MARKED_REF (blit_occ.cref);
   if (is_cube)
     {
-      if ((QDPLL_LIT_NEG (lit) && QDPLL_VAR_ASSIGNED_TRUE (var)) ||
-          (QDPLL_LIT_POS (lit) && QDPLL_VAR_ASSIGNED_FALSE (var)))
+      if ((QDPLL_LIT_NEG (lit) && value == QDPLL_ASSIGNMENT_TRUE) ||
+          (QDPLL_LIT_POS (lit) && value == QDPLL_ASSIGNMENT_FALSE))
         {
 #if COMPUTE_STATS
           if (called_on_pure_lits)
@@ -11056,8 +11192,8 @@ check_disabling_blocking_lit (QDPLL * qdpll, BLitsOcc blit_occ,
     }
   else
     {
-      if ((QDPLL_LIT_NEG (lit) && QDPLL_VAR_ASSIGNED_FALSE (var)) ||
-          (QDPLL_LIT_POS (lit) && QDPLL_VAR_ASSIGNED_TRUE (var)))
+      if ((QDPLL_LIT_NEG (lit) && value == QDPLL_ASSIGNMENT_FALSE) ||
+          (QDPLL_LIT_POS (lit) && value == QDPLL_ASSIGNMENT_TRUE))
         {
 #if COMPUTE_STATS
           if (called_on_pure_lits)
@@ -11069,8 +11205,8 @@ check_disabling_blocking_lit (QDPLL * qdpll, BLitsOcc blit_occ,
         }
     }
 
-  /* Blocking literal does not disable constraint, so return stripped pointer. */
-  return BLIT_STRIP_PTR (constraint);
+  /* Blocking literal does not disable constraint, so return the constraint. */
+  return BLIT_CONSTRAINT (qdpll->pcnf, blit_occ);
 }
 
 
@@ -11081,16 +11217,16 @@ propagate_variable_assigned (QDPLL * qdpll, Var * var,
                              BLitsOccStack * lit_notify_list)
 {
   assert (var->id);
-  assert (QDPLL_VAR_ASSIGNED (var));
+  assert (QDPLL_VAR_ASSIGNED (qdpll->pcnf, var));
   assert (var->mode != QDPLL_VARMODE_UNDEF);
   assert (!QDPLL_VAR_MARKED_PROPAGATED (var));
-  assert (!QDPLL_VAR_ASSIGNED_TRUE (var)
+  assert (!QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var)
           || clause_notify_list == &(var->pos_notify_clause_watchers));
-  assert (!QDPLL_VAR_ASSIGNED_TRUE (var)
+  assert (!QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var)
           || lit_notify_list == &(var->pos_notify_lit_watchers));
-  assert (!QDPLL_VAR_ASSIGNED_FALSE (var)
+  assert (!QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var)
           || clause_notify_list == &(var->neg_notify_clause_watchers));
-  assert (!QDPLL_VAR_ASSIGNED_FALSE (var)
+  assert (!QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var)
           || lit_notify_list == &(var->neg_notify_lit_watchers));
 #if COMPUTE_STATS
   qdpll->stats.total_notify_litw_list_size +=
@@ -11128,7 +11264,7 @@ propagate_variable_assigned (QDPLL * qdpll, Var * var,
          variant of QBCE. Then we simply ignore it. */
       if (c->qbcp_qbce_blocked)
         continue;
-      assert (c && !BLIT_MARKED_PTR (c));
+      assert (c);
       if (!(sentinel = update_literal_watchers (qdpll, var, p)))
         {
           /* Conflict detected either by empty clause or attempted 
@@ -11208,8 +11344,8 @@ sizeof_top_level (QDPLL * qdpll)
   for (p = qdpll->assigned_vars, e = qdpll->assigned_vars_top; p < e; p++)
     {
       Var *var = VARID2VARPTR (vars, *p);
-      assert (var->decision_level != QDPLL_INVALID_DECISION_LEVEL);
-      if (var->decision_level == 0)
+      assert (QDPLL_VAR_LEVEL (qdpll->pcnf, var) != QDPLL_INVALID_DECISION_LEVEL);
+      if (QDPLL_VAR_LEVEL (qdpll->pcnf, var) == 0)
         result++;
       else
         break;
@@ -11229,7 +11365,7 @@ is_lit_reducible_in_clause (QDPLL * qdpll, LitID lit, Constraint * c,
   Var *vars = qdpll->pcnf.vars;
   VarID varid = LIT2VARID (lit);
   Var *var = VARID2VARPTR (vars, varid);
-  assert (!QDPLL_VAR_ASSIGNED (var));
+  assert (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, var));
   if (var->scope->type == QDPLL_QTYPE_EXISTS)
     return 0;
   LitID *p, *e;
@@ -11241,10 +11377,10 @@ is_lit_reducible_in_clause (QDPLL * qdpll, LitID lit, Constraint * c,
         continue;
       /* Any assigned literal must be false. Satisfied clauses should have
          been handled outside this function. */
-      assert (!QDPLL_VAR_ASSIGNED (pvar) ||
-              (QDPLL_VAR_ASSIGNED_FALSE (pvar) && QDPLL_LIT_POS (*p)) ||
-              (QDPLL_VAR_ASSIGNED_TRUE (pvar) && QDPLL_LIT_NEG (*p)));
-      if (QDPLL_VAR_ASSIGNED (pvar))
+      assert (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, pvar) ||
+              (QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, pvar) && QDPLL_LIT_POS (*p)) ||
+              (QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, pvar) && QDPLL_LIT_NEG (*p)));
+      if (QDPLL_VAR_ASSIGNED (qdpll->pcnf, pvar))
         continue;
       if (qdpll->dm->depends (qdpll->dm, varid, pvar->id))
         return 0;
@@ -11280,7 +11416,7 @@ qbcp_qbce_find_pair_in_list (QDPLL *qdpll, QBCENonBlockedWitnessStack *list,
   qdpll->stats.qbcp_qbce_find_entry_calls++;
 #endif
   assert (!find_clause_only || !find_lit_only);
-  assert (pair.non_blocking_lit || pair.blit_occ.constraint);
+  assert (pair.non_blocking_lit || BLIT_CONSTRAINT (qdpll->pcnf, pair.blit_occ));
   QBCENonBlockedWitness *p, *e;
   for (p = list->start, e = list->top; p < e; p++)
     {
@@ -11289,7 +11425,7 @@ qbcp_qbce_find_pair_in_list (QDPLL *qdpll, QBCENonBlockedWitnessStack *list,
 #endif
       QBCENonBlockedWitness w = *p;
       if ((find_clause_only || w.non_blocking_lit == pair.non_blocking_lit) && 
-          (find_lit_only || w.blit_occ.constraint == pair.blit_occ.constraint))
+          (find_lit_only || BLIT_CONSTRAINT (qdpll->pcnf, w.blit_occ) == BLIT_CONSTRAINT (qdpll->pcnf, pair.blit_occ)))
         return p;
     }
   return 0;
@@ -11301,7 +11437,7 @@ qbcp_qbce_find_clause_in_list (QDPLL *qdpll, QBCENonBlockedWitnessStack *list,
                             Constraint *c)
 {
   /* Only entry 'c' matters in object 'pair', other members filled by dummy values. */
-  QBCENonBlockedWitness pair = {0, {0, c}, {QDPLL_INVALID_WATCHER_POS}, 
+  QBCENonBlockedWitness pair = {0, {0, c->ref}, {QDPLL_INVALID_WATCHER_POS}, 
                                 QDPLL_INVALID_WATCHER_POS};
   return qbcp_qbce_find_pair_in_list (qdpll, list, pair, 1, 0);
 }
@@ -11334,12 +11470,12 @@ qbcp_qbce_delete_list_entry (QDPLL *qdpll, QBCENonBlockedWitnessStack *list,
       fprintf (stderr, "WATCHING: deleting list entry, new list size %ld\n", QDPLL_COUNT_STACK (*list));
       fprintf (stderr, "WATCHING: deleting %s entry -- last item:\n", is_witness_entry ? "witness" : "maybe-blocked-clause");
       fprintf (stderr, "WATCHING:   clause: ");
-      print_constraint (qdpll, last.blit_occ.constraint);
+      print_constraint (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, last.blit_occ));
       fprintf (stderr, "WATCHING:   non-bl-lit: %d\n", last.non_blocking_lit);
       fprintf (stderr, "WATCHING:   %s-offset: %d\n", is_witness_entry ? "mo" : "wo", is_witness_entry ? last.offset.maybe_blocked_clause_in_notify_list : last.offset.witness_in_witness_list);
       fprintf (stderr, "WATCHING:   deleting %s entry -- deleted item:\n", is_witness_entry ? "witness" : "maybe-blocked-clause");
       fprintf (stderr, "WATCHING:     clause: ");
-      print_constraint (qdpll, entry_p->blit_occ.constraint);
+      print_constraint (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, entry_p->blit_occ));
       fprintf (stderr, "WATCHING:     non-bl-lit: %d\n", entry_p->non_blocking_lit);
       fprintf (stderr, "WATCHING:     %s-offset: %d\n", is_witness_entry ? "mo" : "wo", is_witness_entry ? entry_p->offset.maybe_blocked_clause_in_notify_list : entry_p->offset.witness_in_witness_list);
     }
@@ -11348,16 +11484,16 @@ qbcp_qbce_delete_list_entry (QDPLL *qdpll, QBCENonBlockedWitnessStack *list,
   if (is_witness_entry)
     {
       /* Update positions only if ordering of elements was changed by deletion. */
-      if (last.blit_occ.constraint != deleted.blit_occ.constraint ||  
+      if (BLIT_CONSTRAINT (qdpll->pcnf, last.blit_occ) != BLIT_CONSTRAINT (qdpll->pcnf, deleted.blit_occ) ||  
           last.non_blocking_lit != deleted.non_blocking_lit)
         {
           QBCENonBlockedWitness *maybe_blocked_pair_p = 
-            entry_p->blit_occ.constraint->qbcp_qbce_notify_maybe_blocked_clauses.start + 
+            qbcp_qbce_get_state (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, entry_p->blit_occ))->qbcp_qbce_notify_maybe_blocked_clauses.start + 
             last.offset.maybe_blocked_clause_in_notify_list;
           if (qdpll->options.verbosity >= 3)
             {
               fprintf (stderr, "WATCHING:   updating wo-value from %d to %d of clause (due to non-empty list after del.): ", maybe_blocked_pair_p->offset.witness_in_witness_list, new_offset);
-              print_constraint (qdpll, maybe_blocked_pair_p->blit_occ.constraint);
+              print_constraint (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, maybe_blocked_pair_p->blit_occ));
             }
           maybe_blocked_pair_p->offset.witness_in_witness_list = new_offset;
           if (maybe_blocked_pair_p->offset_in_working_queue != QDPLL_INVALID_WATCHER_POS)
@@ -11367,7 +11503,7 @@ qbcp_qbce_delete_list_entry (QDPLL *qdpll, QBCENonBlockedWitnessStack *list,
               if (qdpll->options.verbosity >= 3)
                 {
                   fprintf (stderr, "WATCHING:   update wo-values of enqueued item with non-bl-lit %d, wo-value %d, and clause: ", qdpll->qbcp_qbce_maybe_blocked_clauses.start[maybe_blocked_pair_p->offset_in_working_queue].non_blocking_lit, qdpll->qbcp_qbce_maybe_blocked_clauses.start[maybe_blocked_pair_p->offset_in_working_queue].offset.witness_in_witness_list);
-                  print_constraint (qdpll, qdpll->qbcp_qbce_maybe_blocked_clauses.start[maybe_blocked_pair_p->offset_in_working_queue].blit_occ.constraint);
+                  print_constraint (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, qdpll->qbcp_qbce_maybe_blocked_clauses.start[maybe_blocked_pair_p->offset_in_working_queue].blit_occ));
                 }
               /* Update witness offset for pair in working queue. */
               qdpll->qbcp_qbce_maybe_blocked_clauses.start
@@ -11379,18 +11515,18 @@ qbcp_qbce_delete_list_entry (QDPLL *qdpll, QBCENonBlockedWitnessStack *list,
   else
     {
       /* Update positions only if ordering of elements was changed by deletion. */
-      if (last.blit_occ.constraint != deleted.blit_occ.constraint ||  
+      if (BLIT_CONSTRAINT (qdpll->pcnf, last.blit_occ) != BLIT_CONSTRAINT (qdpll->pcnf, deleted.blit_occ) ||  
           last.non_blocking_lit != deleted.non_blocking_lit)
         {
           if (qdpll->options.verbosity >= 3)
             {
-              fprintf (stderr, "WATCHING:   NOTE: updating mo-value from %d to %d of clause: ", entry_p->blit_occ.constraint->qbcp_qbce_witness_clauses.start
+              fprintf (stderr, "WATCHING:   NOTE: updating mo-value from %d to %d of clause: ", qbcp_qbce_get_state (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, entry_p->blit_occ))->qbcp_qbce_witness_clauses.start
                        [last.offset.witness_in_witness_list].
                        offset.maybe_blocked_clause_in_notify_list, new_offset);
-              print_constraint (qdpll, entry_p->blit_occ.constraint->qbcp_qbce_witness_clauses.start
-                                [last.offset.witness_in_witness_list].blit_occ.constraint);
+              print_constraint (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, qbcp_qbce_get_state (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, entry_p->blit_occ))->qbcp_qbce_witness_clauses.start
+                                [last.offset.witness_in_witness_list].blit_occ));
             }
-          entry_p->blit_occ.constraint->qbcp_qbce_witness_clauses.start
+          qbcp_qbce_get_state (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, entry_p->blit_occ))->qbcp_qbce_witness_clauses.start
             [last.offset.witness_in_witness_list].
             offset.maybe_blocked_clause_in_notify_list = new_offset;
         }
@@ -11431,7 +11567,7 @@ qbcp_qbce_store_watched_occ (QDPLL *qdpll, Constraint *witness)
      inserted into the lists of watched occurrences of variables. Otherwise,
      'witness' already appears in the watched occurrences and no work is done
      here. */
-  if (QDPLL_EMPTY_STACK (witness->qbcp_qbce_notify_maybe_blocked_clauses))
+  if (QDPLL_EMPTY_STACK (qbcp_qbce_get_state (qdpll, witness)->qbcp_qbce_notify_maybe_blocked_clauses))
     {
       LitID * const start = witness->lits;
       LitID *p, *e;
@@ -11448,13 +11584,13 @@ qbcp_qbce_store_watched_occ (QDPLL *qdpll, Constraint *witness)
                       (qdpll, &var->qbcp_qbce_watched_neg_occ_clauses, witness));
               assert (QDPLL_COUNT_STACK (var->qbcp_qbce_watched_neg_occ_clauses) == 
                       QDPLL_COUNT_STACK (var->qbcp_qbce_offset_of_neg_lit_in_watched_occ));
-              QDPLL_PUSH_STACK (qdpll->mm, witness->qbcp_qbce_offset_of_witness_in_watched_occs, 
+              QDPLL_PUSH_STACK (QBCE_MM (qdpll), qbcp_qbce_get_state (qdpll, witness)->qbcp_qbce_offset_of_witness_in_watched_occs, 
                                 QDPLL_COUNT_STACK (var->qbcp_qbce_watched_neg_occ_clauses));
               QDPLL_PUSH_STACK 
-                (qdpll->mm, var->qbcp_qbce_watched_neg_occ_clauses, witness);
+                (QBCE_MM (qdpll), var->qbcp_qbce_watched_neg_occ_clauses, witness);
               assert (start <= p);
               QDPLL_PUSH_STACK 
-                (qdpll->mm, var->qbcp_qbce_offset_of_neg_lit_in_watched_occ, (unsigned int)(p - start));
+                (QBCE_MM (qdpll), var->qbcp_qbce_offset_of_neg_lit_in_watched_occ, (unsigned int)(p - start));
             }
           else
             {
@@ -11463,13 +11599,13 @@ qbcp_qbce_store_watched_occ (QDPLL *qdpll, Constraint *witness)
                       (qdpll, &var->qbcp_qbce_watched_pos_occ_clauses, witness));
               assert (QDPLL_COUNT_STACK (var->qbcp_qbce_watched_pos_occ_clauses) == 
                       QDPLL_COUNT_STACK (var->qbcp_qbce_offset_of_pos_lit_in_watched_occ));
-              QDPLL_PUSH_STACK (qdpll->mm, witness->qbcp_qbce_offset_of_witness_in_watched_occs, 
+              QDPLL_PUSH_STACK (QBCE_MM (qdpll), qbcp_qbce_get_state (qdpll, witness)->qbcp_qbce_offset_of_witness_in_watched_occs, 
                                 QDPLL_COUNT_STACK (var->qbcp_qbce_watched_pos_occ_clauses));
               QDPLL_PUSH_STACK 
-                (qdpll->mm, var->qbcp_qbce_watched_pos_occ_clauses, witness);
+                (QBCE_MM (qdpll), var->qbcp_qbce_watched_pos_occ_clauses, witness);
               assert (start <= p);
               QDPLL_PUSH_STACK 
-                (qdpll->mm, var->qbcp_qbce_offset_of_pos_lit_in_watched_occ, (unsigned int)(p - start));
+                (QBCE_MM (qdpll), var->qbcp_qbce_offset_of_pos_lit_in_watched_occ, (unsigned int)(p - start));
             } 
         }
     }
@@ -11499,10 +11635,12 @@ qbcp_qbce_delete_watched_occ_entry (ConstraintPtrStack *occ_list,
   /* If necessary, update offset entry in witness clause. */
   if (del_clause != clause_last)
     {
-      assert (clause_last->
+      /* Watched occurrences are witnesses, which have a QBCE state. */
+      assert (clause_last->qbce);
+      assert (clause_last->qbce->
         qbcp_qbce_offset_of_witness_in_watched_occs.start
               [offset_last] == QDPLL_COUNT_STACK (*occ_list));
-      clause_last->
+      clause_last->qbce->
         qbcp_qbce_offset_of_witness_in_watched_occs.start
         [offset_last] = entry_offset;
     }
@@ -11519,7 +11657,7 @@ qbcp_qbce_remove_watched_occ (QDPLL *qdpll, Constraint *old_witness)
   /* If 'old_witness' is no longer used as a witness for any clause being
      non-blocked, then remove 'old_witness' from the lists of watched occurrences
      of variables. */
-  if (QDPLL_EMPTY_STACK (old_witness->qbcp_qbce_notify_maybe_blocked_clauses))
+  if (QDPLL_EMPTY_STACK (qbcp_qbce_get_state (qdpll, old_witness)->qbcp_qbce_notify_maybe_blocked_clauses))
     {
       LitID * const start = old_witness->lits;
       LitID *p, *e;
@@ -11531,8 +11669,8 @@ qbcp_qbce_remove_watched_occ (QDPLL *qdpll, Constraint *old_witness)
           LitID lit = *p;
           Var *var = LIT2VARPTR (qdpll->pcnf.vars, lit);
           assert ((unsigned int)(p - start) < QDPLL_COUNT_STACK 
-                  (old_witness->qbcp_qbce_offset_of_witness_in_watched_occs));
-          unsigned int offset = old_witness->
+                  (old_witness->qbce->qbcp_qbce_offset_of_witness_in_watched_occs));
+          unsigned int offset = qbcp_qbce_get_state (qdpll, old_witness)->
             qbcp_qbce_offset_of_witness_in_watched_occs.start[p - start];
           if (QDPLL_LIT_NEG (lit))
             {
@@ -11554,7 +11692,7 @@ qbcp_qbce_remove_watched_occ (QDPLL *qdpll, Constraint *old_witness)
                  &var->qbcp_qbce_offset_of_pos_lit_in_watched_occ, offset);
             } 
         }
-      QDPLL_RESET_STACK (old_witness->qbcp_qbce_offset_of_witness_in_watched_occs);
+      QDPLL_RESET_STACK (qbcp_qbce_get_state (qdpll, old_witness)->qbcp_qbce_offset_of_witness_in_watched_occs);
     }
 }
 
@@ -11565,7 +11703,7 @@ static void
 qbcp_qbce_store_witness (QDPLL *qdpll, QBCENonBlockedWitness pair, 
                          Constraint *witness)
 {
-  Constraint *non_blocked_clause = pair.blit_occ.constraint;
+  Constraint *non_blocked_clause = BLIT_CONSTRAINT (qdpll->pcnf, pair.blit_occ);
   LitID non_blocking_lit = pair.non_blocking_lit;
   assert (QDPLL_VAR_EXISTS (LIT2VARPTR (qdpll->pcnf.vars, non_blocking_lit)));
   assert (constraint_has_lit (non_blocked_clause, non_blocking_lit));
@@ -11582,50 +11720,50 @@ qbcp_qbce_store_witness (QDPLL *qdpll, QBCENonBlockedWitness pair,
      every non-blocking literal. */
   QBCENonBlockedWitness *old_witness_pair_p = 
     pair.offset.witness_in_witness_list != QDPLL_INVALID_WATCHER_POS ? 
-    non_blocked_clause->qbcp_qbce_witness_clauses.start + 
+    qbcp_qbce_get_state (qdpll, non_blocked_clause)->qbcp_qbce_witness_clauses.start + 
     pair.offset.witness_in_witness_list : 0;
-  assert (old_witness_pair_p == qbcp_qbce_find_lit_in_list 
-	  (qdpll, &(non_blocked_clause->qbcp_qbce_witness_clauses), non_blocking_lit));
+  assert (old_witness_pair_p == (!non_blocked_clause->qbce ? 0 : qbcp_qbce_find_lit_in_list 
+	  (qdpll, &(non_blocked_clause->qbce->qbcp_qbce_witness_clauses), non_blocking_lit)));
   if (old_witness_pair_p)
     {
       /* We will always find an old witness, except during initialization. */
       QBCENonBlockedWitness old_witness_pair = *old_witness_pair_p;
       assert (old_witness_pair.non_blocking_lit);
-      assert (old_witness_pair.blit_occ.constraint);
+      assert (BLIT_CONSTRAINT (qdpll->pcnf, old_witness_pair.blit_occ));
 
-      if (witness == old_witness_pair.blit_occ.constraint)
+      if (witness == BLIT_CONSTRAINT (qdpll->pcnf, old_witness_pair.blit_occ))
         return;
 
       assert (old_witness_pair.non_blocking_lit == non_blocking_lit);
       /* Delete entry of old witness from witness list of 'non_blocked_clause'. */
       qbcp_qbce_delete_list_entry 
-        (qdpll, &(non_blocked_clause->qbcp_qbce_witness_clauses), old_witness_pair_p, 1);
-      assert (!qbcp_qbce_find_lit_in_list 
-              (qdpll, &(non_blocked_clause->qbcp_qbce_witness_clauses), non_blocking_lit));
+        (qdpll, &(qbcp_qbce_get_state (qdpll, non_blocked_clause)->qbcp_qbce_witness_clauses), old_witness_pair_p, 1);
+      assert (!non_blocked_clause->qbce || !qbcp_qbce_find_lit_in_list 
+              (qdpll, &(non_blocked_clause->qbce->qbcp_qbce_witness_clauses), non_blocking_lit));
       /* Delete entry of 'non_blocked_clause' from notify-list of old witness. */
       QBCENonBlockedWitness *non_blocked_clause_entry_p = 
 	old_witness_pair.offset.maybe_blocked_clause_in_notify_list != 
 	QDPLL_INVALID_WATCHER_POS ? 
-	old_witness_pair.blit_occ.constraint->qbcp_qbce_notify_maybe_blocked_clauses.start + 
+	qbcp_qbce_get_state (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, old_witness_pair.blit_occ))->qbcp_qbce_notify_maybe_blocked_clauses.start + 
 	old_witness_pair.offset.maybe_blocked_clause_in_notify_list : 0;
       assert (non_blocked_clause_entry_p == qbcp_qbce_find_clause_in_list 
-	      (qdpll, &(old_witness_pair.blit_occ.constraint->qbcp_qbce_notify_maybe_blocked_clauses), 
+	      (qdpll, &(BLIT_CONSTRAINT (qdpll->pcnf, old_witness_pair.blit_occ)->qbce->qbcp_qbce_notify_maybe_blocked_clauses), 
 	       non_blocked_clause));
       assert (non_blocked_clause_entry_p);
       QBCENonBlockedWitness non_blocked_clause_entry = *non_blocked_clause_entry_p;
       assert (non_blocked_clause_entry.non_blocking_lit);
-      assert (non_blocked_clause_entry.blit_occ.constraint);
+      assert (BLIT_CONSTRAINT (qdpll->pcnf, non_blocked_clause_entry.blit_occ));
       assert (non_blocked_clause_entry.non_blocking_lit == non_blocking_lit);
-      assert (non_blocked_clause_entry.blit_occ.constraint == non_blocked_clause);
+      assert (BLIT_CONSTRAINT (qdpll->pcnf, non_blocked_clause_entry.blit_occ) == non_blocked_clause);
       qbcp_qbce_delete_list_entry 
-        (qdpll, &(old_witness_pair.blit_occ.constraint->qbcp_qbce_notify_maybe_blocked_clauses), 
+        (qdpll, &(qbcp_qbce_get_state (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, old_witness_pair.blit_occ))->qbcp_qbce_notify_maybe_blocked_clauses), 
          non_blocked_clause_entry_p, 0);
-      assert (!qbcp_qbce_find_clause_in_list 
-              (qdpll, &(old_witness_pair.blit_occ.constraint->qbcp_qbce_notify_maybe_blocked_clauses), 
+      assert (!BLIT_CONSTRAINT (qdpll->pcnf, old_witness_pair.blit_occ)->qbce || !qbcp_qbce_find_clause_in_list 
+              (qdpll, &(BLIT_CONSTRAINT (qdpll->pcnf, old_witness_pair.blit_occ)->qbce->qbcp_qbce_notify_maybe_blocked_clauses), 
                non_blocked_clause));
       /* Remove 'old_witness_pair.clause' from lists of watched pos/neg occurrences
          IF AND ONLY IF it is no longer used as a witness. */
-      qbcp_qbce_remove_watched_occ (qdpll, old_witness_pair.blit_occ.constraint);
+      qbcp_qbce_remove_watched_occ (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, old_witness_pair.blit_occ));
     }
 
   /* Store 'witness' in list of watched pos/neg occurrences. This is necessary
@@ -11637,7 +11775,7 @@ qbcp_qbce_store_witness (QDPLL *qdpll, QBCENonBlockedWitness pair,
   assert (witness->num_lits > 0);
   assert (witness->lits[0]);
   QBCENonBlockedWitness witness_pair = {non_blocking_lit, 
-					{witness->lits[0], witness}, 
+					{witness->lits[0], witness->ref}, 
 					{QDPLL_INVALID_WATCHER_POS}, 
                                         QDPLL_INVALID_WATCHER_POS};
   /* Store offset of maybe-blocked clause in list
@@ -11645,36 +11783,36 @@ qbcp_qbce_store_witness (QDPLL *qdpll, QBCENonBlockedWitness pair,
      be notified, where maybe-blocked clause is added to below in
      terms of 'pair'. */
   unsigned int offset_of_maybe_blocked_clause_in_notify_list = 
-    QDPLL_COUNT_STACK (witness->qbcp_qbce_notify_maybe_blocked_clauses);
+    QDPLL_COUNT_STACK (qbcp_qbce_get_state (qdpll, witness)->qbcp_qbce_notify_maybe_blocked_clauses);
   witness_pair.offset.maybe_blocked_clause_in_notify_list = offset_of_maybe_blocked_clause_in_notify_list;
 
   /* Store 'non_blocking_clause' in notify list of 'witness'. */
-  assert (!qbcp_qbce_find_pair_in_list 
-          (qdpll, &(witness->qbcp_qbce_notify_maybe_blocked_clauses), pair, 0, 0));
-  assert (!qbcp_qbce_find_clause_in_list 
-          (qdpll, &(witness->qbcp_qbce_notify_maybe_blocked_clauses), non_blocked_clause));
+  assert (!witness->qbce || !qbcp_qbce_find_pair_in_list 
+          (qdpll, &(witness->qbce->qbcp_qbce_notify_maybe_blocked_clauses), pair, 0, 0));
+  assert (!witness->qbce || !qbcp_qbce_find_clause_in_list 
+          (qdpll, &(witness->qbce->qbcp_qbce_notify_maybe_blocked_clauses), non_blocked_clause));
   /* Store offset of witness clause in list
      'non_blocked_clause->qbcp_qbce_witness_clauses' of witness clauses, where
      witness clause is added to below in terms of 'witness_pair'. */
   unsigned int offset_of_witness_in_witness_list = 
-    QDPLL_COUNT_STACK (non_blocked_clause->qbcp_qbce_witness_clauses);
+    QDPLL_COUNT_STACK (qbcp_qbce_get_state (qdpll, non_blocked_clause)->qbcp_qbce_witness_clauses);
   pair.offset.witness_in_witness_list = offset_of_witness_in_witness_list;
   QDPLL_PUSH_STACK 
-    (qdpll->mm, witness->qbcp_qbce_notify_maybe_blocked_clauses, pair);
+    (QBCE_MM (qdpll), qbcp_qbce_get_state (qdpll, witness)->qbcp_qbce_notify_maybe_blocked_clauses, pair);
   /* Store 'witness' in witness list of 'non_blocking_clause'. */
-  assert (!qbcp_qbce_find_pair_in_list 
-          (qdpll, &(non_blocked_clause->qbcp_qbce_witness_clauses), witness_pair, 0, 0));
-  assert (!qbcp_qbce_find_lit_in_list 
-          (qdpll, &(non_blocked_clause->qbcp_qbce_witness_clauses), non_blocking_lit));
+  assert (!non_blocked_clause->qbce || !qbcp_qbce_find_pair_in_list 
+          (qdpll, &(non_blocked_clause->qbce->qbcp_qbce_witness_clauses), witness_pair, 0, 0));
+  assert (!non_blocked_clause->qbce || !qbcp_qbce_find_lit_in_list 
+          (qdpll, &(non_blocked_clause->qbce->qbcp_qbce_witness_clauses), non_blocking_lit));
   QDPLL_PUSH_STACK 
-    (qdpll->mm, non_blocked_clause->qbcp_qbce_witness_clauses, witness_pair);
-  assert (QDPLL_COUNT_STACK (non_blocked_clause->qbcp_qbce_witness_clauses) <= 
+    (QBCE_MM (qdpll), qbcp_qbce_get_state (qdpll, non_blocked_clause)->qbcp_qbce_witness_clauses, witness_pair);
+  assert (QDPLL_COUNT_STACK (non_blocked_clause->qbce->qbcp_qbce_witness_clauses) <= 
           non_blocked_clause->num_lits);
 
-  assert (witness_pair.offset.maybe_blocked_clause_in_notify_list < QDPLL_COUNT_STACK (witness_pair.blit_occ.constraint->qbcp_qbce_notify_maybe_blocked_clauses));
-  assert (witness_pair.blit_occ.constraint->qbcp_qbce_notify_maybe_blocked_clauses.start[witness_pair.offset.maybe_blocked_clause_in_notify_list].blit_occ.constraint == non_blocked_clause);
-  assert (pair.offset.witness_in_witness_list < QDPLL_COUNT_STACK (pair.blit_occ.constraint->qbcp_qbce_witness_clauses));
-  assert (pair.blit_occ.constraint->qbcp_qbce_witness_clauses.start[pair.offset.witness_in_witness_list].blit_occ.constraint == witness);
+  assert (witness_pair.offset.maybe_blocked_clause_in_notify_list < QDPLL_COUNT_STACK (BLIT_CONSTRAINT (qdpll->pcnf, witness_pair.blit_occ)->qbce->qbcp_qbce_notify_maybe_blocked_clauses));
+  assert (BLIT_CONSTRAINT (qdpll->pcnf, BLIT_CONSTRAINT (qdpll->pcnf, witness_pair.blit_occ)->qbce->qbcp_qbce_notify_maybe_blocked_clauses.start[witness_pair.offset.maybe_blocked_clause_in_notify_list].blit_occ) == non_blocked_clause);
+  assert (pair.offset.witness_in_witness_list < QDPLL_COUNT_STACK (BLIT_CONSTRAINT (qdpll->pcnf, pair.blit_occ)->qbce->qbcp_qbce_witness_clauses));
+  assert (BLIT_CONSTRAINT (qdpll->pcnf, BLIT_CONSTRAINT (qdpll->pcnf, pair.blit_occ)->qbce->qbcp_qbce_witness_clauses.start[pair.offset.witness_in_witness_list].blit_occ) == witness);
 
   if (qdpll->options.verbosity >= 3)
     {
@@ -11701,7 +11839,7 @@ qbcp_qbce_find_non_blocking_literal_witness (QDPLL *qdpll, LitID lit, Constraint
   assert (!c->qbcp_qbce_blocked);
   assert (!is_clause_satisfied (qdpll, c));
   Var *var = LIT2VARPTR (qdpll->pcnf.vars, lit);
-  assert (!QDPLL_VAR_ASSIGNED (var));
+  assert (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, var));
   /* Only existential literals can be blocking literals. */
   assert (QDPLL_SCOPE_EXISTS (var->scope));
   const Nesting nesting = var->scope->nesting;
@@ -11713,9 +11851,9 @@ qbcp_qbce_find_non_blocking_literal_witness (QDPLL *qdpll, LitID lit, Constraint
   BLitsOcc *bop, *boe;
   for (bop = occs->start, boe = occs->top; !witness && bop < boe; bop++)
     {
-      assert (!BLIT_MARKED_PTR(bop->constraint));
-      assert (!bop->constraint->is_cube);
-      assert (constraint_has_lit (bop->constraint, -lit));
+      assert (!BLIT_MARKED_REF (bop->cref));
+      assert (!BLIT_CONSTRAINT (qdpll->pcnf, *bop)->is_cube);
+      assert (constraint_has_lit (BLIT_CONSTRAINT (qdpll->pcnf, *bop), -lit));
 #if COMPUTE_STATS
       qdpll->stats.qbcp_qbce_clauses_seen++;
       qdpll->stats.qbcp_qbce_witness_is_clause_sat_cache_accesses++;
@@ -11733,7 +11871,7 @@ qbcp_qbce_find_non_blocking_literal_witness (QDPLL *qdpll, LitID lit, Constraint
           if (qdpll->options.verbosity >= 3)
             {
               fprintf (stderr, "    skipping already satisfied potential witness of literal %d: ", lit);
-              print_constraint (qdpll, bop->constraint);
+              print_constraint (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, *bop));
             }
           continue;
         }
@@ -11787,10 +11925,10 @@ qbcp_qbce_find_non_blocking_literal_witness (QDPLL *qdpll, LitID lit, Constraint
           Var *ovar = LIT2VARPTR(qdpll->pcnf.vars, olit);
           /* Ignore assigned variables. These assignment can never satisfy
              the clause, because satisfied clauses are ignored. */
-          assert (!QDPLL_VAR_ASSIGNED (ovar) || 
-                  (QDPLL_LIT_NEG (olit) && QDPLL_VAR_ASSIGNED_TRUE (ovar)) || 
-                  (QDPLL_LIT_POS (olit) && QDPLL_VAR_ASSIGNED_FALSE (ovar)));
-          if (QDPLL_VAR_ASSIGNED (ovar))
+          assert (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, ovar) || 
+                  (QDPLL_LIT_NEG (olit) && QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, ovar)) || 
+                  (QDPLL_LIT_POS (olit) && QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, ovar)));
+          if (QDPLL_VAR_ASSIGNED (qdpll->pcnf, ovar))
             continue;
           if (ovar->scope->nesting > nesting)
             {
@@ -11835,8 +11973,8 @@ qbcp_qbce_push_maybe_blocked_clauses_by_assignment (QDPLL *qdpll, Var *assigned_
   /* When using QBCE as inprocessing, then this function must be called at the
      top-level only. */
   assert (!qdpll->options.qbce_inprocessing || qdpll->state.decision_level == 0);
-  assert (QDPLL_VAR_ASSIGNED (assigned_var));
-  assert (!qdpll->options.qbce_inprocessing || assigned_var->decision_level == 0);
+  assert (QDPLL_VAR_ASSIGNED (qdpll->pcnf, assigned_var));
+  assert (!qdpll->options.qbce_inprocessing || QDPLL_VAR_LEVEL (qdpll->pcnf, assigned_var) == 0);
 
   if (qdpll->options.verbosity >= 3)
     fprintf (stderr, "pushing clauses based on assigned var %d to be checked in QBCE\n", 
@@ -11845,7 +11983,7 @@ qbcp_qbce_push_maybe_blocked_clauses_by_assignment (QDPLL *qdpll, Var *assigned_
   /* Check all clauses which are witnesses and satisfied by the current
      assignment. Push all clauses having their witnesses satisfied to be
      checked again for QBCE. */
-  ConstraintPtrStack *occs = QDPLL_VAR_ASSIGNED_TRUE (assigned_var) ? 
+  ConstraintPtrStack *occs = QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, assigned_var) ? 
     &(assigned_var->qbcp_qbce_watched_pos_occ_clauses) : 
     &(assigned_var->qbcp_qbce_watched_neg_occ_clauses);
 
@@ -11860,7 +11998,7 @@ qbcp_qbce_push_maybe_blocked_clauses_by_assignment (QDPLL *qdpll, Var *assigned_
                    c->qbcp_qbce_mark ? "marked" : "unmarked");
           print_constraint (qdpll, c);
           fprintf (stderr, "...which has notify-list length of %d\n", 
-                   (unsigned int) QDPLL_COUNT_STACK (c->qbcp_qbce_notify_maybe_blocked_clauses));
+                   c->qbce ? (unsigned int) QDPLL_COUNT_STACK (c->qbce->qbcp_qbce_notify_maybe_blocked_clauses) : 0);
         }
 
       /* We may see an occurrence multiple times if it is satsified by several
@@ -11874,13 +12012,13 @@ qbcp_qbce_push_maybe_blocked_clauses_by_assignment (QDPLL *qdpll, Var *assigned_
       assert (QDPLL_COUNT_STACK (qdpll->qbcp_qbce_marked_clauses) == 
               qdpll->state.decision_level + 1);
       QDPLL_PUSH_STACK 
-        (qdpll->mm, qdpll->qbcp_qbce_marked_clauses.start[qdpll->state.decision_level], c);
+        (QBCE_MM (qdpll), qdpll->qbcp_qbce_marked_clauses.start[qdpll->state.decision_level], c);
 
       /* Clause 'c' is now satisfied. Push all clauses for which 'c' is a
          witness. */
       QBCENonBlockedWitness *qp, *qe;
-      for (qp = c->qbcp_qbce_notify_maybe_blocked_clauses.start, 
-             qe = c->qbcp_qbce_notify_maybe_blocked_clauses.top; qp < qe; qp++)
+      for (qp = qbcp_qbce_get_state (qdpll, c)->qbcp_qbce_notify_maybe_blocked_clauses.start, 
+             qe = qbcp_qbce_get_state (qdpll, c)->qbcp_qbce_notify_maybe_blocked_clauses.top; qp < qe; qp++)
         {
           QBCENonBlockedWitness maybe_blocked_pair = *qp;
           Constraint *maybe_blocked_clause = 
@@ -11891,7 +12029,7 @@ qbcp_qbce_push_maybe_blocked_clauses_by_assignment (QDPLL *qdpll, Var *assigned_
           else
             {
               if (QDPLL_VAR_ASSIGNED 
-                  (LIT2VARPTR (qdpll->pcnf.vars, 
+                  (qdpll->pcnf, LIT2VARPTR (qdpll->pcnf.vars, 
                                maybe_blocked_pair.non_blocking_lit)) || 
                   maybe_blocked_clause->qbcp_qbce_blocked)
                 continue;
@@ -11902,14 +12040,14 @@ qbcp_qbce_push_maybe_blocked_clauses_by_assignment (QDPLL *qdpll, Var *assigned_
             {
               fprintf (stderr, "  pushing potential blocking literal %d and clause:", 
                        maybe_blocked_pair.non_blocking_lit);
-              print_constraint (qdpll, maybe_blocked_pair.blit_occ.constraint);
+              print_constraint (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, maybe_blocked_pair.blit_occ));
             }
           /* Set offset-on-working-queue of pair to be enqueued. */
           assert (qp->offset_in_working_queue == QDPLL_INVALID_WATCHER_POS);
           assert (maybe_blocked_pair.offset_in_working_queue == QDPLL_INVALID_WATCHER_POS);
           qp->offset_in_working_queue = maybe_blocked_pair.offset_in_working_queue = 
             QDPLL_COUNT_STACK (qdpll->qbcp_qbce_maybe_blocked_clauses);
-          QDPLL_PUSH_STACK(qdpll->mm, qdpll->qbcp_qbce_maybe_blocked_clauses, 
+          QDPLL_PUSH_STACK(QBCE_MM (qdpll), qdpll->qbcp_qbce_maybe_blocked_clauses, 
                            maybe_blocked_pair);
         }
     }
@@ -11928,7 +12066,7 @@ assert_qbcp_qbce_check_clause_is_blocked (QDPLL *qdpll, Constraint *blocked_clau
   BLitsOcc *p, *e;
   for (p = occs->start, e = occs->top; p < e; p++)
     {
-      Constraint *occ = p->constraint;
+      Constraint *occ = BLIT_CONSTRAINT (qdpll->pcnf, *p);
       if (occ->qbcp_qbce_blocked || is_clause_satisfied (qdpll, occ))
         continue;
       assert (constraint_has_lit (occ, -blocking_lit));
@@ -12030,8 +12168,8 @@ assert_qbcp_qbce_witness_resolvent_no_taut
   Var *non_blocking_var = LIT2VARPTR (qdpll->pcnf.vars, 
                                       non_blocking_lit);
   assert (!is_clause_satisfied (qdpll, witness) || 
-          ((QDPLL_VAR_ASSIGNED_TRUE (non_blocking_var) && QDPLL_LIT_POS (-non_blocking_lit)) || 
-           (QDPLL_VAR_ASSIGNED_FALSE (non_blocking_var) && QDPLL_LIT_NEG (-non_blocking_lit))));
+          ((QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, non_blocking_var) && QDPLL_LIT_POS (-non_blocking_lit)) || 
+           (QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, non_blocking_var) && QDPLL_LIT_NEG (-non_blocking_lit))));
   LitID *p, *e;
   for (p = c->lits, e = p + c->num_lits; p < e; p++)
     {
@@ -12087,41 +12225,46 @@ assert_qbcp_qbce_non_blocked_witness_integrity (QDPLL *qdpll)
                 {
                   cnt_exists_lits++;
                   assert (qbcp_qbce_find_lit_in_list 
-                          (qdpll, &(c->qbcp_qbce_witness_clauses), lit));
+                          (qdpll, &(c->qbce->qbcp_qbce_witness_clauses), lit));
                 }
             }
-          assert (QDPLL_COUNT_STACK (c->qbcp_qbce_witness_clauses) == 
+          /* Clauses without QBCE state have no witnesses and notify no
+             clauses; do not allocate the state here. */
+          QBCEConstraintState *qs = c->qbce;
+          assert ((qs ? QDPLL_COUNT_STACK (qs->qbcp_qbce_witness_clauses) : 0) == 
                   cnt_exists_lits);
+          if (!qs)
+            continue;
           QBCENonBlockedWitness *p, *e;
           /* Check clauses which are witnesses that this clause 'c' is not
              blocked. */
-          for (p = c->qbcp_qbce_witness_clauses.start, 
-                 e = c->qbcp_qbce_witness_clauses.top; p < e; p++)
+          for (p = qs->qbcp_qbce_witness_clauses.start, 
+                 e = qs->qbcp_qbce_witness_clauses.top; p < e; p++)
             {
               QBCENonBlockedWitness witness_pair = *p;
               assert (witness_pair.offset_in_working_queue == QDPLL_INVALID_WATCHER_POS);
               assert (witness_pair.non_blocking_lit);
-              assert (witness_pair.blit_occ.constraint);
-              assert (!witness_pair.blit_occ.constraint->qbcp_qbce_blocked);
+              assert (BLIT_CONSTRAINT (qdpll->pcnf, witness_pair.blit_occ));
+              assert (!BLIT_CONSTRAINT (qdpll->pcnf, witness_pair.blit_occ)->qbcp_qbce_blocked);
               assert_qbcp_qbce_witness_resolvent_no_taut 
-                (qdpll, c, witness_pair.non_blocking_lit, witness_pair.blit_occ.constraint);
+                (qdpll, c, witness_pair.non_blocking_lit, BLIT_CONSTRAINT (qdpll->pcnf, witness_pair.blit_occ));
 
               Var *non_blocking_var = 
                 LIT2VARPTR (qdpll->pcnf.vars, witness_pair.non_blocking_lit);
-              assert (!QDPLL_VAR_ASSIGNED (non_blocking_var) || 
-                      is_clause_satisfied (qdpll, witness_pair.blit_occ.constraint));
+              assert (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, non_blocking_var) || 
+                      is_clause_satisfied (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, witness_pair.blit_occ)));
               assert (QDPLL_VAR_EXISTS (non_blocking_var));
               /* Witness may be satisfied only if it is satisfied by the
                  blocking literal of the witness. In this case, the blocking
                  literal is falsified in 'c'. The clause 'c' does not need
                  another witness for that literal since it has in fact
                  disappeared from 'c'. */
-              assert (!is_clause_satisfied (qdpll, witness_pair.blit_occ.constraint) || 
-                      (QDPLL_VAR_ASSIGNED_TRUE (non_blocking_var) && 
+              assert (!is_clause_satisfied (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, witness_pair.blit_occ)) || 
+                      (QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, non_blocking_var) && 
                        QDPLL_LIT_POS (-witness_pair.non_blocking_lit)) || 
-                      (QDPLL_VAR_ASSIGNED_FALSE (non_blocking_var) && 
+                      (QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, non_blocking_var) && 
                        QDPLL_LIT_NEG (-witness_pair.non_blocking_lit)));
-              assert (constraint_has_lit (witness_pair.blit_occ.constraint, 
+              assert (constraint_has_lit (BLIT_CONSTRAINT (qdpll->pcnf, witness_pair.blit_occ), 
                                           -witness_pair.non_blocking_lit));
               assert (constraint_has_lit (c, witness_pair.non_blocking_lit));
 
@@ -12132,34 +12275,34 @@ assert_qbcp_qbce_non_blocked_witness_integrity (QDPLL *qdpll)
               for (check_p = p + 1; check_p < e; check_p++)
                 {
                   QBCENonBlockedWitness check_pair = *check_p;
-                  assert (check_pair.blit_occ.constraint != witness_pair.blit_occ.constraint);
+                  assert (BLIT_CONSTRAINT (qdpll->pcnf, check_pair.blit_occ) != BLIT_CONSTRAINT (qdpll->pcnf, witness_pair.blit_occ));
                   assert (check_pair.non_blocking_lit != witness_pair.non_blocking_lit);
                 }
               assert (c->num_lits > 0);
               assert (c->lits[0]);
-              QBCENonBlockedWitness check_pair = {witness_pair.non_blocking_lit, {c->lits[0], c}, 
+              QBCENonBlockedWitness check_pair = {witness_pair.non_blocking_lit, {c->lits[0], c->ref}, 
                                                   {QDPLL_INVALID_WATCHER_POS}, QDPLL_INVALID_WATCHER_POS};
               qbcp_qbce_find_pair_in_list 
-                (qdpll, &(witness_pair.blit_occ.constraint->qbcp_qbce_notify_maybe_blocked_clauses), 
+                (qdpll, &(BLIT_CONSTRAINT (qdpll->pcnf, witness_pair.blit_occ)->qbce->qbcp_qbce_notify_maybe_blocked_clauses), 
                  check_pair, 0, 0);
               /* Check offset stored in 'witness_pair'. */
               assert (witness_pair.offset.maybe_blocked_clause_in_notify_list < 
-                      QDPLL_COUNT_STACK (witness_pair.blit_occ.constraint->qbcp_qbce_notify_maybe_blocked_clauses));
-              assert (witness_pair.blit_occ.constraint->qbcp_qbce_notify_maybe_blocked_clauses.start
-                      [witness_pair.offset.maybe_blocked_clause_in_notify_list].blit_occ.constraint == c);
-              assert (witness_pair.blit_occ.constraint->qbcp_qbce_notify_maybe_blocked_clauses.start
+                      QDPLL_COUNT_STACK (BLIT_CONSTRAINT (qdpll->pcnf, witness_pair.blit_occ)->qbce->qbcp_qbce_notify_maybe_blocked_clauses));
+              assert (BLIT_CONSTRAINT (qdpll->pcnf, BLIT_CONSTRAINT (qdpll->pcnf, witness_pair.blit_occ)->qbce->qbcp_qbce_notify_maybe_blocked_clauses.start
+                      [witness_pair.offset.maybe_blocked_clause_in_notify_list].blit_occ) == c);
+              assert (BLIT_CONSTRAINT (qdpll->pcnf, witness_pair.blit_occ)->qbce->qbcp_qbce_notify_maybe_blocked_clauses.start
                       [witness_pair.offset.maybe_blocked_clause_in_notify_list].offset.witness_in_witness_list == 
-                      (unsigned int)(p - c->qbcp_qbce_witness_clauses.start));
+                      (unsigned int)(p - c->qbce->qbcp_qbce_witness_clauses.start));
             }
           /* Check clauses for which this clause 'c' is a witness. */
-          for (p = c->qbcp_qbce_notify_maybe_blocked_clauses.start, 
-                 e = c->qbcp_qbce_notify_maybe_blocked_clauses.top; p < e; p++)
+          for (p = qs->qbcp_qbce_notify_maybe_blocked_clauses.start, 
+                 e = qs->qbcp_qbce_notify_maybe_blocked_clauses.top; p < e; p++)
             {
               QBCENonBlockedWitness maybe_blocked_pair = *p;
               assert (maybe_blocked_pair.offset_in_working_queue == QDPLL_INVALID_WATCHER_POS);
               assert (maybe_blocked_pair.non_blocking_lit);
-              assert (maybe_blocked_pair.blit_occ.constraint);
-              assert (constraint_has_lit (maybe_blocked_pair.blit_occ.constraint, 
+              assert (BLIT_CONSTRAINT (qdpll->pcnf, maybe_blocked_pair.blit_occ));
+              assert (constraint_has_lit (BLIT_CONSTRAINT (qdpll->pcnf, maybe_blocked_pair.blit_occ), 
                                           maybe_blocked_pair.non_blocking_lit));
               assert (constraint_has_lit (c, -maybe_blocked_pair.non_blocking_lit));
               /* We must not find this entry a second time in this
@@ -12169,23 +12312,23 @@ assert_qbcp_qbce_non_blocked_witness_integrity (QDPLL *qdpll)
               for (check_p = p + 1; check_p < e; check_p++)
                 {
                   QBCENonBlockedWitness check_pair = *check_p;
-                  assert (check_pair.blit_occ.constraint != maybe_blocked_pair.blit_occ.constraint);
+                  assert (BLIT_CONSTRAINT (qdpll->pcnf, check_pair.blit_occ) != BLIT_CONSTRAINT (qdpll->pcnf, maybe_blocked_pair.blit_occ));
                 }
               assert (c->num_lits > 0);
               assert (c->lits[0]);
-              QBCENonBlockedWitness check_pair = {maybe_blocked_pair.non_blocking_lit, {c->lits[0], c}, 
+              QBCENonBlockedWitness check_pair = {maybe_blocked_pair.non_blocking_lit, {c->lits[0], c->ref}, 
                                                   {QDPLL_INVALID_WATCHER_POS}, QDPLL_INVALID_WATCHER_POS};
               assert (qbcp_qbce_find_pair_in_list 
-                (qdpll, &(maybe_blocked_pair.blit_occ.constraint->qbcp_qbce_witness_clauses), 
+                (qdpll, &(BLIT_CONSTRAINT (qdpll->pcnf, maybe_blocked_pair.blit_occ)->qbce->qbcp_qbce_witness_clauses), 
                  check_pair, 0, 0));
               /* Check offset stored in 'maybe_blocked_pair'. */
               assert (maybe_blocked_pair.offset.witness_in_witness_list < 
-                      QDPLL_COUNT_STACK (maybe_blocked_pair.blit_occ.constraint->qbcp_qbce_witness_clauses));
-              assert (maybe_blocked_pair.blit_occ.constraint->qbcp_qbce_witness_clauses.start
-                      [maybe_blocked_pair.offset.witness_in_witness_list].blit_occ.constraint == c);
-              assert (maybe_blocked_pair.blit_occ.constraint->qbcp_qbce_witness_clauses.start
+                      QDPLL_COUNT_STACK (BLIT_CONSTRAINT (qdpll->pcnf, maybe_blocked_pair.blit_occ)->qbce->qbcp_qbce_witness_clauses));
+              assert (BLIT_CONSTRAINT (qdpll->pcnf, BLIT_CONSTRAINT (qdpll->pcnf, maybe_blocked_pair.blit_occ)->qbce->qbcp_qbce_witness_clauses.start
+                      [maybe_blocked_pair.offset.witness_in_witness_list].blit_occ) == c);
+              assert (BLIT_CONSTRAINT (qdpll->pcnf, maybe_blocked_pair.blit_occ)->qbce->qbcp_qbce_witness_clauses.start
                       [maybe_blocked_pair.offset.witness_in_witness_list].offset.maybe_blocked_clause_in_notify_list == 
-                      (unsigned int)(p - c->qbcp_qbce_notify_maybe_blocked_clauses.start));
+                      (unsigned int)(p - c->qbce->qbcp_qbce_notify_maybe_blocked_clauses.start));
             }
         }
     }
@@ -12205,14 +12348,14 @@ qbcp_qbce_prepro_add_blocking_lit_occ (QDPLL *qdpll, Constraint *blocked_clause)
   Var *blocking_var = LIT2VARPTR (qdpll->pcnf.vars, blocking_lit);
   if (QDPLL_LIT_NEG (blocking_lit))
     {
-      QDPLL_PUSH_STACK (qdpll->mm, blocking_var->
+      QDPLL_PUSH_STACK (QBCE_MM (qdpll), blocking_var->
                         qbcp_qbce_prepro_neg_blocking_lit_clauses, 
                         blocked_clause);
     }
   else
     {
       assert (QDPLL_LIT_POS (blocking_lit));
-      QDPLL_PUSH_STACK (qdpll->mm, blocking_var->
+      QDPLL_PUSH_STACK (QBCE_MM (qdpll), blocking_var->
                         qbcp_qbce_prepro_pos_blocking_lit_clauses, 
                         blocked_clause);
     }
@@ -12287,7 +12430,7 @@ qbcp_qbce_find_blocked_clauses (QDPLL *qdpll)
             {
               fprintf (stderr, "De-queued pair with lit %d, wo-value %d and clause: ", 
                        pair.non_blocking_lit, pair.offset.witness_in_witness_list);
-              print_constraint (qdpll, pair.blit_occ.constraint);
+              print_constraint (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, pair.blit_occ));
             }
 #ifndef NDEBUG
           do {
@@ -12299,7 +12442,7 @@ qbcp_qbce_find_blocked_clauses (QDPLL *qdpll)
                  check_p < check_e; check_p++)
               {
                 QBCENonBlockedWitness check_pair = *check_p;
-                assert (check_pair.blit_occ.constraint != pair.blit_occ.constraint || 
+                assert (BLIT_CONSTRAINT (qdpll->pcnf, check_pair.blit_occ) != BLIT_CONSTRAINT (qdpll->pcnf, pair.blit_occ) || 
                         check_pair.non_blocking_lit != pair.non_blocking_lit);
               }
           } while (0);
@@ -12307,11 +12450,11 @@ qbcp_qbce_find_blocked_clauses (QDPLL *qdpll)
           if (pair.offset.witness_in_witness_list != QDPLL_INVALID_WATCHER_POS)
             qbcp_qbce_reset_offset_in_working_queue (qdpll, pair);
           LitID non_blocking_lit = pair.non_blocking_lit;
-          assert (!non_blocking_lit || constraint_has_lit (pair.blit_occ.constraint, 
+          assert (!non_blocking_lit || constraint_has_lit (BLIT_CONSTRAINT (qdpll->pcnf, pair.blit_occ), 
                                                            non_blocking_lit));
           assert (non_blocking_lit || 
                   pair.offset.witness_in_witness_list == QDPLL_INVALID_WATCHER_POS);
-          assert (!pair.blit_occ.blit || constraint_has_lit (pair.blit_occ.constraint, 
+          assert (!pair.blit_occ.blit || constraint_has_lit (BLIT_CONSTRAINT (qdpll->pcnf, pair.blit_occ), 
                                                              pair.blit_occ.blit));
 #if COMPUTE_STATS
           qdpll->stats.qbcp_qbce_clauses_seen++;
@@ -12321,7 +12464,7 @@ qbcp_qbce_find_blocked_clauses (QDPLL *qdpll)
               Var *non_blocking_var = LIT2VARPTR (qdpll->pcnf.vars, non_blocking_lit);
               /* Selector variables must not be used as blocking literals. */
               assert (!non_blocking_var->is_internal);
-              if (QDPLL_VAR_ASSIGNED (non_blocking_var))
+              if (QDPLL_VAR_ASSIGNED (qdpll->pcnf, non_blocking_var))
                 {
                   /* This case may happen in dynamic QBCE when we push a
                      clause to be checked but later assign a variable
@@ -12330,7 +12473,7 @@ qbcp_qbce_find_blocked_clauses (QDPLL *qdpll)
                     {
                       fprintf (stderr, "Skipping assigned blocking literal %d in clause: ", 
                                non_blocking_lit);
-                      print_constraint (qdpll, pair.blit_occ.constraint);
+                      print_constraint (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, pair.blit_occ));
                     }
                   continue;
                 }
@@ -12341,7 +12484,7 @@ qbcp_qbce_find_blocked_clauses (QDPLL *qdpll)
 #endif
           /* Check if clause is satisfied by cached literal. */
           Constraint *c = pair.blit_occ.blit ? check_disabling_blocking_lit 
-            (qdpll, pair.blit_occ, 0) : pair.blit_occ.constraint;
+            (qdpll, pair.blit_occ, 0) : BLIT_CONSTRAINT (qdpll->pcnf, pair.blit_occ);
           if (!c)
             {
 #if COMPUTE_STATS
@@ -12350,7 +12493,7 @@ qbcp_qbce_find_blocked_clauses (QDPLL *qdpll)
               if (qdpll->options.verbosity >= 3)
                 {
                   fprintf (stderr, "Skipping already satisfied clause: ");
-                  print_constraint (qdpll, pair.blit_occ.constraint);
+                  print_constraint (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, pair.blit_occ));
                   fprintf (stderr, " and potential blocking literal %d\n", non_blocking_lit);
                 }
               continue;
@@ -12387,11 +12530,11 @@ qbcp_qbce_find_blocked_clauses (QDPLL *qdpll)
               LitID clit = *p;
               Var *cvar = LIT2VARPTR (qdpll->pcnf.vars, clit);
               /* Ignore literals currently assigned false. */
-              if ((QDPLL_LIT_NEG (clit) && QDPLL_VAR_ASSIGNED_TRUE (cvar)) || 
-                  (QDPLL_LIT_POS (clit) && QDPLL_VAR_ASSIGNED_FALSE (cvar)))
+              if ((QDPLL_LIT_NEG (clit) && QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, cvar)) || 
+                  (QDPLL_LIT_POS (clit) && QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, cvar)))
                 continue;
-              else if ((QDPLL_LIT_NEG (clit) && QDPLL_VAR_ASSIGNED_FALSE (cvar)) || 
-                       (QDPLL_LIT_POS (clit) && QDPLL_VAR_ASSIGNED_TRUE (cvar)))
+              else if ((QDPLL_LIT_NEG (clit) && QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, cvar)) || 
+                       (QDPLL_LIT_POS (clit) && QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, cvar)))
                 {
                   /* Found satisfying literal. */
 #if COMPUTE_STATS
@@ -12408,19 +12551,19 @@ qbcp_qbce_find_blocked_clauses (QDPLL *qdpll)
                   unsigned int witness_offset = pair.offset.witness_in_witness_list;
                   if (witness_offset != QDPLL_INVALID_WATCHER_POS)
                     {
-                      assert (witness_offset < QDPLL_COUNT_STACK (c->qbcp_qbce_witness_clauses));
+                      assert (witness_offset < QDPLL_COUNT_STACK (c->qbce->qbcp_qbce_witness_clauses));
                       QBCENonBlockedWitness witness_pair = 
-                        c->qbcp_qbce_witness_clauses.start[witness_offset];
+                        qbcp_qbce_get_state (qdpll, c)->qbcp_qbce_witness_clauses.start[witness_offset];
                       unsigned int maybe_blocked_pair_offset = 
                         witness_pair.offset.maybe_blocked_clause_in_notify_list;
                       assert (maybe_blocked_pair_offset < QDPLL_COUNT_STACK 
-                              (witness_pair.blit_occ.constraint->
+                              (BLIT_CONSTRAINT (qdpll->pcnf, witness_pair.blit_occ)->qbce->
                                qbcp_qbce_notify_maybe_blocked_clauses));
                       QBCENonBlockedWitness *maybe_blocked_pair_p = 
-                        witness_pair.blit_occ.constraint->
+                        qbcp_qbce_get_state (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, witness_pair.blit_occ))->
                         qbcp_qbce_notify_maybe_blocked_clauses.start + 
                         maybe_blocked_pair_offset;
-                      assert (c == maybe_blocked_pair_p->blit_occ.constraint);
+                      assert (c == BLIT_CONSTRAINT (qdpll->pcnf, maybe_blocked_pair_p->blit_occ));
                       assert (non_blocking_lit == maybe_blocked_pair_p->non_blocking_lit);
                       maybe_blocked_pair_p->blit_occ.blit = pair.blit_occ.blit;
                     }
@@ -12442,8 +12585,8 @@ qbcp_qbce_find_blocked_clauses (QDPLL *qdpll)
                 {
                   LitID clit = *p;
                   Var *cvar = LIT2VARPTR (qdpll->pcnf.vars, clit);
-                  if ((QDPLL_LIT_NEG (clit) && QDPLL_VAR_ASSIGNED_TRUE (cvar)) || 
-                      (QDPLL_LIT_POS (clit) && QDPLL_VAR_ASSIGNED_FALSE (cvar)))
+                  if ((QDPLL_LIT_NEG (clit) && QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, cvar)) || 
+                      (QDPLL_LIT_POS (clit) && QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, cvar)))
                     {
                       assert (!QDPLL_VAR_MARKED (cvar));
                       continue;
@@ -12483,10 +12626,10 @@ qbcp_qbce_find_blocked_clauses (QDPLL *qdpll)
                   LitID lit = *p;
                   Var *var = LIT2VARPTR (qdpll->pcnf.vars, lit);
                   /* Pushed clauses must not be satisfied. */
-                  assert (!QDPLL_VAR_ASSIGNED (var) || 
-                          (QDPLL_VAR_ASSIGNED_TRUE (var) && QDPLL_LIT_NEG (lit)) || 
-                          (QDPLL_VAR_ASSIGNED_FALSE (var) && QDPLL_LIT_POS (lit)));
-                  if (QDPLL_VAR_ASSIGNED (var))
+                  assert (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, var) || 
+                          (QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var) && QDPLL_LIT_NEG (lit)) || 
+                          (QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var) && QDPLL_LIT_POS (lit)));
+                  if (QDPLL_VAR_ASSIGNED (qdpll->pcnf, var))
                     continue;
                   if (QDPLL_SCOPE_EXISTS (var->scope) && !var->is_internal)
                     {
@@ -12540,12 +12683,12 @@ qbcp_qbce_find_blocked_clauses (QDPLL *qdpll)
                               continue;
                             }
                         }
-                      QDPLL_PUSH_STACK (qdpll->mm, maybe_blocking_literals, lit);
+                      QDPLL_PUSH_STACK (QBCE_MM (qdpll), maybe_blocking_literals, lit);
                     }
                 }
             }
           else
-            QDPLL_PUSH_STACK (qdpll->mm, maybe_blocking_literals, non_blocking_lit);
+            QDPLL_PUSH_STACK (QBCE_MM (qdpll), maybe_blocking_literals, non_blocking_lit);
           assert (!non_blocking_lit || QDPLL_COUNT_STACK (maybe_blocking_literals) == 1);
 
           /* Check all potentially blocking literals in the current clause 'c'. */
@@ -12560,7 +12703,7 @@ qbcp_qbce_find_blocked_clauses (QDPLL *qdpll)
               assert (QDPLL_SCOPE_EXISTS (var->scope));
               /* Selector variables must not be used as blocking literals. */
               assert (!var->is_internal);
-              assert (!QDPLL_VAR_ASSIGNED (var));
+              assert (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, var));
 
               if (qdpll->options.verbosity >= 3)
                 fprintf (stderr, "  checking potential blocking literal %d\n", lit);
@@ -12595,17 +12738,17 @@ qbcp_qbce_find_blocked_clauses (QDPLL *qdpll)
                         {
                           LitID lit = *lp;
                           Var *var = LIT2VARPTR (qdpll->pcnf.vars, lit);
-                          if (QDPLL_VAR_FORALL (var) && !QDPLL_VAR_ASSIGNED (var))
+                          if (QDPLL_VAR_FORALL (var) && !QDPLL_VAR_ASSIGNED (qdpll->pcnf, var))
                             {
                               /* Check if universal variable must update it's clause watcher. */
                               if (!LEARN_VAR_POS_MARKED (var) && 
-                                  ((QDPLL_LIT_NEG (lit) && c == var->neg_occ_clauses.start[0].constraint) || 
-                                   (QDPLL_LIT_POS (lit) && c == var->pos_occ_clauses.start[0].constraint)))
+                                  ((QDPLL_LIT_NEG (lit) && c == BLIT_CONSTRAINT (qdpll->pcnf, var->neg_occ_clauses.start[0])) || 
+                                   (QDPLL_LIT_POS (lit) && c == BLIT_CONSTRAINT (qdpll->pcnf, var->pos_occ_clauses.start[0]))))
                                 {
                                   /* Mark and collect variable. */
                                   assert (!LEARN_VAR_NEG_MARKED (var));
                                   LEARN_VAR_POS_MARK (var);
-                                  QDPLL_PUSH_STACK (qdpll->mm, maybe_pure_literals, lit);
+                                  QDPLL_PUSH_STACK (QBCE_MM (qdpll), maybe_pure_literals, lit);
                                   if (qdpll->options.verbosity >= 3)
                                     fprintf (stderr, "...univ var %d needs watcher update\n", var->id);
                                 }
@@ -12617,14 +12760,14 @@ qbcp_qbce_find_blocked_clauses (QDPLL *qdpll)
                       /* If the blocked clause is currently watched for empty
                          formula detection, then we must schedule a watcher
                          update. */
-                      if (qdpll->empty_formula_watcher && c == qdpll->empty_formula_watcher->constraint)
+                      if (qdpll->empty_formula_watcher && c == BLIT_CONSTRAINT (qdpll->pcnf, *(qdpll->empty_formula_watcher)))
                         qdpll->state.empty_formula_watcher_scheduled_update = 1;
                     }
                   /* Push blocked clause on local and global stack of blocked
                      clauses. The global stack
                      'qdpll->qbcp_qbce_blocked_clauses' is needed for solution
                      reconstruction. */
-                  QDPLL_PUSH_STACK(qdpll->mm, blocked_clauses, c);
+                  QDPLL_PUSH_STACK(QBCE_MM (qdpll), blocked_clauses, c);
                   assert (!qdpll->state.qbcp_qbce_currently_preprocessing || 
                           qdpll->state.decision_level == 0);
                   assert (!qdpll->state.qbcp_qbce_currently_preprocessing || 
@@ -12633,7 +12776,7 @@ qbcp_qbce_find_blocked_clauses (QDPLL *qdpll)
                           QDPLL_COUNT_STACK (qdpll->qbcp_qbce_blocked_clauses) == 
                           qdpll->state.decision_level + 2);
                   QDPLL_PUSH_STACK 
-                    (qdpll->mm, qdpll->qbcp_qbce_blocked_clauses.start
+                    (QBCE_MM (qdpll), qdpll->qbcp_qbce_blocked_clauses.start
                      [qdpll->state.qbcp_qbce_currently_preprocessing ? 
                       0 : qdpll->state.decision_level + 1], c);
                   if (qdpll->options.verbosity >= 3)
@@ -12656,15 +12799,15 @@ qbcp_qbce_find_blocked_clauses (QDPLL *qdpll)
                     }
                   assert (!witness->qbcp_qbce_blocked);
                   assert (!is_clause_satisfied (qdpll, witness));
-                  assert (c == pair.blit_occ.constraint);
+                  assert (c == BLIT_CONSTRAINT (qdpll->pcnf, pair.blit_occ));
                   assert (!non_blocking_lit || 
                           (lit == pair.non_blocking_lit && 
                            non_blocking_lit == pair.non_blocking_lit));
                   assert (c->num_lits > 0);
                   assert (c->lits[0]);
-                  assert (!pair.blit_occ.blit || constraint_has_lit (pair.blit_occ.constraint, 
+                  assert (!pair.blit_occ.blit || constraint_has_lit (BLIT_CONSTRAINT (qdpll->pcnf, pair.blit_occ), 
                                                                      pair.blit_occ.blit));
-                  QBCENonBlockedWitness non_blocked_pair = {lit, {pair.blit_occ.blit, c}, 
+                  QBCENonBlockedWitness non_blocked_pair = {lit, {pair.blit_occ.blit, c->ref}, 
                                                             {pair.offset.witness_in_witness_list}, 
                                                             QDPLL_INVALID_WATCHER_POS};
                   /* Store clause 'c' and non-blocking literal 'lit' in
@@ -12685,7 +12828,7 @@ qbcp_qbce_find_blocked_clauses (QDPLL *qdpll)
               Var *cvar = LIT2VARPTR (qdpll->pcnf.vars, clit);
               /* Ignore assigned variables. These assignment can never satisfy
                  the clause, because satisfied clauses are ignored. */
-              if (QDPLL_VAR_ASSIGNED (cvar))
+              if (QDPLL_VAR_ASSIGNED (qdpll->pcnf, cvar))
                 continue;
               assert (QDPLL_VAR_MARKED(cvar));
               QDPLL_VAR_UNMARK (cvar);
@@ -12711,13 +12854,13 @@ qbcp_qbce_find_blocked_clauses (QDPLL *qdpll)
               fprintf (stderr, "  blocked clause: ");
               print_constraint (qdpll, c);
               fprintf (stderr, "    notifies notifies %d pairs to be checked again.\n", 
-                       (unsigned int) QDPLL_COUNT_STACK(c->qbcp_qbce_notify_maybe_blocked_clauses));
+                       (unsigned int) QDPLL_COUNT_STACK(qbcp_qbce_get_state (qdpll, c)->qbcp_qbce_notify_maybe_blocked_clauses));
             }
           /* Push all clauses in the notify-lists of blocked clauses on
              'maybe_blocked_clauses'. */
           QBCENonBlockedWitness *qp, *qe;
-          for (qp = c->qbcp_qbce_notify_maybe_blocked_clauses.start, 
-                 qe = c->qbcp_qbce_notify_maybe_blocked_clauses.top; qp < qe; qp++)
+          for (qp = qbcp_qbce_get_state (qdpll, c)->qbcp_qbce_notify_maybe_blocked_clauses.start, 
+                 qe = qbcp_qbce_get_state (qdpll, c)->qbcp_qbce_notify_maybe_blocked_clauses.top; qp < qe; qp++)
             {
               assert (qp->offset_in_working_queue == QDPLL_INVALID_WATCHER_POS);
 #if COMPUTE_STATS
@@ -12731,13 +12874,13 @@ qbcp_qbce_find_blocked_clauses (QDPLL *qdpll)
                 continue;
               else
                 {
-                  if (pair.blit_occ.constraint->qbcp_qbce_blocked)
+                  if (BLIT_CONSTRAINT (qdpll->pcnf, pair.blit_occ)->qbcp_qbce_blocked)
                     {
                       if (qdpll->options.verbosity >= 3)
                         {
                           fprintf (stderr, "      skipping %s notified clause: ", 
-                                   pair.blit_occ.constraint->qbcp_qbce_blocked ? "blocked" : "satisfied");
-                          print_constraint (qdpll, pair.blit_occ.constraint);
+                                   BLIT_CONSTRAINT (qdpll->pcnf, pair.blit_occ)->qbcp_qbce_blocked ? "blocked" : "satisfied");
+                          print_constraint (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, pair.blit_occ));
                         }
                       continue;
                     }
@@ -12746,14 +12889,14 @@ qbcp_qbce_find_blocked_clauses (QDPLL *qdpll)
                 {
                   fprintf (stderr, "      notifying for potential blocking literal %d to be checked in clause: ", 
                            pair.non_blocking_lit);
-                  print_constraint (qdpll, pair.blit_occ.constraint);
+                  print_constraint (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, pair.blit_occ));
                 }
               /* Set offset-on-working-queue of pair to be enqueued. */
               assert (pair.offset_in_working_queue == QDPLL_INVALID_WATCHER_POS);
               qp->offset_in_working_queue = pair.offset_in_working_queue = 
                 QDPLL_COUNT_STACK (qdpll->qbcp_qbce_maybe_blocked_clauses);
               QDPLL_PUSH_STACK
-                (qdpll->mm, qdpll->qbcp_qbce_maybe_blocked_clauses, pair);
+                (QBCE_MM (qdpll), qdpll->qbcp_qbce_maybe_blocked_clauses, pair);
             }
         }
     } while (!QDPLL_EMPTY_STACK (blocked_clauses));
@@ -12769,16 +12912,16 @@ qbcp_qbce_find_blocked_clauses (QDPLL *qdpll)
       assert (LEARN_VAR_POS_MARKED (var));
       assert (!LEARN_VAR_NEG_MARKED (var));
       LEARN_VAR_POS_UNMARK (var);
-      if (!QDPLL_VAR_ASSIGNED (var))
+      if (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, var))
         notify_clause_watching_variables_aux (qdpll, lit, var);
     }
 
   if (qdpll->options.verbosity >= 2)
     fprintf (stderr, "End of QBCE call, returns value %d\n", found_new_blocked_clauses);
 
-  QDPLL_DELETE_STACK (qdpll->mm, blocked_clauses);
-  QDPLL_DELETE_STACK (qdpll->mm, maybe_blocking_literals);
-  QDPLL_DELETE_STACK (qdpll->mm, maybe_pure_literals);
+  QDPLL_DELETE_STACK (QBCE_MM (qdpll), blocked_clauses);
+  QDPLL_DELETE_STACK (QBCE_MM (qdpll), maybe_blocking_literals);
+  QDPLL_DELETE_STACK (QBCE_MM (qdpll), maybe_pure_literals);
 
 #ifndef NDEBUG
   assert_qbcp_qbce_non_blocked_witness_integrity (qdpll);
@@ -12840,20 +12983,20 @@ bcp (QDPLL * qdpll)
 
 #if COMPUTE_STATS
           qdpll->stats.propagations++;
-          qdpll->stats.total_prop_dlevels += var->decision_level;
+          qdpll->stats.total_prop_dlevels += QDPLL_VAR_LEVEL (qdpll->pcnf, var);
 #endif
           assert (var->mode != QDPLL_VARMODE_UNDEF);
-          assert (QDPLL_VAR_ASSIGNED (var));
-          assert (var->decision_level != QDPLL_INVALID_DECISION_LEVEL);
+          assert (QDPLL_VAR_ASSIGNED (qdpll->pcnf, var));
+          assert (QDPLL_VAR_LEVEL (qdpll->pcnf, var) != QDPLL_INVALID_DECISION_LEVEL);
           assert (!QDPLL_VAR_MARKED_PROPAGATED (var));
 
-          if (QDPLL_VAR_ASSIGNED_TRUE (var))
+          if (QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var))
             state = propagate_variable_assigned 
               (qdpll, var, &(var->pos_notify_clause_watchers), 
                &(var->pos_notify_lit_watchers));
           else
             {
-              assert (QDPLL_VAR_ASSIGNED_FALSE (var));
+              assert (QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var));
               state = propagate_variable_assigned 
                 (qdpll, var, &(var->neg_notify_clause_watchers), 
                  &(var->neg_notify_lit_watchers));
@@ -12976,7 +13119,7 @@ push_forced_assignment (QDPLL * qdpll)
           lit = *p;
           var = LIT2VARPTR (vars, lit);
 
-          if (QDPLL_SCOPE_EXISTS (var->scope) && !QDPLL_VAR_ASSIGNED (var))
+          if (QDPLL_SCOPE_EXISTS (var->scope) && !QDPLL_VAR_ASSIGNED (qdpll->pcnf, var))
             {
               implied_var = var;
               assert (implied_var == qdpll->state.forced_assignment.var);
@@ -12985,7 +13128,7 @@ push_forced_assignment (QDPLL * qdpll)
                   lit = *p;
                   var = LIT2VARPTR (vars, lit);
                   assert (!QDPLL_SCOPE_EXISTS (var->scope)
-                          || QDPLL_VAR_ASSIGNED (var));
+                          || QDPLL_VAR_ASSIGNED (qdpll->pcnf, var));
                 }
               break;
             }
@@ -13012,11 +13155,11 @@ cleanup_constraint_sweep_occs (QDPLL * qdpll, BLitsOccStack * occs)
   BLitsOcc *p, *e;
   for (p = occs->start, e = occs->top; p < e; p++)
     {
-      assert (BLIT_STRIP_PTR (p->constraint)->is_cube ||
-              !BLIT_MARKED_PTR (p->constraint));
-      assert (!BLIT_STRIP_PTR (p->constraint)->is_cube ||
-              BLIT_MARKED_PTR (p->constraint));
-      if (BLIT_STRIP_PTR (p->constraint)->deleted)
+      assert (BLIT_CONSTRAINT (qdpll->pcnf, *p)->is_cube ||
+              !BLIT_MARKED_REF (p->cref));
+      assert (!BLIT_CONSTRAINT (qdpll->pcnf, *p)->is_cube ||
+              BLIT_MARKED_REF (p->cref));
+      if (BLIT_CONSTRAINT (qdpll->pcnf, *p)->deleted)
         {
           /* Overwrite with last element. */
           *p = QDPLL_POP_STACK (*occs);
@@ -13109,12 +13252,167 @@ cleanup_constraint_sweep (QDPLL * qdpll, unsigned int del,
 }
 
 
+/* Rewrite references in 'occs' to constraints which are moved by
+   'compact_learnt_constraints'. */
+static void
+remap_compacted_refs (QDPLL * qdpll, BLitsOccStack * occs,
+                      size_t * moved_from, size_t * moved_to)
+{
+  BLitsOcc *p, *e;
+  for (p = occs->start, e = occs->top; p < e; p++)
+    {
+      const int is_cube = BLIT_MARKED_REF (p->cref);
+      if (BLIT_REF_OFFSET (p->cref) - moved_from[is_cube] <
+          moved_to[is_cube] - moved_from[is_cube])
+        {
+          p->cref = BLIT_CONSTRAINT (qdpll->pcnf, *p)->ref;
+          assert (p->cref != QDPLL_INVALID_CONSTRAINT_REF);
+        }
+    }
+}
+
+
+/* Compact the arenas of learned clauses and cubes in place: constraints
+   slide towards the start of their arena over the space of deleted
+   constraints, which keeps them in the order they were learned, and the
+   arena is shrunk to the occupied bytes. A moved constraint gets a new
+   reference. New references are assigned in a first pass and stored in
+   the headers at the old places, where old references in occurrence and
+   watcher stacks and raw pointers are mapped to them before any
+   constraint is moved. */
+static void
+compact_learnt_constraints (QDPLL * qdpll)
+{
+  QDPLLPCNF *pcnf = &(qdpll->pcnf);
+  char *const base = pcnf->constraint_base;
+  /* Range of offsets of constraints which are moved, per arena. */
+  size_t moved_from[2], moved_to[2], new_end[2];
+  int is_cube, moved = 0;
+  Constraint *c, *next;
+  char *p, *end;
+  size_t bytes;
+
+  for (is_cube = 0; is_cube < 2; is_cube++)
+    {
+      QDPLLMemMan *mm =
+        qdpll_mem_view (qdpll->mm, LEARNT_MEM_CATEGORY (is_cube));
+      p = qdpll_arena_start (mm, is_cube);
+      end = p + qdpll_arena_used (mm, is_cube);
+      /* Constraints before the first deleted one stay in place. */
+      for (; p < end; p += bytes)
+        {
+          c = (Constraint *) p;
+          if (c->ref == QDPLL_INVALID_CONSTRAINT_REF)
+            break;
+          bytes = LEARNT_ARENA_ALIGN (CONSTRAINT_BYTES (c->size_lits));
+        }
+      moved_from[is_cube] = p - base;
+      moved_to[is_cube] = end - base;
+      size_t to = moved_from[is_cube];
+      for (; p < end; p += bytes)
+        {
+          c = (Constraint *) p;
+          bytes = LEARNT_ARENA_ALIGN (CONSTRAINT_BYTES (c->size_lits));
+          if (c->ref != QDPLL_INVALID_CONSTRAINT_REF)
+            {
+              assert (c->in_learnt_arena && c->is_cube == is_cube);
+              c->ref = BLIT_REF_OF_OFFSET (to, is_cube);
+              to += bytes;
+            }
+        }
+      new_end[is_cube] = to;
+      if (to != moved_to[is_cube])
+        moved = 1;
+    }
+  if (!moved)
+    return;
+
+  Var *v, *ve;
+  const int learnt_in_occs = qdpll->options.no_spure_literals &&
+    !qdpll->options.no_pure_literals;
+  for (v = pcnf->vars, ve = v + pcnf->size_vars; v < ve; v++)
+    {
+      if (!v->id)
+        continue;
+      remap_compacted_refs (qdpll, &(v->pos_notify_lit_watchers),
+                            moved_from, moved_to);
+      remap_compacted_refs (qdpll, &(v->neg_notify_lit_watchers),
+                            moved_from, moved_to);
+      /* See 'setup_occ_lists'. */
+      if (learnt_in_occs)
+        {
+          remap_compacted_refs (qdpll, &(v->pos_occ_clauses),
+                                moved_from, moved_to);
+          remap_compacted_refs (qdpll, &(v->neg_occ_clauses),
+                                moved_from, moved_to);
+          remap_compacted_refs (qdpll, &(v->pos_occ_cubes),
+                                moved_from, moved_to);
+          remap_compacted_refs (qdpll, &(v->neg_occ_cubes),
+                                moved_from, moved_to);
+        }
+    }
+
+#define REMAP_CONSTRAINT_PTR(ptr)                                         \
+  do {                                                                    \
+    if ((ptr) && (ptr)->in_learnt_arena)                                  \
+      {                                                                   \
+        assert ((ptr)->ref != QDPLL_INVALID_CONSTRAINT_REF);              \
+        (ptr) = BLIT_REF2CONSTRAINT (*pcnf, (ptr)->ref);                  \
+      }                                                                   \
+  } while (0)
+  ConstraintList *lists[2] = { &(pcnf->learnt_clauses), &(pcnf->learnt_cubes) };
+  for (is_cube = 0; is_cube < 2; is_cube++)
+    {
+      for (c = lists[is_cube]->first; c; c = next)
+        {
+          next = c->link.next;
+          REMAP_CONSTRAINT_PTR (c->link.prev);
+          REMAP_CONSTRAINT_PTR (c->link.next);
+        }
+      REMAP_CONSTRAINT_PTR (lists[is_cube]->first);
+      REMAP_CONSTRAINT_PTR (lists[is_cube]->last);
+    }
+  REMAP_CONSTRAINT_PTR (qdpll->result_constraint);
+  REMAP_CONSTRAINT_PTR (qdpll->assumption_lits_constraint);
+  REMAP_CONSTRAINT_PTR (qdpll->state.forced_assignment.antecedent);
+  for (v = pcnf->vars, ve = v + pcnf->size_vars; v < ve; v++)
+    {
+      REMAP_CONSTRAINT_PTR (v->antecedent);
+      REMAP_CONSTRAINT_PTR (v->qpup_constraint);
+    }
+#undef REMAP_CONSTRAINT_PTR
+
+  /* Slide constraints in ascending order, such that a constraint is never
+     overwritten before it has been moved. */
+  for (is_cube = 0; is_cube < 2; is_cube++)
+    {
+      QDPLLMemMan *mm =
+        qdpll_mem_view (qdpll->mm, LEARNT_MEM_CATEGORY (is_cube));
+      char *start = qdpll_arena_start (mm, is_cube);
+      for (p = base + moved_from[is_cube], end = base + moved_to[is_cube];
+           p < end; p += bytes)
+        {
+          c = (Constraint *) p;
+          bytes = LEARNT_ARENA_ALIGN (CONSTRAINT_BYTES (c->size_lits));
+          if (c->ref != QDPLL_INVALID_CONSTRAINT_REF)
+            {
+              Constraint *to = BLIT_REF2CONSTRAINT (*pcnf, c->ref);
+              if (to != c)
+                memmove (to, c, CONSTRAINT_BYTES (c->size_lits));
+            }
+        }
+      qdpll_arena_shrink (mm, is_cube, base + new_end[is_cube] - start);
+    }
+}
+
+
 static unsigned int
 check_resize_learnt_constraints_aux (QDPLL * qdpll, ConstraintList *constraints, 
                                      unsigned int try_delete, const QDPLLQuantifierType type)
 {
   /* Parameter 'try_delete == UINT_MAX' if this function is called to discard
-     all learned cubes in incremental solving. */
+     all learned cubes in incremental solving or to discard all learned
+     constraints under memory pressure. */
   unsigned int del = 0;
   Constraint *c;
   assert (del < try_delete);
@@ -13214,6 +13512,9 @@ check_resize_learnt_constraints (QDPLL * qdpll, const QDPLLQuantifierType type)
 
   unsigned int del = 
     check_resize_learnt_constraints_aux (qdpll, constraints, try_delete, type);
+  compact_learnt_constraints (qdpll);
+  /* Give back slab chunks which became empty by deleting constraints. */
+  qdpll_slab_release (qdpll->mm);
 
 #if COMPUTE_STATS
   qdpll->stats.total_constraint_dels += del;
@@ -13277,6 +13578,98 @@ check_resize_learnt_constraints (QDPLL * qdpll, const QDPLLQuantifierType type)
 }
 
 
+/* Release spare capacity of variable stacks and QBCE witness lists. Outer
+   stacks of stacks keep popped inner stacks beyond 'top' and are left. */
+static void
+shrink_stacks (QDPLL * qdpll)
+{
+  QDPLLMemMan *mm = qdpll->mm;
+  QDPLLMemMan *qbce_mm = QBCE_MM (qdpll);
+  Var *p, *e;
+  for (p = qdpll->pcnf.vars, e = p + qdpll->pcnf.size_vars; p < e; p++)
+    {
+      if (!p->id)
+        continue;
+      QDPLL_SHRINK_STACK (mm, p->pos_notify_clause_watchers);
+      QDPLL_SHRINK_STACK (mm, p->neg_notify_clause_watchers);
+      QDPLL_SHRINK_STACK (mm, p->pos_offset_in_notify_list);
+      QDPLL_SHRINK_STACK (mm, p->neg_offset_in_notify_list);
+      QDPLL_SHRINK_STACK (mm, p->pos_offset_in_watched_clause);
+      QDPLL_SHRINK_STACK (mm, p->neg_offset_in_watched_clause);
+      QDPLL_SHRINK_STACK (mm, p->pos_notify_lit_watchers);
+      QDPLL_SHRINK_STACK (mm, p->neg_notify_lit_watchers);
+      QDPLL_SHRINK_STACK (mm, p->neg_occ_clauses);
+      QDPLL_SHRINK_STACK (mm, p->pos_occ_clauses);
+      QDPLL_SHRINK_STACK (mm, p->neg_occ_cubes);
+      QDPLL_SHRINK_STACK (mm, p->pos_occ_cubes);
+      QDPLL_SHRINK_STACK (qbce_mm, p->qbcp_qbce_watched_neg_occ_clauses);
+      QDPLL_SHRINK_STACK (qbce_mm, p->qbcp_qbce_watched_pos_occ_clauses);
+      QDPLL_SHRINK_STACK (qbce_mm, p->qbcp_qbce_offset_of_neg_lit_in_watched_occ);
+      QDPLL_SHRINK_STACK (qbce_mm, p->qbcp_qbce_offset_of_pos_lit_in_watched_occ);
+    }
+
+  Constraint *c;
+  for (c = qdpll->pcnf.clauses.first; c; c = c->link.next)
+    {
+      QBCEConstraintState *qbce = c->qbce;
+      if (!qbce)
+        continue;
+      QDPLL_SHRINK_STACK (qbce_mm, qbce->qbcp_qbce_notify_maybe_blocked_clauses);
+      QDPLL_SHRINK_STACK (qbce_mm, qbce->qbcp_qbce_witness_clauses);
+      QDPLL_SHRINK_STACK (qbce_mm, qbce->qbcp_qbce_offset_of_witness_in_watched_occs);
+    }
+}
+
+
+/* Called by the memory manager if allocations exceed the pressure
+   threshold of the memory limit. Must not allocate, hence only flags the
+   pressure to be handled at the next safe point in the solving loop. */
+static void
+mem_pressure_cb (void *state)
+{
+  QDPLL *qdpll = (QDPLL *) state;
+  qdpll->state.mem_pressure = 1;
+}
+
+
+/* Emergency reduction under memory pressure: discard all learned
+   constraints which are not in use, stop growing the learned constraint
+   sets and release spare capacity of stacks. Returns zero if memory usage
+   is still above the pressure threshold afterwards. */
+static int
+relieve_mem_pressure (QDPLL * qdpll)
+{
+  assert (qdpll->state.mem_pressure);
+  qdpll->state.mem_pressure = 0;
+  const size_t before = qdpll_cur_allocated (qdpll->mm);
+
+  unsigned int del =
+    check_resize_learnt_constraints_aux (qdpll, &(qdpll->pcnf.learnt_clauses),
+                                         UINT_MAX, QDPLL_QTYPE_EXISTS);
+  del += check_resize_learnt_constraints_aux (qdpll, &(qdpll->pcnf.learnt_cubes),
+                                              UINT_MAX, QDPLL_QTYPE_FORALL);
+  compact_learnt_constraints (qdpll);
+  shrink_stacks (qdpll);
+  qdpll_slab_release (qdpll->mm);
+  /* Like hitting the soft limit: learned constraint sets do not grow any
+     more, reductions happen as soon as they are full. */
+  qdpll->state.exceeded_soft_max_space = 1;
+
+#if COMPUTE_STATS
+  qdpll->stats.total_constraint_dels += del;
+#endif
+
+  if (qdpll->options.verbosity > 0)
+    fprintf (stderr, "Memory pressure: del. %u constraints, "
+             "alloc. %f MB -> %f MB (limit = %lu MB)\n", del,
+             before / 1024 / (float) 1024,
+             qdpll_cur_allocated (qdpll->mm) / 1024 / (float) 1024,
+             (unsigned long) qdpll_get_mem_limit (qdpll->mm));
+
+  return !qdpll_mem_under_pressure (qdpll->mm);
+}
+
+
 static void
 print_config (QDPLL * qdpll)
 {
@@ -13337,6 +13730,8 @@ print_config (QDPLL * qdpll)
     fprintf (stderr, "--dep-man=simple\n");
   if (qdpll->options.depman_qdag)
     fprintf (stderr, "--dep-man=qdag\n");
+  if (qdpll->options.depman_rrs)
+    fprintf (stderr, "--dep-man=rrs\n");
   fprintf (stderr, "--max-dec=%d\n", qdpll->options.max_dec);
   fprintf (stderr, "--max-secs=%d\n", qdpll->options.max_secs);
   fprintf (stderr, "--max-btracks=%d\n", qdpll->options.max_btracks);
@@ -13487,10 +13882,10 @@ get_highest_univ_dec_level (QDPLL * qdpll)
         break;
     }
   /* Must handle pure existential formula. */
-  if (!var || var->decision_level == 0)
+  if (!var || QDPLL_VAR_LEVEL (qdpll->pcnf, var) == 0)
     return 1;
   else
-    return var->decision_level;
+    return QDPLL_VAR_LEVEL (qdpll->pcnf, var);
 }
 
 
@@ -13590,7 +13985,7 @@ setup_occ_lists_aux (QDPLL * qdpll, Constraint * c)
     {
       LitID lit = *p;
       Var *var = LIT2VARPTR (vars, lit);
-      BLitsOcc blit = { lit, c };
+      BLitsOcc blit = { lit, c->ref };
       if (!is_cube)
         {
           if (QDPLL_LIT_NEG (lit))
@@ -13600,7 +13995,6 @@ setup_occ_lists_aux (QDPLL * qdpll, Constraint * c)
         }
       else
         {
-          blit.constraint = BLIT_MARK_PTR (blit.constraint);
           if (QDPLL_LIT_NEG (lit))
             QDPLL_PUSH_STACK (mm, var->neg_occ_cubes, blit);
           else
@@ -13827,7 +14221,8 @@ check_and_import_cover_sets (QDPLL *qdpll)
             }
 
           /* Keep copy of cover set in list for upcoming. */
-          Constraint *cover_set_copy = create_constraint (qdpll, c->num_lits, 1);
+          Constraint *cover_set_copy = create_constraint (qdpll, c->num_lits, 1,
+                                                               QDPLL_MEM_LEARNT_CUBES);
           memcpy (cover_set_copy->lits, c->lits, c->num_lits * sizeof (LitID));
           assert (cover_set_copy->is_cube);
           cover_set_copy->learnt = 1;
@@ -13878,6 +14273,8 @@ discard_all_learned_cubes (QDPLL *qdpll)
   /* Discard all learned cubes. */
   check_resize_learnt_constraints_aux (qdpll, &qdpll->pcnf.learnt_cubes, 
                                        UINT_MAX, QDPLL_QTYPE_FORALL);
+  compact_learnt_constraints (qdpll);
+  qdpll_slab_release (qdpll->mm);
 }
 
 
@@ -14196,7 +14593,7 @@ cleanup_popped_off_vars (QDPLL *qdpll)
         {
           assert (c->num_lits > 0);
           assert (c->lits[0]);
-          BLitsOcc occ = {c->lits[0], c};
+          BLitsOcc occ = {c->lits[0], c->ref};
           QDPLL_PUSH_STACK (qdpll->mm, qdpll->empty_formula_watching_blit_occs, occ);
         }
       assert (qdpll->pcnf.clauses.cnt == 
@@ -14284,7 +14681,7 @@ assign_user_given_assumptions (QDPLL *qdpll)
     {
       LitID assumption = *p;
       Var *var = LIT2VARPTR(qdpll->pcnf.vars, assumption);
-      QDPLL_ABORT_QDPLL(QDPLL_VAR_ASSIGNED(var), "must not assume variable multiple times!");
+      QDPLL_ABORT_QDPLL(QDPLL_VAR_ASSIGNED (qdpll->pcnf, var), "must not assume variable multiple times!");
       /* Assign a variable as assumption only if it does occur in clauses. */
       if (QDPLL_VAR_HAS_OCCS (var))
         assume_aux (qdpll, assumption);
@@ -14308,8 +14705,8 @@ qbcp_qbce_reschedule_for_missing_witnesses (QDPLL *qdpll,
   assert (blocking_lit);
   /* Mark literals which have a witness set for 'blocking_clause'. */
   QBCENonBlockedWitness *wp, *we;
-  for (wp = blocked_clause->qbcp_qbce_witness_clauses.start, 
-         we = blocked_clause->qbcp_qbce_witness_clauses.top; 
+  for (wp = qbcp_qbce_get_state (qdpll, blocked_clause)->qbcp_qbce_witness_clauses.start, 
+         we = qbcp_qbce_get_state (qdpll, blocked_clause)->qbcp_qbce_witness_clauses.top; 
        wp < we; wp++)
     {
       QBCENonBlockedWitness witness_pair = *wp;
@@ -14336,14 +14733,14 @@ qbcp_qbce_reschedule_for_missing_witnesses (QDPLL *qdpll,
             {
               QBCENonBlockedWitness pair = {lit, 
                                             {blocked_clause->num_lits > 0 ? 
-                                             blocked_clause->lits[0] : 0, blocked_clause}, 
+                                             blocked_clause->lits[0] : 0, blocked_clause->ref}, 
                                             {QDPLL_INVALID_WATCHER_POS}, 
                                             QDPLL_COUNT_STACK (qdpll->qbcp_qbce_maybe_blocked_clauses)};
               /* Reschedule pair. Note that we push directly to
                  'qdpll->qbcp_qbce_maybe_blocked_clauses' to avoid pusing pairs
                  containing the same clause on the auxiliary stack used to track
                  depending blocked clauses. */
-              QDPLL_PUSH_STACK(qdpll->mm, qdpll->qbcp_qbce_maybe_blocked_clauses, pair);
+              QDPLL_PUSH_STACK(QBCE_MM (qdpll), qdpll->qbcp_qbce_maybe_blocked_clauses, pair);
               if (qdpll->options.verbosity >= 2)
                 {
                   fprintf (stderr, "  rescheduled blocking lit %d and clause: ", lit);
@@ -14354,24 +14751,24 @@ qbcp_qbce_reschedule_for_missing_witnesses (QDPLL *qdpll,
             {
               /* 'lit' has a witness then reschedule if witness is blocked. */
               QBCENonBlockedWitness *old_witness_pair_p = qbcp_qbce_find_lit_in_list 
-                (qdpll, &(blocked_clause->qbcp_qbce_witness_clauses), lit);
+                (qdpll, &(qbcp_qbce_get_state (qdpll, blocked_clause)->qbcp_qbce_witness_clauses), lit);
               assert (old_witness_pair_p);
               unsigned int witness_offset = old_witness_pair_p - 
-                blocked_clause->qbcp_qbce_witness_clauses.start;
+                qbcp_qbce_get_state (qdpll, blocked_clause)->qbcp_qbce_witness_clauses.start;
               QBCENonBlockedWitness witness_pair = 
-                blocked_clause->qbcp_qbce_witness_clauses.start[witness_offset];
-              if (witness_pair.blit_occ.constraint->qbcp_qbce_blocked)
+                qbcp_qbce_get_state (qdpll, blocked_clause)->qbcp_qbce_witness_clauses.start[witness_offset];
+              if (BLIT_CONSTRAINT (qdpll->pcnf, witness_pair.blit_occ)->qbcp_qbce_blocked)
                 {
                   /* Must set 'offset_in_working_queue' also for entry of clause in notify list. */
-                  witness_pair.blit_occ.constraint->qbcp_qbce_notify_maybe_blocked_clauses.start
+                  qbcp_qbce_get_state (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, witness_pair.blit_occ))->qbcp_qbce_notify_maybe_blocked_clauses.start
                     [witness_pair.offset.maybe_blocked_clause_in_notify_list].offset_in_working_queue = 
                     QDPLL_COUNT_STACK (qdpll->qbcp_qbce_maybe_blocked_clauses);
                   QBCENonBlockedWitness pair = {lit, 
                                                 {blocked_clause->num_lits > 0 ? 
-                                                 blocked_clause->lits[0] : 0, blocked_clause}, 
+                                                 blocked_clause->lits[0] : 0, blocked_clause->ref}, 
                                                 {witness_offset}, 
                                                 QDPLL_COUNT_STACK (qdpll->qbcp_qbce_maybe_blocked_clauses)};
-                  QDPLL_PUSH_STACK(qdpll->mm, qdpll->qbcp_qbce_maybe_blocked_clauses, pair);
+                  QDPLL_PUSH_STACK(QBCE_MM (qdpll), qdpll->qbcp_qbce_maybe_blocked_clauses, pair);
                   if (qdpll->options.verbosity >= 2)
                     {
                       fprintf (stderr, "  blocked witness -- rescheduled blocking lit %d and clause: ", lit);
@@ -14385,8 +14782,8 @@ qbcp_qbce_reschedule_for_missing_witnesses (QDPLL *qdpll,
 
 #ifndef NDEBUG
   /* Check that variables have been properly unmarked. */
-  for (wp = blocked_clause->qbcp_qbce_witness_clauses.start, 
-         we = blocked_clause->qbcp_qbce_witness_clauses.top; 
+  for (wp = qbcp_qbce_get_state (qdpll, blocked_clause)->qbcp_qbce_witness_clauses.start, 
+         we = qbcp_qbce_get_state (qdpll, blocked_clause)->qbcp_qbce_witness_clauses.top; 
        wp < we; wp++)
     {
       QBCENonBlockedWitness witness_pair = *wp;
@@ -14423,23 +14820,23 @@ qbcp_qbce_collect_clauses_to_be_rescheduled (QDPLL *qdpll,
              we do not remove stored witnesses if a clause later becomes
              blocked. */
           QBCENonBlockedWitness *old_witness_pair_p = qbcp_qbce_find_lit_in_list 
-            (qdpll, &(blocked_clause->qbcp_qbce_witness_clauses), blocked_clause->qbcp_qbce_blocking_lit);
+            (qdpll, &(qbcp_qbce_get_state (qdpll, blocked_clause)->qbcp_qbce_witness_clauses), blocked_clause->qbcp_qbce_blocking_lit);
           unsigned int witness_offset = QDPLL_INVALID_WATCHER_POS;
           if (old_witness_pair_p)
             { 
-              witness_offset = old_witness_pair_p - blocked_clause->qbcp_qbce_witness_clauses.start;
-              QBCENonBlockedWitness witness_pair = blocked_clause->qbcp_qbce_witness_clauses.start[witness_offset];
+              witness_offset = old_witness_pair_p - qbcp_qbce_get_state (qdpll, blocked_clause)->qbcp_qbce_witness_clauses.start;
+              QBCENonBlockedWitness witness_pair = qbcp_qbce_get_state (qdpll, blocked_clause)->qbcp_qbce_witness_clauses.start[witness_offset];
               /* Must set 'offset_in_working_queue' also for entry of clause in notify list. */
-              witness_pair.blit_occ.constraint->qbcp_qbce_notify_maybe_blocked_clauses.start
+              qbcp_qbce_get_state (qdpll, BLIT_CONSTRAINT (qdpll->pcnf, witness_pair.blit_occ))->qbcp_qbce_notify_maybe_blocked_clauses.start
                 [witness_pair.offset.maybe_blocked_clause_in_notify_list].offset_in_working_queue = 
                 QDPLL_COUNT_STACK (qdpll->qbcp_qbce_maybe_blocked_clauses);
             }
           QBCENonBlockedWitness pair = {blocked_clause->qbcp_qbce_blocking_lit, 
                                         {blocked_clause->num_lits > 0 ? 
-                                         blocked_clause->lits[0] : 0, blocked_clause}, 
+                                         blocked_clause->lits[0] : 0, blocked_clause->ref}, 
                                         {witness_offset}, 
                                         QDPLL_COUNT_STACK (qdpll->qbcp_qbce_maybe_blocked_clauses)};
-          QDPLL_PUSH_STACK (qdpll->mm, *stack, pair);
+          QDPLL_PUSH_STACK (QBCE_MM (qdpll), *stack, pair);
           qbcp_qbce_reschedule_for_missing_witnesses (qdpll, blocked_clause, 
                                                       blocked_clause->qbcp_qbce_blocking_lit);
           blocked_clause->qbcp_qbce_blocked = 0;
@@ -14500,13 +14897,13 @@ qbcp_qbce_check_blocked_clauses_after_clause_addition (QDPLL *qdpll)
   while (!QDPLL_EMPTY_STACK (clauses_to_be_rescheduled))
     {
       pair = QDPLL_POP_STACK (clauses_to_be_rescheduled);
-      Constraint *rescheduled_clause = pair.blit_occ.constraint;
+      Constraint *rescheduled_clause = BLIT_CONSTRAINT (qdpll->pcnf, pair.blit_occ);
       /* Marks must have been reset at the time of collecting clauses to be
          rescheduled. */
       assert (!rescheduled_clause->qbcp_qbce_blocked);
       assert (!rescheduled_clause->qbcp_qbce_blocking_lit);
       /* Reschedule pair. */
-      QDPLL_PUSH_STACK(qdpll->mm, qdpll->qbcp_qbce_maybe_blocked_clauses, pair);
+      QDPLL_PUSH_STACK(QBCE_MM (qdpll), qdpll->qbcp_qbce_maybe_blocked_clauses, pair);
       if (qdpll->options.verbosity >= 2)
         {
           fprintf (stderr, "Rescheduled blocking lit %d and clause: ", 
@@ -14558,7 +14955,7 @@ qbcp_qbce_check_blocked_clauses_after_clause_addition (QDPLL *qdpll)
         {
           /* Clause is still blocked. */
           assert (c->qbcp_qbce_blocking_lit);
-          QDPLL_PUSH_STACK (qdpll->mm, new, c);
+          QDPLL_PUSH_STACK (QBCE_MM (qdpll), new, c);
         }
       else
         assert (!c->qbcp_qbce_blocking_lit);
@@ -14567,8 +14964,8 @@ qbcp_qbce_check_blocked_clauses_after_clause_addition (QDPLL *qdpll)
   ConstraintPtrStack tmp = qdpll->qbcp_qbce_blocked_clauses.start[0];
   qdpll->qbcp_qbce_blocked_clauses.start[0] = new;
 
-  QDPLL_DELETE_STACK (qdpll->mm, clauses_to_be_rescheduled);
-  QDPLL_DELETE_STACK (qdpll->mm, tmp);
+  QDPLL_DELETE_STACK (QBCE_MM (qdpll), clauses_to_be_rescheduled);
+  QDPLL_DELETE_STACK (QBCE_MM (qdpll), tmp);
 
 #if COMPUTE_STATS
   qdpll->stats.qbcp_qbce_current_blocked_clauses = 
@@ -14577,6 +14974,16 @@ qbcp_qbce_check_blocked_clauses_after_clause_addition (QDPLL *qdpll)
 }
 
 
+static int
+checkpoint_due (QDPLL * qdpll);
+
+static void
+write_checkpoint_file (QDPLL * qdpll);
+
+static void
+import_checkpoint (QDPLL * qdpll);
+
+
 /* Solver's core loop. */
 static QDPLLResult
 solve (QDPLL * qdpll)
@@ -14606,9 +15013,18 @@ solve (QDPLL * qdpll)
          literals have been pushed on the working queue in
          'import_original_constraint'. */
       assert (!qdpll->state.qbcp_qbce_currently_preprocessing);
-      qdpll->state.qbcp_qbce_currently_preprocessing = 1;
-      qbcp_qbce_find_blocked_clauses (qdpll);
-      qdpll->state.qbcp_qbce_currently_preprocessing = 0;
+      if (qdpll->state.qbce_closed && qdpll->options.qbce_preprocessing)
+        {
+          /* Nothing to find and static QBCE needs no witnesses of
+             non-blocked clauses, hence skip the checks. */
+          QDPLL_RESET_STACK (qdpll->qbcp_qbce_maybe_blocked_clauses);
+        }
+      else
+        {
+          qdpll->state.qbcp_qbce_currently_preprocessing = 1;
+          qbcp_qbce_find_blocked_clauses (qdpll);
+          qdpll->state.qbcp_qbce_currently_preprocessing = 0;
+        }
       assert (qdpll->state.decision_level == 0);
       assert (QDPLL_COUNT_STACK (qdpll->qbcp_qbce_blocked_clauses) == 1);
       qbcp_qbce_init_stack_of_stacks_of_next_dec_level 
@@ -14622,6 +15038,7 @@ solve (QDPLL * qdpll)
   assert (QDPLL_COUNT_STACK (qdpll->qbcp_qbce_relevant_vars_in_new_input_clauses) == 0);
 
   qdpll->state.solving_start_time = time_stamp();
+  qdpll->state.last_checkpoint_time = qdpll->state.solving_start_time;
 
   assert (!qdpll->state.restarting);
 
@@ -14693,6 +15110,9 @@ solve (QDPLL * qdpll)
       qdpll->state.clauses_added_since_cube_check = 0;
     }
 
+  if (qdpll->resume_buf)
+    import_checkpoint (qdpll);
+
   if (qdpll->state.cnt_created_clause_groups > 0 || 
       QDPLL_COUNT_STACK(qdpll->state.popped_off_internal_vars) != 0)
     {
@@ -14767,6 +15187,23 @@ solve (QDPLL * qdpll)
           fprintf (stderr, "User-given limit reached, exiting.\n");
           break;
         }
+      if (qdpll->state.mem_pressure && !relieve_mem_pressure (qdpll))
+        {
+          fprintf (stderr, "Memory limit reached, exiting.\n");
+          break;
+        }
+      if (checkpoint_due (qdpll))
+        {
+          const int stop = qdpll->checkpoint_request == 2;
+          qdpll->checkpoint_request = 0;
+          if (qdpll->checkpoint_path)
+            write_checkpoint_file (qdpll);
+          if (stop)
+            {
+              fprintf (stderr, "Checkpoint requested, exiting.\n");
+              break;
+            }
+        }
 
       state = bcp (qdpll);
 
@@ -14967,9 +15404,9 @@ reset_clean_up_assignments (QDPLL *qdpll)
            p--)
         {
           Var *assigned_var = VARID2VARPTR (vars, *p);
-          assert (QDPLL_VAR_ASSIGNED (assigned_var));
-          assert (assigned_var->assignment != QDPLL_ASSIGNMENT_UNDEF);
-          assert (assigned_var->decision_level != QDPLL_INVALID_DECISION_LEVEL);
+          assert (QDPLL_VAR_ASSIGNED (qdpll->pcnf, assigned_var));
+          assert (QDPLL_VAR_VALUE (qdpll->pcnf, assigned_var) != QDPLL_ASSIGNMENT_UNDEF);
+          assert (QDPLL_VAR_LEVEL (qdpll->pcnf, assigned_var) != QDPLL_INVALID_DECISION_LEVEL);
           assert (assigned_var->mode != QDPLL_VARMODE_UNDEF);
           assert (assigned_var->mode != QDPLL_VARMODE_LBRANCH
                   || !assigned_var->antecedent);
@@ -14977,10 +15414,10 @@ reset_clean_up_assignments (QDPLL *qdpll)
                   || !assigned_var->antecedent);
 
           /*start: like backtrack-undo */
-          assert (assigned_var->trail_pos != QDPLL_INVALID_TRAIL_POS);
-          assert (assigned_var->trail_pos <
+          assert (QDPLL_VAR_TRAIL_POS (qdpll->pcnf, assigned_var) != QDPLL_INVALID_TRAIL_POS);
+          assert (QDPLL_VAR_TRAIL_POS (qdpll->pcnf, assigned_var) <
                   (unsigned int) (qdpll->assigned_vars_top - qdpll->assigned_vars));
-          assert (qdpll->assigned_vars[assigned_var->trail_pos] == assigned_var->id);
+          assert (qdpll->assigned_vars[QDPLL_VAR_TRAIL_POS (qdpll->pcnf, assigned_var)] == assigned_var->id);
           if (assigned_var->mode == QDPLL_VARMODE_LBRANCH
               || assigned_var->mode == QDPLL_VARMODE_RBRANCH)
             {
@@ -14993,17 +15430,17 @@ reset_clean_up_assignments (QDPLL *qdpll)
                   /* Remove stack of clauses blocked at decision level of 'var' and reset
                      blocked-flag of clauses. */
                   qbcp_qbce_backtrack_clear_stack_of_stacks 
-                    (qdpll, &qdpll->qbcp_qbce_blocked_clauses, 1, assigned_var->decision_level);
+                    (qdpll, &qdpll->qbcp_qbce_blocked_clauses, 1, QDPLL_VAR_LEVEL (qdpll->pcnf, assigned_var));
                   /* Remove stack of clauses marked at decision level of 'var' and reset
                      marked-flag of clauses. */
                   qbcp_qbce_backtrack_clear_stack_of_stacks 
-                    (qdpll, &qdpll->qbcp_qbce_marked_clauses, 0, assigned_var->decision_level);
+                    (qdpll, &qdpll->qbcp_qbce_marked_clauses, 0, QDPLL_VAR_LEVEL (qdpll->pcnf, assigned_var));
                 }
             }
           assigned_var->mode = QDPLL_VARMODE_UNDEF;
-          assigned_var->assignment = QDPLL_ASSIGNMENT_UNDEF;
-          assigned_var->decision_level = QDPLL_INVALID_DECISION_LEVEL;
-          assigned_var->trail_pos = QDPLL_INVALID_TRAIL_POS;
+          QDPLL_VAR_VALUE (qdpll->pcnf, assigned_var) = QDPLL_ASSIGNMENT_UNDEF;
+          QDPLL_VAR_LEVEL (qdpll->pcnf, assigned_var) = QDPLL_INVALID_DECISION_LEVEL;
+          QDPLL_VAR_TRAIL_POS (qdpll->pcnf, assigned_var) = QDPLL_INVALID_TRAIL_POS;
           if (assigned_var->antecedent)
             {
               assert (!assigned_var->antecedent->qbcp_qbce_blocked);
@@ -15137,12 +15574,12 @@ rename_internal_variable_ids_in_constraints (QDPLL *qdpll, ConstraintList *clist
   for (c = clist->first; c; c = c->link.next)
     {
       rename_internal_variable_ids_on_qbce_blits_stack 
-        (qdpll, c->qbcp_qbce_notify_maybe_blocked_clauses.start, 
-         c->qbcp_qbce_notify_maybe_blocked_clauses.top, 
+        (qdpll, qbcp_qbce_get_state (qdpll, c)->qbcp_qbce_notify_maybe_blocked_clauses.start, 
+         qbcp_qbce_get_state (qdpll, c)->qbcp_qbce_notify_maybe_blocked_clauses.top, 
          add_to_offset);
       rename_internal_variable_ids_on_qbce_blits_stack 
-        (qdpll, c->qbcp_qbce_witness_clauses.start, 
-         c->qbcp_qbce_witness_clauses.top, 
+        (qdpll, qbcp_qbce_get_state (qdpll, c)->qbcp_qbce_witness_clauses.start, 
+         qbcp_qbce_get_state (qdpll, c)->qbcp_qbce_witness_clauses.top, 
          add_to_offset);
       LitID *p, *e;
       for (p = c->lits, e = p + c->num_lits; p < e; p++)
@@ -15281,6 +15718,11 @@ move_internal_ids (QDPLL *qdpll, const unsigned int cur_size_user_vars,
           QDPLL_ABORT_QDPLL (!p->is_internal, "error in move-internal-vars");
           *dest = *p;
           dest->id = dest->id + add_to_offset;
+          QDPLL_VAR_VALUE (qdpll->pcnf, dest) = QDPLL_VAR_VALUE (qdpll->pcnf, p);
+          QDPLL_VAR_LEVEL (qdpll->pcnf, dest) = QDPLL_VAR_LEVEL (qdpll->pcnf, p);
+          QDPLL_VAR_TRAIL_POS (qdpll->pcnf, dest) = 
+            QDPLL_VAR_TRAIL_POS (qdpll->pcnf, p);
+          clear_var_hot_state (qdpll, p);
           memset (p, 0, sizeof (Var));
           dest++;
           qdpll->state.next_free_internal_var_id++;
@@ -15386,7 +15828,7 @@ qdo_has_outer_scope_unassigned_vars (QDPLL *qdpll, Scope *outer, QDPLLResult res
   for (p = outer->vars.start, e = outer->vars.top; p < e; p++)
     {
       Var *var = VARID2VARPTR(qdpll->pcnf.vars, *p);
-      if (!QDPLL_VAR_ASSIGNED(var))
+      if (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, var))
         return 1;
     }
 
@@ -15408,7 +15850,7 @@ qdo_fix_outer_scope_unassigned_vars_aux (QDPLL *qdpll, Scope *outer, VarIDStack
       Var *var = LIT2VARPTR(qdpll->pcnf.vars, lit);
       if (var->mode == QDPLL_VARMODE_UNIT)
         {
-          assert (QDPLL_VAR_ASSIGNED (var));
+          assert (QDPLL_VAR_ASSIGNED (qdpll->pcnf, var));
           if ((!c->is_cube && var->scope->type == QDPLL_QTYPE_EXISTS) || 
               (c->is_cube && var->scope->type == QDPLL_QTYPE_FORALL))
             {
@@ -15422,7 +15864,7 @@ qdo_fix_outer_scope_unassigned_vars_aux (QDPLL *qdpll, Scope *outer, VarIDStack
         }
       else
         {
-          if (!QDPLL_VAR_ASSIGNED (var))
+          if (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, var))
             {
               /* Set the value of required unassigned variables. */
               if ((var->scope == outer || var->user_scope == outer) && 
@@ -15479,7 +15921,7 @@ qdo_fix_outer_scope_unassigned_vars (QDPLL *qdpll, Scope *outer, QDPLLResult res
       VarID id = QDPLL_POP_STACK(stack);
       Var *var = VARID2VARPTR(qdpll->pcnf.vars, id);
       assert (mark_table[var->id]);
-      assert (QDPLL_VAR_ASSIGNED(var));
+      assert (QDPLL_VAR_ASSIGNED (qdpll->pcnf, var));
       assert (var->mode == QDPLL_VARMODE_UNIT);
       assert (var->scope->type != outer->type);
       assert (var->antecedent);
@@ -15594,10 +16036,7 @@ new_clause_group_aux (QDPLL *qdpll)
       /* Enlarge variable table to store additional internal variable IDs. */
       assert ((cur_size_vars - qdpll->pcnf.size_user_vars) <= cur_size_vars);
       const unsigned int new_size_vars = cur_size_vars + DEFAULT_INTERNAL_VARS_INCREASE; 
-      qdpll->pcnf.vars = (Var *) qdpll_realloc (qdpll->mm, qdpll->pcnf.vars,
-                                                cur_size_vars * sizeof (Var),
-                                                new_size_vars * sizeof (Var));
-      qdpll->pcnf.size_vars = new_size_vars;
+      enlarge_vars (qdpll, new_size_vars);
       assert (qdpll->pcnf.size_user_vars <= qdpll->pcnf.size_vars);
       assert_internal_vars_integrity (qdpll);
       if (qdpll->options.verbosity >= 2)
@@ -15778,7 +16217,7 @@ qdo_reconstruct_cnf_model_is_clause_empty (QDPLL * qdpll, Constraint * clause)
       if (blocking_var->scope->nesting < var->scope->nesting)
         return 1;
 
-      if (!QDPLL_VAR_ASSIGNED (var))
+      if (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, var))
         {
           /* Consider clause as nonempty when seeing unassigned variable to
              the left. */
@@ -15789,13 +16228,13 @@ qdo_reconstruct_cnf_model_is_clause_empty (QDPLL * qdpll, Constraint * clause)
         {
           if (QDPLL_LIT_NEG (lit))
             {
-              if (QDPLL_VAR_ASSIGNED_FALSE (var))
+              if (QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var))
                 return 0;
             }
           else
             {
               assert (QDPLL_LIT_POS (lit));
-              if (QDPLL_VAR_ASSIGNED_TRUE (var))
+              if (QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var))
                 return 0;
             }
         }
@@ -15844,12 +16283,12 @@ qdo_qbcp_qbce_reconstruct_cnf_model (QDPLL *qdpll, Scope *outer)
                   assert (blocking_lit);
                   Var *var = LIT2VARPTR (qdpll->pcnf.vars, blocking_lit);
                   assert (QDPLL_VAR_EXISTS (var));
-                  assert (QDPLL_VAR_ASSIGNED (var));
-                  assert ((QDPLL_LIT_NEG (blocking_lit) && QDPLL_VAR_ASSIGNED_TRUE (var)) || 
-                          (QDPLL_LIT_POS (blocking_lit) && QDPLL_VAR_ASSIGNED_FALSE (var)));
+                  assert (QDPLL_VAR_ASSIGNED (qdpll->pcnf, var));
+                  assert ((QDPLL_LIT_NEG (blocking_lit) && QDPLL_VAR_ASSIGNED_TRUE (qdpll->pcnf, var)) || 
+                          (QDPLL_LIT_POS (blocking_lit) && QDPLL_VAR_ASSIGNED_FALSE (qdpll->pcnf, var)));
                   /* Flip assignment of the blocking literal's variable. */
-                  var->assignment = -var->assignment;
-                  assert (var->decision_level != QDPLL_INVALID_DECISION_LEVEL);
+                  QDPLL_VAR_VALUE (qdpll->pcnf, var) = -QDPLL_VAR_VALUE (qdpll->pcnf, var);
+                  assert (QDPLL_VAR_LEVEL (qdpll->pcnf, var) != QDPLL_INVALID_DECISION_LEVEL);
                   if (qdpll->options.verbosity >= 2)
                     {
                       fprintf (stderr, "Formerly unsatisfied blocked clause: ");
@@ -15871,6 +16310,50 @@ qdo_qbcp_qbce_reconstruct_cnf_model (QDPLL *qdpll, Scope *outer)
     }
 }
 
+/* Create dependency manager of type 'type' and set the option flag of
+   the type. */
+static void
+create_dep_man (QDPLL * qdpll, QDPLLDepManType type)
+{
+  assert (!qdpll->options.depman_qdag && !qdpll->options.depman_simple
+          && !qdpll->options.depman_rrs);
+  if (type == QDPLL_DEPMAN_TYPE_RRS)
+    {
+      qdpll->dm = (QDPLLDepManGeneric *)
+        qdpll_rrs_dep_man_create (qdpll->mm, &(qdpll->pcnf), qdpll);
+      qdpll->options.depman_rrs = 1;
+    }
+  else
+    {
+      qdpll->dm = (QDPLLDepManGeneric *)
+        qdpll_qdag_dep_man_create (qdpll->mm, &(qdpll->pcnf), type,
+                                   qdpll->options.
+                                   depman_qdag_print_deps_by_search, qdpll);
+      if (type == QDPLL_DEPMAN_TYPE_QDAG)
+        qdpll->options.depman_qdag = 1;
+      else if (type == QDPLL_DEPMAN_TYPE_SIMPLE)
+        qdpll->options.depman_simple = 1;
+      else
+        {
+          QDPLL_ABORT_QDPLL (1, "Unexpected value for DM!");
+        }
+    }
+}
+
+
+/* Delete dependency manager and reset the option flag of its type. */
+static void
+delete_dep_man (QDPLL * qdpll)
+{
+  if (qdpll->dm->type == QDPLL_DEPMAN_TYPE_RRS)
+    qdpll_rrs_dep_man_delete ((QDPLLDepManRRS *) qdpll->dm);
+  else
+    qdpll_qdag_dep_man_delete ((QDPLLDepManQDAG *) qdpll->dm);
+  qdpll->dm = 0;
+  qdpll->options.depman_qdag = qdpll->options.depman_simple =
+    qdpll->options.depman_rrs = 0;
+}
+
 /* -------------------- START: PUBLIC FUNCTIONS --------------------*/
 
 QDPLL *
@@ -15879,6 +16362,8 @@ qdpll_create ()
   QDPLLMemMan *mm = qdpll_create_mem_man ();
   QDPLL *qdpll = (QDPLL *) qdpll_malloc (mm, sizeof (QDPLL));
   qdpll->mm = mm;
+  /* Exceeding the memory limit does not abort, see 'relieve_mem_pressure'. */
+  qdpll_set_mem_pressure_callback (mm, mem_pressure_cb, qdpll);
   Scope *default_scope = (Scope *) qdpll_malloc (mm, sizeof (Scope));
   default_scope->type = QDPLL_QTYPE_EXISTS;
   assert (!default_scope->is_internal);
@@ -15898,8 +16383,16 @@ qdpll_create ()
   qdpll->pcnf.size_user_vars = DEFAULT_USER_VARS_SIZE;
   qdpll->pcnf.vars =
     (Var *) qdpll_malloc (mm, DEFAULT_VARS_SIZE * sizeof (Var));
+  qdpll->pcnf.var_values =
+    (signed char *) qdpll_malloc (mm, DEFAULT_VARS_SIZE * sizeof (signed char));
+  qdpll->pcnf.var_levels =
+    (unsigned int *) qdpll_malloc (mm, DEFAULT_VARS_SIZE * sizeof (unsigned int));
+  qdpll->pcnf.var_trail_pos =
+    (unsigned int *) qdpll_malloc (mm, DEFAULT_VARS_SIZE * sizeof (unsigned int));
   qdpll->state.next_free_internal_var_id = qdpll->pcnf.size_user_vars;
 
+  qdpll->pcnf.constraint_base = qdpll_region_base (mm);
+
   PriorityQueue *pqueue = pqueue_create (mm, 1);
   qdpll->qpup_nodes = pqueue;
 
@@ -15922,26 +16415,7 @@ qdpll_create ()
      the old default one 'SDCL'. */
   qdpll->options.dh = QDPLL_DH_QTYPE;
 
-  if (DEFAULT_DEPMANTYPE == QDPLL_DEPMAN_TYPE_QDAG)
-    {
-      qdpll->options.depman_qdag = 1;
-      assert (!qdpll->options.depman_simple);
-    }
-  else if (DEFAULT_DEPMANTYPE == QDPLL_DEPMAN_TYPE_SIMPLE)
-    {
-      qdpll->options.depman_simple = 1;
-      assert (!qdpll->options.depman_qdag);
-    }
-  else
-    {
-      QDPLL_ABORT_QDPLL (1, "Unexpected value for DM!");
-    }
-  qdpll->dm = (QDPLLDepManGeneric *)
-    qdpll_qdag_dep_man_create (qdpll->mm,
-                               &(qdpll->pcnf),
-                               DEFAULT_DEPMANTYPE,
-                               qdpll->options.
-                               depman_qdag_print_deps_by_search, qdpll);
+  create_dep_man (qdpll, DEFAULT_DEPMANTYPE);
 
   qdpll->trace_scope = &print_qrp_scope;
   qdpll->trace_constraint = &print_qrp_constraint;
@@ -15985,11 +16459,11 @@ qdpll_create ()
   assert (qdpll->state.decision_level == 0);
   ConstraintPtrStack cstack;
   QDPLL_INIT_STACK (cstack);
-  QDPLL_PUSH_STACK (qdpll->mm, qdpll->qbcp_qbce_blocked_clauses, cstack);
+  QDPLL_PUSH_STACK (QBCE_MM (qdpll), qdpll->qbcp_qbce_blocked_clauses, cstack);
   assert (QDPLL_COUNT_STACK (qdpll->qbcp_qbce_blocked_clauses) == 
           qdpll->state.decision_level + 1);
   /* Marked clauses per decision level. */
-  QDPLL_PUSH_STACK (qdpll->mm, qdpll->qbcp_qbce_marked_clauses, cstack);
+  QDPLL_PUSH_STACK (QBCE_MM (qdpll), qdpll->qbcp_qbce_marked_clauses, cstack);
   assert (QDPLL_COUNT_STACK (qdpll->qbcp_qbce_marked_clauses) == 
           qdpll->state.decision_level + 1);
   return qdpll;
@@ -16002,17 +16476,20 @@ qdpll_delete (QDPLL * qdpll)
   QDPLL_ABORT_QDPLL (!qdpll, "pointer to solver object is null!");
   QDPLLMemMan *mm = qdpll->mm;
 
+  if (qdpll->trace_writer)
+    qdpll_trace_writer_delete (qdpll->trace_writer);
+
   QDPLL_DELETE_STACK (mm, qdpll->add_stack);
   QDPLL_DELETE_STACK (mm, qdpll->add_stack_tmp);
   QDPLL_DELETE_STACK (mm, qdpll->wreason_a);
   QDPLL_DELETE_STACK (mm, qdpll->wreason_e);
-  QDPLL_DELETE_STACK (mm, qdpll->dec_vars);
+  QDPLL_DELETE_STACK (TRAIL_MM (qdpll), qdpll->dec_vars);
   QDPLL_DELETE_STACK (mm, qdpll->smaller_type_lits);
   pqueue_delete (mm, qdpll->qpup_nodes);
-  QDPLL_DELETE_STACK (mm, qdpll->qpup_vars);
-  QDPLL_DELETE_STACK (mm, qdpll->qpup_units);
-  QDPLL_DELETE_STACK (mm, qdpll->qpup_kept_lits);
-  QDPLL_DELETE_STACK (mm, qdpll->qpup_weak_predict_lits);
+  QDPLL_DELETE_STACK (QPUP_MM (qdpll), qdpll->qpup_vars);
+  QDPLL_DELETE_STACK (QPUP_MM (qdpll), qdpll->qpup_units);
+  QDPLL_DELETE_STACK (QPUP_MM (qdpll), qdpll->qpup_kept_lits);
+  QDPLL_DELETE_STACK (QPUP_MM (qdpll), qdpll->qpup_weak_predict_lits);
   QDPLL_DELETE_STACK (mm, qdpll->state.popped_off_internal_vars);
   QDPLL_DELETE_STACK (mm, qdpll->state.cur_used_internal_vars);
   QDPLL_DELETE_STACK (mm, qdpll->pcnf.user_scope_ptrs);
@@ -16020,8 +16497,8 @@ qdpll_delete (QDPLL * qdpll)
   QDPLL_DELETE_STACK (mm, qdpll->user_given_assumptions);
   QDPLL_DELETE_STACK (mm, qdpll->empty_formula_watchers_per_dec_level);
   QDPLL_DELETE_STACK (mm, qdpll->empty_formula_watching_blit_occs);
-  QDPLL_DELETE_STACK (mm, qdpll->qbcp_qbce_maybe_blocked_clauses);
-  QDPLL_DELETE_STACK (mm, qdpll->qbcp_qbce_relevant_vars_in_new_input_clauses);
+  QDPLL_DELETE_STACK (QBCE_MM (qdpll), qdpll->qbcp_qbce_maybe_blocked_clauses);
+  QDPLL_DELETE_STACK (QBCE_MM (qdpll), qdpll->qbcp_qbce_relevant_vars_in_new_input_clauses);
   ConstraintPtrStack *csp, *cse;
   /* NOTE: must go until stack.end, not just stack.top, because we did not
      free the stacks after pop. */
@@ -16029,9 +16506,9 @@ qdpll_delete (QDPLL * qdpll)
          cse = qdpll->qbcp_qbce_blocked_clauses.end; csp < cse; csp++)
     {
       ConstraintPtrStack stack = *csp;
-      QDPLL_DELETE_STACK (mm, stack);
+      QDPLL_DELETE_STACK (QBCE_MM (qdpll), stack);
     }
-  QDPLL_DELETE_STACK (mm, qdpll->qbcp_qbce_blocked_clauses);
+  QDPLL_DELETE_STACK (QBCE_MM (qdpll), qdpll->qbcp_qbce_blocked_clauses);
   /* Marked clauses per decision level. */
   /* NOTE: must go until stack.end, not just stack.top, because we did not
      free the stacks after pop. */
@@ -16039,9 +16516,9 @@ qdpll_delete (QDPLL * qdpll)
          cse = qdpll->qbcp_qbce_marked_clauses.end; csp < cse; csp++)
     {
       ConstraintPtrStack stack = *csp;
-      QDPLL_DELETE_STACK (mm, stack);
+      QDPLL_DELETE_STACK (QBCE_MM (qdpll), stack);
     }
-  QDPLL_DELETE_STACK (mm, qdpll->qbcp_qbce_marked_clauses);
+  QDPLL_DELETE_STACK (QBCE_MM (qdpll), qdpll->qbcp_qbce_marked_clauses);
 
   if (qdpll->qdo_assignment_table)
     {
@@ -16054,6 +16531,11 @@ qdpll_delete (QDPLL * qdpll)
   if (qdpll->assumption_lits_constraint)
     delete_constraint (qdpll, qdpll->assumption_lits_constraint);
 
+  if (qdpll->checkpoint_path)
+    qdpll_free (mm, qdpll->checkpoint_path, strlen (qdpll->checkpoint_path) + 1);
+  if (qdpll->resume_buf)
+    qdpll_free (mm, qdpll->resume_buf, qdpll->resume_bytes);
+
   /* Delete scopes. */
   delete_scope_list (qdpll, &qdpll->pcnf.scopes);
   delete_scope_list (qdpll, &qdpll->pcnf.user_scopes);
@@ -16067,6 +16549,12 @@ qdpll_delete (QDPLL * qdpll)
         delete_variable (qdpll, v);
     }
   qdpll_free (mm, vars, qdpll->pcnf.size_vars * sizeof (Var));
+  qdpll_free (mm, qdpll->pcnf.var_values,
+              qdpll->pcnf.size_vars * sizeof (signed char));
+  qdpll_free (mm, qdpll->pcnf.var_levels,
+              qdpll->pcnf.size_vars * sizeof (unsigned int));
+  qdpll_free (mm, qdpll->pcnf.var_trail_pos,
+              qdpll->pcnf.size_vars * sizeof (unsigned int));
 
   /* Delete clauses. */
   qdpll_delete_constraint_list (qdpll, &(qdpll->pcnf.clauses));
@@ -16077,18 +16565,24 @@ qdpll_delete (QDPLL * qdpll)
   /* Delete cover sets, if any. */
   qdpll_delete_constraint_list (qdpll, &(qdpll->cover_sets));
 
-  qdpll_free (mm, qdpll->var_pqueue, qdpll->size_var_pqueue * sizeof (VarID));
-  qdpll_free (mm, qdpll->assigned_vars,
+  /* Arenas hold deleted constraints only. */
+  int is_cube;
+  for (is_cube = 0; is_cube < 2; is_cube++)
+    qdpll_arena_shrink (qdpll_mem_view (mm, LEARNT_MEM_CATEGORY (is_cube)),
+                        is_cube, 0);
+
+  qdpll_free (PQUEUE_MM (qdpll), qdpll->var_pqueue,
+              qdpll->size_var_pqueue * sizeof (VarID));
+  qdpll_free (TRAIL_MM (qdpll), qdpll->assigned_vars,
               size_assigned_vars (qdpll) * sizeof (VarID));
 
   assert (qdpll->dm);
-  assert ((qdpll->options.depman_simple && !qdpll->options.depman_qdag)
-          || (!qdpll->options.depman_simple && qdpll->options.depman_qdag)
-          || (!qdpll->options.depman_simple && !qdpll->options.depman_qdag));
+  assert (qdpll->options.depman_simple + qdpll->options.depman_qdag
+          + qdpll->options.depman_rrs == 1);
   /* Delete dependency manager. 
      IMPORTANT NOTE: all heap-memory managed by DepMan must already have been
      deleted before! */
-  qdpll_qdag_dep_man_delete ((QDPLLDepManQDAG *) qdpll->dm);
+  delete_dep_man (qdpll);
 
   qdpll_free (mm, qdpll, sizeof (QDPLL));
   qdpll_delete_mem_man (mm);
@@ -16106,6 +16600,10 @@ qdpll_configure (QDPLL * qdpll, char *configure_str)
   if (!strncmp (configure_str, "--trace", strlen ("--trace")))
     {
       qdpll->options.trace = TRACE_QRP;
+      if (!qdpll->trace_writer)
+        qdpll->trace_writer =
+          qdpll_trace_writer_create (qdpll_mem_view (qdpll->mm, QDPLL_MEM_TRACE),
+                                     stdout);
 
       configure_str += strlen ("--trace");
       if (!strcmp (configure_str, "=bqrp"))
@@ -16619,20 +17117,8 @@ qdpll_configure (QDPLL * qdpll, char *configure_str)
   else if (!strncmp (configure_str, "--dep-man=", strlen ("--dep-man=")))
     {
       assert (qdpll->dm);
-      assert ((qdpll->options.depman_simple && !qdpll->options.depman_qdag)
-              || (!qdpll->options.depman_simple && qdpll->options.depman_qdag)
-              || (!qdpll->options.depman_simple
-                  && !qdpll->options.depman_qdag));
-
-      QDPLLDepManType current;
-      if (qdpll->options.depman_qdag)
-        current = QDPLL_DEPMAN_TYPE_QDAG;
-      else if (qdpll->options.depman_simple)
-        current = QDPLL_DEPMAN_TYPE_SIMPLE;
-      else
-        {
-          QDPLL_ABORT_QDPLL (1, "unexpected value for DM!");
-        }
+      assert (qdpll->options.depman_simple + qdpll->options.depman_qdag
+              + qdpll->options.depman_rrs == 1);
 
       configure_str += strlen ("--dep-man=");
 
@@ -16641,33 +17127,19 @@ qdpll_configure (QDPLL * qdpll, char *configure_str)
         new = QDPLL_DEPMAN_TYPE_QDAG;
       else if (!strcmp (configure_str, "simple"))
         new = QDPLL_DEPMAN_TYPE_SIMPLE;
+      else if (!strcmp (configure_str, "rrs"))
+        new = QDPLL_DEPMAN_TYPE_RRS;
       else
         {
-          result = "expecting 'simple' or 'qdag' after '--dep-man='";
+          result = "expecting 'simple', 'qdag' or 'rrs' after '--dep-man='";
           return result;
         }
 
-      if (current != new)
+      if (qdpll->dm->type != new)
         {
           /* Delete old, create new DepMan. */
-          qdpll->options.depman_qdag = qdpll->options.depman_simple = 0;
-          qdpll_qdag_dep_man_delete ((QDPLLDepManQDAG *) qdpll->dm);
-          qdpll->dm =
-            (QDPLLDepManGeneric *)
-            qdpll_qdag_dep_man_create (qdpll->mm, &(qdpll->pcnf), new,
-                                       qdpll->options.
-                                       depman_qdag_print_deps_by_search,
-                                       qdpll);
-          if (new == QDPLL_DEPMAN_TYPE_QDAG)
-            {
-              assert (!qdpll->options.depman_qdag);
-              qdpll->options.depman_qdag = 1;
-            }
-          else if (new == QDPLL_DEPMAN_TYPE_SIMPLE)
-            {
-              assert (!qdpll->options.depman_simple);
-              qdpll->options.depman_simple = 1;
-            }
+          delete_dep_man (qdpll);
+          create_dep_man (qdpll, new);
         }
     }
   else if (!strcmp (configure_str, "--qdag-print-deps-by-search"))
@@ -17002,7 +17474,7 @@ qdpll_get_relevant_clause_groups (QDPLL * qdpll)
              containing literals of the relevant internal assumptions. */
           assert (a_var->is_cur_used_internal_var);
           assert (!a_var->is_cur_inactive_group_selector);
-          assert (a_var->assignment == QDPLL_ASSIGNMENT_FALSE);
+          assert (QDPLL_VAR_VALUE (qdpll->pcnf, a_var) == QDPLL_ASSIGNMENT_FALSE);
           ClauseGroupID group_id = a_var->clause_group_id;
           assert (qdpll_exists_clause_group (qdpll, group_id));
           assert (!clause_group_to_var_ptr 
@@ -17140,10 +17612,7 @@ qdpll_adjust_vars (QDPLL * qdpll, VarID num)
       assert (cur_size_internal_vars <= cur_size_vars);
       const unsigned int new_size_vars = new_size_user_vars + cur_size_internal_vars; 
       assert (new_size_user_vars <= new_size_vars);
-      qdpll->pcnf.vars = (Var *) qdpll_realloc (qdpll->mm, qdpll->pcnf.vars,
-                                                cur_size_vars * sizeof (Var),
-                                                new_size_vars * sizeof (Var));
-      qdpll->pcnf.size_vars = new_size_vars;
+      enlarge_vars (qdpll, new_size_vars);
       qdpll->pcnf.size_user_vars = new_size_user_vars;
       qdpll->state.next_free_internal_var_id = qdpll->pcnf.size_user_vars;
 
@@ -17384,11 +17853,21 @@ qdpll_add (QDPLL * qdpll, LitID id)
 }
 
 
+void
+qdpll_add_lits (QDPLL * qdpll, const LitID * ids, unsigned int num)
+{
+  QDPLL_ABORT_QDPLL (!qdpll, "pointer to solver object is null!");
+  const LitID *p, *e;
+  for (p = ids, e = ids + num; p < e; p++)
+    add_aux (qdpll, *p);
+}
+
+
 QDPLLResult
 qdpll_sat (QDPLL * qdpll)
 {
   QDPLL_ABORT_QDPLL (!qdpll, "pointer to solver object is null!");
-  QDPLL_ABORT_QDPLL(qdpll->options.depman_qdag && qdpll->options.trace,
+  QDPLL_ABORT_QDPLL(!qdpll->options.depman_simple && qdpll->options.trace,
                     "Trace mode must be combined with '--dep-man=simple'!");
   QDPLL_ABORT_QDPLL (qdpll->state.scope_opened,
                      "there is an open scope (must be closed with 'qdpll_add(qdpll, 0)')!");
@@ -17408,12 +17887,17 @@ qdpll_sat (QDPLL * qdpll)
                      "Must configure by '--incremental-use' to enable incremental use!");
 
   QDPLL_ABORT_QDPLL(((qdpll->state.num_sat_calls > 1 && qdpll->state.pending_cubes_check && 
-                     qdpll->options.depman_qdag)), 
+                     !qdpll->options.depman_simple)), 
                     "Must configure by '--dep-man=simple' in incremental use!");
 
-  QDPLL_ABORT_QDPLL (qdpll->options.incremental_use && qdpll->options.depman_qdag, 
+  QDPLL_ABORT_QDPLL (qdpll->options.incremental_use && !qdpll->options.depman_simple, 
                     "Must configure by '--dep-man=simple' in incremental use!");
 
+  /* Dynamic QBCE has been shown to be sound together with the standard
+     dependency scheme only. */
+  QDPLL_ABORT_QDPLL (qdpll->options.depman_rrs && !qdpll->options.no_qbce_dynamic,
+                     "(temporary restriction) Must combine '--dep-man=rrs' with '--no-qbce-dynamic'!");
+
   QDPLL_ABORT_QDPLL (qdpll->qdo_assignment_table || qdpll->qdo_table_bytes, 
                      "Unexpected computed assignment for QDIMACS output. "\
                      "Must call 'qdpll_reset()' before calling 'qdpll_sat ()'.");
@@ -17461,9 +17945,8 @@ qdpll_sat (QDPLL * qdpll)
   /* Reset any previous result. */
   qdpll->result = QDPLL_RESULT_UNKNOWN;
 
-  assert ((qdpll->options.depman_simple && !qdpll->options.depman_qdag) ||
-          (!qdpll->options.depman_simple && qdpll->options.depman_qdag)
-          || (!qdpll->options.depman_simple && !qdpll->options.depman_qdag));
+  assert (qdpll->options.depman_simple + qdpll->options.depman_qdag
+          + qdpll->options.depman_rrs == 1);
 
   QDPLLResult r = QDPLL_RESULT_UNKNOWN;
 
@@ -17477,6 +17960,9 @@ qdpll_sat (QDPLL * qdpll)
 
   r = solve (qdpll);
   qdpll->result = r;
+  /* Caller may write to the trace stream after solving. */
+  if (qdpll->trace_writer)
+    qdpll_trace_writer_flush (qdpll->trace_writer);
 #if COMPUTE_TIMES
   qdpll->time_stats.total_sat_time +=
     (time_stamp () - qdpll->time_stats.sat_time_start);
@@ -17485,21 +17971,16 @@ qdpll_sat (QDPLL * qdpll)
 }
 
 
-/* Get assignment of variable.  */
-QDPLLAssignment
-qdpll_get_value (QDPLL * qdpll, VarID id)
+/* Complete the assignment of the outermost scope for QDIMACS output after
+   solving. Repeating this does not change any value, hence it is done only
+   once per result instead of scanning the outermost scope in every call of
+   'qdpll_get_value'. */
+static void
+qdo_prepare_values (QDPLL * qdpll)
 {
-  QDPLL_ABORT_QDPLL (!qdpll, "pointer to solver object is null!");
-  QDPLL_ABORT_QDPLL (!qdpll_is_var_declared (qdpll, id), 
-                     "Variable with given ID is not declared!");
-  /* Fix: we do NOT call 'import_user_scopes' here because this will copy
-     scopes and hence destroy the QDAG. see 'qdpll_print_qdimacs_output' for
-     comment. */
   const QDPLLResult result = qdpll->result;
-  assert (id);
-  assert (id < qdpll->pcnf.size_vars);
-  Var *var = VARID2VARPTR (qdpll->pcnf.vars, id);
-  QDPLL_ABORT_QDPLL (var->is_internal, "Unexpected internal variable ID.");
+  if (qdpll->state.qdo_values_prepared)
+    return;
 
   if (!qdpll->qdo_assignment_table)
     {
@@ -17572,14 +18053,14 @@ qdpll_get_value (QDPLL * qdpll, VarID id)
                   for (p = outer->vars.start, e = outer->vars.top; p < e; p++)
                     {
                       Var *var = VARID2VARPTR(qdpll->pcnf.vars, *p);
-                      if (!QDPLL_VAR_ASSIGNED(var) && 
+                      if (!QDPLL_VAR_ASSIGNED (qdpll->pcnf, var) && 
                           (!qdpll->qdo_assignment_table || 
                            qdpll->qdo_assignment_table[var->id] == QDPLL_ASSIGNMENT_UNDEF))
                         {
                           if (qdpll->options.verbosity >= 2)
                             fprintf (stderr, "Partial model reconstruction: outer unassigned var. %d set to false\n", var->id);
-                          var->assignment = QDPLL_ASSIGNMENT_FALSE;
-                          var->decision_level = qdpll->state.decision_level;
+                          QDPLL_VAR_VALUE (qdpll->pcnf, var) = QDPLL_ASSIGNMENT_FALSE;
+                          QDPLL_VAR_LEVEL (qdpll->pcnf, var) = qdpll->state.decision_level;
                           var->mode = QDPLL_VARMODE_PURE;
                         }
                     }
@@ -17590,12 +18071,20 @@ qdpll_get_value (QDPLL * qdpll, VarID id)
         }
     }
 
-  assert (var->assignment == QDPLL_ASSIGNMENT_TRUE ||
-          var->assignment == QDPLL_ASSIGNMENT_FALSE ||
-          var->assignment == QDPLL_ASSIGNMENT_UNDEF);
+  if (result != QDPLL_RESULT_UNKNOWN)
+    qdpll->state.qdo_values_prepared = 1;
+}
+
 
-  if (var->assignment != QDPLL_ASSIGNMENT_UNDEF || !qdpll->qdo_assignment_table)
-    return var->assignment;
+static QDPLLAssignment
+qdo_get_value (QDPLL * qdpll, Var * var)
+{
+  assert (QDPLL_VAR_VALUE (qdpll->pcnf, var) == QDPLL_ASSIGNMENT_TRUE ||
+          QDPLL_VAR_VALUE (qdpll->pcnf, var) == QDPLL_ASSIGNMENT_FALSE ||
+          QDPLL_VAR_VALUE (qdpll->pcnf, var) == QDPLL_ASSIGNMENT_UNDEF);
+
+  if (QDPLL_VAR_VALUE (qdpll->pcnf, var) != QDPLL_ASSIGNMENT_UNDEF || !qdpll->qdo_assignment_table)
+    return QDPLL_VAR_VALUE (qdpll->pcnf, var);
   else 
     {
       assert (qdpll->qdo_assignment_table);
@@ -17607,21 +18096,62 @@ qdpll_get_value (QDPLL * qdpll, VarID id)
 }
 
 
-void
-qdpll_print (QDPLL * qdpll, FILE * out)
+
+/* Get assignment of variable.  */
+QDPLLAssignment
+qdpll_get_value (QDPLL * qdpll, VarID id)
 {
   QDPLL_ABORT_QDPLL (!qdpll, "pointer to solver object is null!");
-  QDPLL_ABORT_QDPLL (qdpll->state.decision_level != 0, 
-                     "Unexpected decision level != 0; solver must be in reset state!");
-  QDPLL_ABORT_QDPLL (qdpll->assigned_vars != qdpll->bcp_ptr, 
-                     "Unexpected assignments of variables; solver must be in reset state!");
-  set_up_formula (qdpll);
-#ifndef NDEBUG
-#if QDPLL_ASSERT_FULL_FORMULA_INTEGRITY
-  assert_full_formula_integrity (qdpll);
-#endif
-#endif
-  assert (qdpll->pcnf.clauses.cnt ==
+  QDPLL_ABORT_QDPLL (!qdpll_is_var_declared (qdpll, id), 
+                     "Variable with given ID is not declared!");
+  /* Fix: we do NOT call 'import_user_scopes' here because this will copy
+     scopes and hence destroy the QDAG. see 'qdpll_print_qdimacs_output' for
+     comment. */
+  assert (id);
+  assert (id < qdpll->pcnf.size_vars);
+  Var *var = VARID2VARPTR (qdpll->pcnf.vars, id);
+  QDPLL_ABORT_QDPLL (var->is_internal, "Unexpected internal variable ID.");
+
+  qdo_prepare_values (qdpll);
+  return qdo_get_value (qdpll, var);
+}
+
+
+/* Get assignments of all variables at once. */
+void
+qdpll_get_values (QDPLL * qdpll, QDPLLAssignment * values)
+{
+  QDPLL_ABORT_QDPLL (!qdpll, "pointer to solver object is null!");
+  QDPLL_ABORT_QDPLL (!values, "pointer to array of values is null!");
+
+  qdo_prepare_values (qdpll);
+  VarID id, max_id = qdpll->pcnf.max_declared_user_var_id;
+  Var *vars = qdpll->pcnf.vars;
+  values[0] = QDPLL_ASSIGNMENT_UNDEF;
+  for (id = 1; id <= max_id; id++)
+    {
+      Var *var = VARID2VARPTR (vars, id);
+      values[id] = var->id && !var->is_internal ? 
+        qdo_get_value (qdpll, var) : QDPLL_ASSIGNMENT_UNDEF;
+    }
+}
+
+
+void
+qdpll_print (QDPLL * qdpll, FILE * out)
+{
+  QDPLL_ABORT_QDPLL (!qdpll, "pointer to solver object is null!");
+  QDPLL_ABORT_QDPLL (qdpll->state.decision_level != 0, 
+                     "Unexpected decision level != 0; solver must be in reset state!");
+  QDPLL_ABORT_QDPLL (qdpll->assigned_vars != qdpll->bcp_ptr, 
+                     "Unexpected assignments of variables; solver must be in reset state!");
+  set_up_formula (qdpll);
+#ifndef NDEBUG
+#if QDPLL_ASSERT_FULL_FORMULA_INTEGRITY
+  assert_full_formula_integrity (qdpll);
+#endif
+#endif
+  assert (qdpll->pcnf.clauses.cnt ==
           count_constraints (&(qdpll->pcnf.clauses)));
 
   fprintf (out, "p cnf %d %d\n", qdpll->pcnf.max_declared_user_var_id,
@@ -17669,6 +18199,601 @@ qdpll_print (QDPLL * qdpll, FILE * out)
 }
 
 
+static int
+compare_unsigned (const void *a, const void *b)
+{
+  unsigned int x = *(const unsigned int *) a;
+  unsigned int y = *(const unsigned int *) b;
+  return x < y ? -1 : x > y;
+}
+
+
+/* Write 'num' numbers sorted ascending and as differences to their
+   predecessors. Sorts 'nums' in place. */
+static void
+print_binary_deltas (unsigned int *nums, unsigned int num, FILE * out)
+{
+  qsort (nums, num, sizeof (unsigned int), compare_unsigned);
+  encode_varint (num, out);
+  unsigned int *p, *e, prev = 0;
+  for (p = nums, e = nums + num; p < e; p++)
+    {
+      encode_varint (*p - prev, out);
+      prev = *p;
+    }
+}
+
+
+/* Print the variables of 's' which 'qdpll_print_aux_scope' would print,
+   using 'ids' as buffer. */
+static void
+print_binary_scope (QDPLL * qdpll, Scope * s, VarIDStack * ids, FILE * out)
+{
+  QDPLL_RESET_STACK (*ids);
+  VarID *p, *e;
+  for (p = s->vars.start, e = s->vars.top; p < e; p++)
+    {
+      Var *var = VARID2VARPTR (qdpll->pcnf.vars, *p);
+      if (!s->is_internal || (!var->is_internal && !var->user_scope))
+        QDPLL_PUSH_STACK (qdpll->mm, *ids, *p);
+    }
+  putc (QDPLL_SCOPE_EXISTS (s) ? 'e' : 'a', out);
+  print_binary_deltas (ids->start, QDPLL_COUNT_STACK (*ids), out);
+}
+
+
+/* Collect literals of 'c' which 'qdpll_print' would print, encoded as
+   '2 * var + sign' like in binary traces. Returns their number. */
+static unsigned int
+collect_binary_clause (QDPLL * qdpll, Constraint * c, VarIDStack * codes)
+{
+  QDPLL_RESET_STACK (*codes);
+  LitID *p, *e;
+  for (p = c->lits, e = p + c->num_lits; p < e; p++)
+    {
+      LitID lit = *p;
+      if (!LIT2VARPTR (qdpll->pcnf.vars, lit)->is_internal)
+        QDPLL_PUSH_STACK (qdpll->mm, *codes, (LIT2VARID (lit) << 1) |
+                          QDPLL_LIT_NEG (lit));
+    }
+  return QDPLL_COUNT_STACK (*codes);
+}
+
+
+static int
+is_clause_printed (QDPLL * qdpll, Constraint * c, int skip_blocked)
+{
+  return !clause_has_popped_off_var (qdpll, c)
+    && !clause_has_inactive_var (qdpll, c)
+    && (!skip_blocked || !c->qbcp_qbce_blocked);
+}
+
+
+/* Print formula in binary QDIMACS format, starting with the largest
+   variable ID. Clauses blocked by QBCE are omitted if 'skip_blocked'. */
+static void
+print_binary_formula (QDPLL * qdpll, FILE * out, int skip_blocked)
+{
+  VarIDStack buf;
+  QDPLL_INIT_STACK (buf);
+  Scope *free_scope = qdpll->pcnf.scopes.first, *s;
+  Constraint *c;
+  if (!has_scope_free_user_var (qdpll, free_scope))
+    free_scope = 0;
+
+  /* Header holds counts such that readers can allocate up front. */
+  unsigned int num_scopes = free_scope ? 1 : 0;
+  for (s = qdpll->pcnf.user_scopes.first; s; s = s->link.next)
+    if (QDPLL_COUNT_STACK (s->vars) > 0)
+      num_scopes++;
+  unsigned int num_clauses = 0, num_lits = 0;
+  for (c = qdpll->pcnf.clauses.first; c; c = c->link.next)
+    if (is_clause_printed (qdpll, c, skip_blocked))
+      {
+        num_clauses++;
+        num_lits += collect_binary_clause (qdpll, c, &buf);
+      }
+
+  encode_varint (qdpll->pcnf.max_declared_user_var_id, out);
+  encode_varint (num_scopes, out);
+  encode_varint (num_clauses, out);
+  encode_varint (num_lits, out);
+
+  /* Same scopes as printed by 'qdpll_print'. */
+  if (free_scope)
+    print_binary_scope (qdpll, free_scope, &buf, out);
+  for (s = qdpll->pcnf.user_scopes.first; s; s = s->link.next)
+    if (QDPLL_COUNT_STACK (s->vars) > 0)
+      print_binary_scope (qdpll, s, &buf, out);
+
+  for (c = qdpll->pcnf.clauses.first; c; c = c->link.next)
+    if (is_clause_printed (qdpll, c, skip_blocked))
+      {
+        unsigned int num = collect_binary_clause (qdpll, c, &buf);
+        print_binary_deltas (buf.start, num, out);
+      }
+
+  QDPLL_DELETE_STACK (qdpll->mm, buf);
+}
+
+
+void
+qdpll_print_binary (QDPLL * qdpll, FILE * out)
+{
+  QDPLL_ABORT_QDPLL (!qdpll, "pointer to solver object is null!");
+  QDPLL_ABORT_QDPLL (qdpll->state.decision_level != 0, 
+                     "Unexpected decision level != 0; solver must be in reset state!");
+  QDPLL_ABORT_QDPLL (qdpll->assigned_vars != qdpll->bcp_ptr, 
+                     "Unexpected assignments of variables; solver must be in reset state!");
+  set_up_formula (qdpll);
+
+  fwrite (QDPLL_BINARY_MAGIC, 1, QDPLL_BINARY_MAGIC_LEN, out);
+  encode_varint (QDPLL_BINARY_VERSION, out);
+  print_binary_formula (qdpll, out, 0);
+}
+
+
+void
+qdpll_save_preprocessed (QDPLL * qdpll, FILE * out)
+{
+  QDPLL_ABORT_QDPLL (!qdpll, "pointer to solver object is null!");
+  QDPLL_ABORT_QDPLL (!qdpll->options.qbce_preprocessing, 
+                     "must enable '--qbce-preprocessing' to save preprocessed formula!");
+  QDPLL_ABORT_QDPLL (qdpll->state.num_sat_calls != 0, 
+                     "must save preprocessed formula before solving!");
+  QDPLL_ABORT_QDPLL (qdpll->state.decision_level != 0, 
+                     "Unexpected decision level != 0; solver must be in reset state!");
+  QDPLL_ABORT_QDPLL (qdpll->assigned_vars != qdpll->bcp_ptr, 
+                     "Unexpected assignments of variables; solver must be in reset state!");
+  set_up_formula (qdpll);
+
+  /* Same preprocessing as at the start of 'solve'. The maybe-blocked
+     queue is empty afterwards, hence 'solve' does not repeat it. */
+  assert (!qdpll->state.qbcp_qbce_currently_preprocessing);
+  qdpll->state.qbcp_qbce_currently_preprocessing = 1;
+  qbcp_qbce_find_blocked_clauses (qdpll);
+  qdpll->state.qbcp_qbce_currently_preprocessing = 0;
+
+  fwrite (QDPLL_PREPROCESSED_MAGIC, 1, QDPLL_PREPROCESSED_MAGIC_LEN, out);
+  encode_varint (QDPLL_PREPROCESSED_VERSION, out);
+  encode_varint (QDPLL_PREPROCESSED_QBCE_CLOSED, out);
+  print_binary_formula (qdpll, out, 1);
+}
+
+
+static unsigned int
+decode_varint (const unsigned char **pos, const unsigned char *end)
+{
+  unsigned int x = 0, shift = 0;
+  unsigned char c;
+  do
+    {
+      QDPLL_ABORT_QDPLL (*pos == end || shift > 28, 
+                         "truncated or malformed binary input!");
+      c = *(*pos)++;
+      x |= (unsigned int) (c & 0x7f) << shift;
+      shift += 7;
+    }
+  while (c & 0x80);
+  return x;
+}
+
+
+void
+qdpll_load_preprocessed (QDPLL * qdpll, const char *buf, size_t bytes)
+{
+  QDPLL_ABORT_QDPLL (!qdpll, "pointer to solver object is null!");
+  QDPLL_ABORT_QDPLL (qdpll->pcnf.max_declared_user_var_id != 0 || 
+                     qdpll->pcnf.clauses.cnt != 0, 
+                     "must load preprocessed formula into empty solver!");
+  const unsigned char *pos = (const unsigned char *) buf;
+  const unsigned char *end = pos + bytes;
+  QDPLL_ABORT_QDPLL (bytes < QDPLL_PREPROCESSED_MAGIC_LEN || 
+                     memcmp (buf, QDPLL_PREPROCESSED_MAGIC, 
+                             QDPLL_PREPROCESSED_MAGIC_LEN), 
+                     "malformed header of preprocessed formula!");
+  pos += QDPLL_PREPROCESSED_MAGIC_LEN;
+  QDPLL_ABORT_QDPLL (decode_varint (&pos, end) != QDPLL_PREPROCESSED_VERSION, 
+                     "unsupported version of preprocessed format!");
+  unsigned int flags = decode_varint (&pos, end);
+  unsigned int num_vars = decode_varint (&pos, end);
+  unsigned int num_scopes = decode_varint (&pos, end);
+  unsigned int num_clauses = decode_varint (&pos, end);
+  unsigned int num_lits = decode_varint (&pos, end);
+
+  if (num_vars)
+    qdpll_adjust_vars (qdpll, num_vars);
+
+  LitIDStack lits;
+  QDPLL_INIT_STACK (lits);
+  unsigned int i;
+
+  for (; num_scopes; num_scopes--)
+    {
+      QDPLL_ABORT_QDPLL (pos == end || (*pos != 'a' && *pos != 'e'), 
+                         "expecting scope type!");
+      qdpll_new_scope (qdpll, *pos++ == 'a' ? QDPLL_QTYPE_FORALL : QDPLL_QTYPE_EXISTS);
+      QDPLL_RESET_STACK (lits);
+      VarID id = 0;
+      for (i = decode_varint (&pos, end); i; i--)
+        {
+          id += decode_varint (&pos, end);
+          QDPLL_PUSH_STACK_UNINIT (qdpll->mm, lits, id);
+        }
+      QDPLL_PUSH_STACK_UNINIT (qdpll->mm, lits, 0);
+      qdpll_add_lits (qdpll, lits.start, QDPLL_COUNT_STACK (lits));
+    }
+
+  for (; num_clauses; num_clauses--)
+    {
+      unsigned int code = 0, n = decode_varint (&pos, end);
+      QDPLL_ABORT_QDPLL (n > num_lits, "malformed clause in preprocessed formula!");
+      num_lits -= n;
+      QDPLL_RESET_STACK (lits);
+      for (; n; n--)
+        {
+          code += decode_varint (&pos, end);
+          QDPLL_PUSH_STACK_UNINIT (qdpll->mm, lits, code & 1 ? 
+                                   -(LitID) (code >> 1) : (LitID) (code >> 1));
+        }
+      QDPLL_PUSH_STACK_UNINIT (qdpll->mm, lits, 0);
+      qdpll_add_lits (qdpll, lits.start, QDPLL_COUNT_STACK (lits));
+    }
+
+  QDPLL_DELETE_STACK (qdpll->mm, lits);
+  QDPLL_ABORT_QDPLL (pos != end, "unexpected data after preprocessed formula!");
+
+  /* No clause of the saved formula is blocked. Clauses added later reset
+     this flag in 'import_original_constraint'. */
+  qdpll->state.qbce_closed = (flags & QDPLL_PREPROCESSED_QBCE_CLOSED) != 0;
+}
+
+
+/* Doubles are written as their 64 bits in two variable-length integers,
+   low half first. */
+static void
+encode_double (double d, FILE * out)
+{
+  unsigned long long int bits;
+  assert (sizeof (bits) == sizeof (d));
+  memcpy (&bits, &d, sizeof (bits));
+  encode_varint ((unsigned int) bits, out);
+  encode_varint ((unsigned int) (bits >> 32), out);
+}
+
+
+static double
+decode_double (const unsigned char **pos, const unsigned char *end)
+{
+  unsigned long long int bits = decode_varint (pos, end);
+  bits |= (unsigned long long int) decode_varint (pos, end) << 32;
+  double d;
+  memcpy (&d, &bits, sizeof (d));
+  return d;
+}
+
+
+static unsigned int
+checkpoint_mix (unsigned int x)
+{
+  x ^= x >> 16;
+  x *= 0x7feb352dU;
+  x ^= x >> 15;
+  x *= 0x846ca68bU;
+  x ^= x >> 16;
+  return x;
+}
+
+
+/* Hash of the original clauses which does not depend on the order of
+   clauses and literals, since a checkpoint must match the formula it is
+   loaded for. */
+static unsigned int
+checkpoint_fingerprint (QDPLL * qdpll)
+{
+  unsigned int result = 0;
+  Constraint *c;
+  LitID *p, *e;
+  for (c = qdpll->pcnf.clauses.first; c; c = c->link.next)
+    {
+      unsigned int h = c->num_lits;
+      for (p = c->lits, e = p + c->num_lits; p < e; p++)
+        h += checkpoint_mix ((unsigned int) *p);
+      result += checkpoint_mix (h);
+    }
+  return result;
+}
+
+
+/* Options which learned constraints depend on. Cubes learned by dynamic
+   QBCE or under a dependency scheme are not valid otherwise. */
+static unsigned int
+checkpoint_config (QDPLL * qdpll)
+{
+  return qdpll->options.depman_qdag
+    | qdpll->options.no_qbce_dynamic << 1
+    | qdpll->options.qbce_preprocessing << 2
+    | qdpll->options.qbce_inprocessing << 3
+    | qdpll->options.long_dist_res << 4
+    | qdpll->options.depman_rrs << 5;
+}
+
+
+static void
+check_checkpoint_usage (QDPLL * qdpll)
+{
+  QDPLL_ABORT_QDPLL (qdpll->options.incremental_use, 
+                     "checkpoints are not supported in incremental use!");
+  QDPLL_ABORT_QDPLL (qdpll->options.trace, 
+                     "checkpoints are not supported with tracing!");
+}
+
+
+static void
+save_checkpoint_constraints (QDPLL * qdpll, ConstraintList * constraints,
+                             FILE * out)
+{
+  unsigned int cnt = 0;
+  Constraint *c;
+  LitID *p, *e;
+  for (c = constraints->first; c; c = c->link.next)
+    if (c->learnt)
+      cnt++;
+  encode_varint (cnt, out);
+  for (c = constraints->first; c; c = c->link.next)
+    if (c->learnt)
+      {
+        encode_varint (c->num_lits, out);
+        for (p = c->lits, e = p + c->num_lits; p < e; p++)
+          encode_varint (QDPLL_LIT_NEG (*p) ? 
+                         ((unsigned int) -*p << 1) | 1 : 
+                         (unsigned int) *p << 1, out);
+      }
+}
+
+
+void
+qdpll_save_checkpoint (QDPLL * qdpll, FILE * out)
+{
+  QDPLL_ABORT_QDPLL (!qdpll, "pointer to solver object is null!");
+  check_checkpoint_usage (qdpll);
+
+  fwrite (QDPLL_CHECKPOINT_MAGIC, 1, QDPLL_CHECKPOINT_MAGIC_LEN, out);
+  encode_varint (QDPLL_CHECKPOINT_VERSION, out);
+  encode_varint (checkpoint_config (qdpll), out);
+  encode_varint (qdpll->pcnf.max_declared_user_var_id, out);
+  encode_varint (qdpll->pcnf.clauses.cnt, out);
+  encode_varint (checkpoint_fingerprint (qdpll), out);
+
+  encode_varint ((unsigned int) qdpll->options.seed, out);
+  encode_varint (qdpll->state.num_decisions, out);
+  encode_varint (qdpll->state.num_backtracks, out);
+  encode_varint (qdpll->state.num_restarts, out);
+  encode_varint (qdpll->state.num_inner_restarts, out);
+  encode_varint (qdpll->state.last_backtracks, out);
+  encode_varint (qdpll->state.num_restart_resets, out);
+  encode_varint (qdpll->state.irestart_dist, out);
+  encode_varint (qdpll->state.orestart_dist, out);
+  encode_varint (qdpll->state.lclauses_size, out);
+  encode_varint (qdpll->state.lcubes_size, out);
+  encode_varint (qdpll->state.clause_resizes, out);
+  encode_varint (qdpll->state.cube_resizes, out);
+  encode_double (qdpll->state.var_act_inc, out);
+
+  VarID id;
+  for (id = 1; id <= qdpll->pcnf.max_declared_user_var_id; id++)
+    encode_double (VARID2VARPTR (qdpll->pcnf.vars, id)->priority, out);
+
+  save_checkpoint_constraints (qdpll, &qdpll->pcnf.learnt_clauses, out);
+  save_checkpoint_constraints (qdpll, &qdpll->pcnf.learnt_cubes, out);
+}
+
+
+/* Called at safe points of 'solve' where no constraint is being
+   learned. */
+static int
+checkpoint_due (QDPLL * qdpll)
+{
+  if (qdpll->checkpoint_request)
+    return 1;
+  if (!qdpll->checkpoint_secs || qdpll->state.num_backtracks - 
+      qdpll->state.checkpoint_poll_backtracks < CHECKPOINT_POLL_BACKTRACKS)
+    return 0;
+  qdpll->state.checkpoint_poll_backtracks = qdpll->state.num_backtracks;
+  return time_stamp () - qdpll->state.last_checkpoint_time >= 
+    qdpll->checkpoint_secs;
+}
+
+
+static void
+write_checkpoint_file (QDPLL * qdpll)
+{
+  QDPLLMemMan *mm = qdpll->mm;
+  const char *path = qdpll->checkpoint_path;
+  size_t bytes = strlen (path) + strlen (".tmp") + 1;
+  char *tmp = qdpll_malloc (mm, bytes);
+  sprintf (tmp, "%s.tmp", path);
+  FILE *out = fopen (tmp, "wb");
+  QDPLL_ABORT_QDPLL (!out, "could not open checkpoint file!");
+  qdpll_save_checkpoint (qdpll, out);
+  QDPLL_ABORT_QDPLL (fclose (out) != 0 || rename (tmp, path) != 0, 
+                     "could not write checkpoint file!");
+  qdpll_free (mm, tmp, bytes);
+  qdpll->state.last_checkpoint_time = time_stamp ();
+  if (qdpll->options.verbosity > 0)
+    fprintf (stderr, "Checkpoint written to '%s'.\n", path);
+}
+
+
+void
+qdpll_set_checkpoint (QDPLL * qdpll, const char *path, unsigned int secs)
+{
+  QDPLL_ABORT_QDPLL (!qdpll, "pointer to solver object is null!");
+  QDPLL_ABORT_QDPLL (!path, "pointer to checkpoint file name is null!");
+  check_checkpoint_usage (qdpll);
+  if (qdpll->checkpoint_path)
+    qdpll_free (qdpll->mm, qdpll->checkpoint_path, 
+                strlen (qdpll->checkpoint_path) + 1);
+  qdpll->checkpoint_path = qdpll_malloc (qdpll->mm, strlen (path) + 1);
+  strcpy (qdpll->checkpoint_path, path);
+  qdpll->checkpoint_secs = secs;
+}
+
+
+void
+qdpll_request_checkpoint (QDPLL * qdpll, int stop)
+{
+  /* No assertions or aborts: called from signal handlers. */
+  qdpll->checkpoint_request = stop ? 2 : 1;
+}
+
+
+void
+qdpll_load_checkpoint (QDPLL * qdpll, const char *buf, size_t bytes)
+{
+  QDPLL_ABORT_QDPLL (!qdpll, "pointer to solver object is null!");
+  check_checkpoint_usage (qdpll);
+  QDPLL_ABORT_QDPLL (qdpll->state.num_sat_calls != 0 || qdpll->resume_buf, 
+                     "must load checkpoint once before solving!");
+  const unsigned char *pos = (const unsigned char *) buf;
+  const unsigned char *end = pos + bytes;
+  QDPLL_ABORT_QDPLL (bytes < QDPLL_CHECKPOINT_MAGIC_LEN || 
+                     memcmp (buf, QDPLL_CHECKPOINT_MAGIC, 
+                             QDPLL_CHECKPOINT_MAGIC_LEN), 
+                     "malformed header of checkpoint!");
+  pos += QDPLL_CHECKPOINT_MAGIC_LEN;
+  QDPLL_ABORT_QDPLL (decode_varint (&pos, end) != QDPLL_CHECKPOINT_VERSION, 
+                     "unsupported version of checkpoint!");
+  /* The formula is set up by 'qdpll_sat', hence the checkpoint is kept
+     until then. */
+  qdpll->resume_buf = qdpll_malloc (qdpll->mm, bytes);
+  memcpy (qdpll->resume_buf, buf, bytes);
+  qdpll->resume_bytes = bytes;
+}
+
+
+static void
+import_checkpoint_constraints (QDPLL * qdpll, const unsigned char **pos, 
+                               const unsigned char *end, int is_cube)
+{
+  const VarID max_id = qdpll->pcnf.max_declared_user_var_id;
+  unsigned int cnt = decode_varint (pos, end);
+  for (; cnt; cnt--)
+    {
+      unsigned int num_lits = decode_varint (pos, end);
+      QDPLL_ABORT_QDPLL (num_lits == 0 || num_lits > max_id, 
+                         "malformed constraint in checkpoint!");
+      Constraint *c = create_learnt_constraint (qdpll, num_lits, is_cube);
+      c->learnt = 1;
+      LitID *p, *e;
+      for (p = c->lits, e = p + num_lits; p < e; p++)
+        {
+          unsigned int code = decode_varint (pos, end);
+          VarID id = code >> 1;
+          QDPLL_ABORT_QDPLL (id == 0 || id > max_id || 
+                             !VARID2VARPTR (qdpll->pcnf.vars, id)->id, 
+                             "malformed constraint in checkpoint!");
+          *p = code & 1 ? -(LitID) id : (LitID) id;
+        }
+      /* Keep the order of the lists, which reflects recent use. */
+      if (is_cube)
+        LINK_LAST (qdpll->pcnf.learnt_cubes, c, link);
+      else
+        LINK_LAST (qdpll->pcnf.learnt_clauses, c, link);
+    }
+}
+
+
+/* Called by 'solve' before watchers and dependencies are initialized,
+   hence the imported constraints are watched like any learned ones and
+   variables enter the priority queue with their saved activities. */
+static void
+import_checkpoint (QDPLL * qdpll)
+{
+  const unsigned char *pos = qdpll->resume_buf;
+  const unsigned char *end = pos + qdpll->resume_bytes;
+  pos += QDPLL_CHECKPOINT_MAGIC_LEN;
+  decode_varint (&pos, end);
+  QDPLL_ABORT_QDPLL (decode_varint (&pos, end) != checkpoint_config (qdpll), 
+                     "checkpoint was written with different options!");
+  unsigned int num_vars = decode_varint (&pos, end);
+  unsigned int num_clauses = decode_varint (&pos, end);
+  QDPLL_ABORT_QDPLL (num_vars != qdpll->pcnf.max_declared_user_var_id || 
+                     num_clauses != qdpll->pcnf.clauses.cnt || 
+                     decode_varint (&pos, end) != checkpoint_fingerprint (qdpll), 
+                     "checkpoint does not match formula!");
+
+  qdpll->options.seed = (int) decode_varint (&pos, end);
+  srand (qdpll->options.seed);
+  qdpll->state.num_decisions = decode_varint (&pos, end);
+  qdpll->state.num_backtracks = decode_varint (&pos, end);
+  qdpll->state.num_restarts = decode_varint (&pos, end);
+  qdpll->state.num_inner_restarts = decode_varint (&pos, end);
+  qdpll->state.last_backtracks = decode_varint (&pos, end);
+  qdpll->state.num_restart_resets = decode_varint (&pos, end);
+  qdpll->state.irestart_dist = decode_varint (&pos, end);
+  qdpll->state.orestart_dist = decode_varint (&pos, end);
+  unsigned int lclauses_size = decode_varint (&pos, end);
+  unsigned int lcubes_size = decode_varint (&pos, end);
+  qdpll->state.clause_resizes = decode_varint (&pos, end);
+  qdpll->state.cube_resizes = decode_varint (&pos, end);
+  qdpll->state.var_act_inc = decode_double (&pos, end);
+
+  VarID id;
+  for (id = 1; id <= num_vars; id++)
+    {
+      Var *var = VARID2VARPTR (qdpll->pcnf.vars, id);
+      double priority = decode_double (&pos, end);
+      if (var->id)
+        {
+          assert (var->priority_pos == QDPLL_INVALID_PQUEUE_POS);
+          var->priority = priority;
+        }
+    }
+
+  assert (qdpll->pcnf.learnt_clauses.cnt == 0);
+  assert (qdpll->pcnf.learnt_cubes.cnt == 0);
+  import_checkpoint_constraints (qdpll, &pos, end, 0);
+  import_checkpoint_constraints (qdpll, &pos, end, 1);
+  QDPLL_ABORT_QDPLL (pos != end, "unexpected data after checkpoint!");
+
+  /* Sizes may have been exceeded right before a reduction. */
+  qdpll->state.lclauses_size = lclauses_size < qdpll->pcnf.learnt_clauses.cnt ? 
+    qdpll->pcnf.learnt_clauses.cnt : lclauses_size;
+  qdpll->state.lcubes_size = lcubes_size < qdpll->pcnf.learnt_cubes.cnt ? 
+    qdpll->pcnf.learnt_cubes.cnt : lcubes_size;
+  qdpll->state.checkpoint_poll_backtracks = qdpll->state.num_backtracks;
+
+  qdpll_free (qdpll->mm, qdpll->resume_buf, qdpll->resume_bytes);
+  qdpll->resume_buf = 0;
+  qdpll->resume_bytes = 0;
+
+  if (qdpll->options.verbosity > 0)
+    fprintf (stderr, "Resumed with %u learned clauses and %u learned cubes.\n", 
+             qdpll->pcnf.learnt_clauses.cnt, qdpll->pcnf.learnt_cubes.cnt);
+}
+
+
+/* Decimal digits of the largest unsigned int. */
+#define QDPLL_UINT_DIGITS 10
+
+/* Write 'x' in decimal to 'pos' and return the position after it. */
+static char *
+qdo_put_uint (char *pos, unsigned int x)
+{
+  char digits[QDPLL_UINT_DIGITS], *p = digits;
+  do
+    {
+      *p++ = '0' + x % 10;
+      x /= 10;
+    }
+  while (x);
+  while (p > digits)
+    *pos++ = *--p;
+  return pos;
+}
+
+
 /* Print QDIMACS-compliant output to stdout as defined at:
    http://www.qbflib.org/qdimacs.html */
 void
@@ -17690,9 +18815,6 @@ qdpll_print_qdimacs_output (QDPLL * qdpll)
   else
     QDPLL_ABORT_QDPLL (1, "invalid result!");
 
-  fprintf (stdout, "s cnf %s %d %d\n", res_string,
-           qdpll->pcnf.max_declared_user_var_id, qdpll->pcnf.clauses.cnt);
-
   Scope *outer;
   assert (qdpll->pcnf.scopes.first);
   if (!qdpll->pcnf.user_scopes.first)
@@ -17700,7 +18822,7 @@ qdpll_print_qdimacs_output (QDPLL * qdpll)
       /* Formula is propositional; when unsatisfiable then cannot print
          countermodel. */
       if (result == QDPLL_RESULT_UNSAT)
-        return;
+        outer = 0;
       else
         outer = qdpll->pcnf.scopes.first;
     }
@@ -17714,7 +18836,7 @@ qdpll_print_qdimacs_output (QDPLL * qdpll)
              leftmost. */
           if (qdpll->pcnf.user_scopes.first->type == QDPLL_QTYPE_EXISTS || 
               has_scope_free_user_var (qdpll, qdpll->pcnf.scopes.first))
-            return;
+            outer = 0;
           else
             outer = qdpll->pcnf.user_scopes.first;
         }
@@ -17726,7 +18848,7 @@ qdpll_print_qdimacs_output (QDPLL * qdpll)
              variables. */
           if (qdpll->pcnf.user_scopes.first->type == QDPLL_QTYPE_FORALL && 
               !has_scope_free_user_var (qdpll, qdpll->pcnf.scopes.first))
-            return;
+            outer = 0;
           else
             {
               outer = qdpll->pcnf.scopes.first;
@@ -17740,22 +18862,56 @@ qdpll_print_qdimacs_output (QDPLL * qdpll)
         }
     }
 
-  Var *vars = qdpll->pcnf.vars;
-  VarID *p, *e;
-  for (p = outer->vars.start, e = outer->vars.top; p < e; p++)
+  /* The output is formatted in one buffer and written at once. A line
+     takes at most 4 bytes besides the digits of a variable ID. */
+  const VarID max_id = qdpll->pcnf.max_declared_user_var_id;
+  size_t bytes = 3 * (QDPLL_UINT_DIGITS + 1) + strlen ("s cnf ");
+  if (outer)
+    bytes += QDPLL_COUNT_STACK (outer->vars) * (QDPLL_UINT_DIGITS + 5);
+  char *buf = qdpll_malloc (qdpll->mm, bytes), *pos = buf;
+
+  memcpy (pos, "s cnf ", strlen ("s cnf "));
+  pos += strlen ("s cnf ");
+  memcpy (pos, res_string, strlen (res_string));
+  pos += strlen (res_string);
+  *pos++ = ' ';
+  pos = qdo_put_uint (pos, max_id);
+  *pos++ = ' ';
+  pos = qdo_put_uint (pos, qdpll->pcnf.clauses.cnt);
+  *pos++ = '\n';
+
+  if (outer)
     {
-      assert (*p);
-      VarID id = *p;
-      Var *var = VARID2VARPTR (vars, id);
-      assert (!var->id || var->id == id);
-      QDPLLAssignment a;
-      /* FIX: Do not print assignments of internal variables, ignore also
-         reset internal variables. */
-      if ((!var->is_internal && id <= qdpll_get_max_declared_var_id (qdpll)) && 
-          (a = qdpll_get_value (qdpll, id)) != QDPLL_ASSIGNMENT_UNDEF)
-        fprintf (stdout, "V %d 0\n", 
-                 a == QDPLL_ASSIGNMENT_FALSE ? -id : id);
+      qdo_prepare_values (qdpll);
+      Var *vars = qdpll->pcnf.vars;
+      VarID *p, *e;
+      for (p = outer->vars.start, e = outer->vars.top; p < e; p++)
+        {
+          assert (*p);
+          VarID id = *p;
+          Var *var = VARID2VARPTR (vars, id);
+          assert (!var->id || var->id == id);
+          QDPLLAssignment a;
+          /* FIX: Do not print assignments of internal variables, ignore also
+             reset internal variables. */
+          if ((!var->is_internal && id <= max_id) && 
+              (a = qdo_get_value (qdpll, var)) != QDPLL_ASSIGNMENT_UNDEF)
+            {
+              *pos++ = 'V';
+              *pos++ = ' ';
+              if (a == QDPLL_ASSIGNMENT_FALSE)
+                *pos++ = '-';
+              pos = qdo_put_uint (pos, id);
+              *pos++ = ' ';
+              *pos++ = '0';
+              *pos++ = '\n';
+            }
+        }
     }
+
+  assert ((size_t) (pos - buf) <= bytes);
+  fwrite (buf, 1, pos - buf, stdout);
+  qdpll_free (qdpll->mm, buf, bytes);
 }
 
 
@@ -17971,6 +19127,24 @@ qdpll_dump_dep_graph (QDPLL * qdpll)
 }
 
 
+/* Print current and peak memory usage per category to 'out'. */
+void
+qdpll_print_mem_stats (QDPLL * qdpll, FILE * out)
+{
+  QDPLL_ABORT_QDPLL (!qdpll, "pointer to solver object is null!");
+  qdpll_mem_print_stats (qdpll->mm, out);
+}
+
+
+int
+qdpll_drain_trace (QDPLL * qdpll)
+{
+  QDPLL_ABORT_QDPLL (!qdpll, "pointer to solver object is null!");
+  return !qdpll->trace_writer ||
+    qdpll_trace_writer_drain (qdpll->trace_writer);
+}
+
+
 void
 qdpll_print_stats (QDPLL * qdpll)
 {
@@ -18636,6 +19810,7 @@ qdpll_reset (QDPLL * qdpll)
     }
 
   qdpll->state.qdo_no_schedule_model_reconstruction = 0;
+  qdpll->state.qdo_values_prepared = 0;
 
   qdpll->result = QDPLL_RESULT_UNKNOWN;
   qdpll->result_constraint = 0;
@@ -18799,6 +19974,9 @@ void qdpll_reset_learned_constraints (QDPLL * qdpll)
 
   /* Discard all collected cover sets. */
   discard_all_collected_cover_sets (qdpll);
+
+  compact_learnt_constraints (qdpll);
+  qdpll_slab_release (qdpll->mm);
 }
 
 /* -------------------- END: PUBLIC FUNCTIONS --------------------*/
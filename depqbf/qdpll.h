@@ -244,15 +244,96 @@ int qdpll_has_var_active_occs (QDPLL *qdpll, VarID id);
    below. */
 void qdpll_add (QDPLL * qdpll, LitID id);
 
+/* Same as calling 'qdpll_add' for each of the 'num' IDs in 'ids', in
+   order. Intended for parsers which add many literals at once. */
+void qdpll_add_lits (QDPLL * qdpll, const LitID * ids, unsigned int num);
+
 /* Solve the formula. */
 QDPLLResult qdpll_sat (QDPLL * qdpll);
 
 /* Get assignment of variable. */
 QDPLLAssignment qdpll_get_value (QDPLL * qdpll, VarID id);
 
+/* Get assignments of all variables at once: 'values' must hold
+   'qdpll_get_max_declared_var_id () + 1' elements. Element 'id' is set to
+   the value 'qdpll_get_value' returns for 'id' or to
+   'QDPLL_ASSIGNMENT_UNDEF' if 'id' is not declared. Element 0 is unused. */
+void qdpll_get_values (QDPLL * qdpll, QDPLLAssignment * values);
+
 /* Print QBF to 'out' using QDIMACS format. */
 void qdpll_print (QDPLL * qdpll, FILE * out);
 
+/* Binary QDIMACS format. All numbers are written as variable-length
+   integers like in binary traces: groups of 7 bits, least significant
+   first, highest bit of a byte set if more bytes follow. A file starts
+   with 'QDPLL_BINARY_MAGIC', followed by version, largest variable ID,
+   number of scopes, clauses and literals in clauses. Then each scope
+   follows as character 'a' or 'e' and each clause follows. Both are
+   written as the number of elements followed by the elements in
+   ascending order as differences to their predecessors (the first to
+   zero). Elements are variable IDs for scopes and '2 * var + sign' for
+   clauses, where sign is 1 for negative literals. */
+#define QDPLL_BINARY_MAGIC "\0BQD"
+#define QDPLL_BINARY_MAGIC_LEN 4
+#define QDPLL_BINARY_VERSION 1
+
+/* Print QBF to 'out' using binary QDIMACS format. */
+void qdpll_print_binary (QDPLL * qdpll, FILE * out);
+
+/* Preprocessed formulae use the binary QDIMACS format with magic
+   'QDPLL_PREPROCESSED_MAGIC' and an additional field of flags after the
+   version. They hold only the reduced formula after static QBCE
+   preprocessing, that is, without the clauses found blocked. No other
+   solver state like the dependency graph or watchers is saved. */
+#define QDPLL_PREPROCESSED_MAGIC "\0BQP"
+#define QDPLL_PREPROCESSED_MAGIC_LEN 4
+#define QDPLL_PREPROCESSED_VERSION 1
+/* Flag set if no clause of the formula is blocked. */
+#define QDPLL_PREPROCESSED_QBCE_CLOSED 1
+
+/* Run static QBCE preprocessing and write the reduced formula to 'out'.
+   Requires '--qbce-preprocessing', because blocked clauses found by
+   dynamic QBCE or inprocessing may be unblocked again during search. Must
+   be called before 'qdpll_sat'. Solving can be continued afterwards. */
+void qdpll_save_preprocessed (QDPLL * qdpll, FILE * out);
+
+/* Add the reduced formula 'buf' of size 'bytes' written by
+   'qdpll_save_preprocessed', e.g. a mapped file, to an empty solver. With
+   '--qbce-preprocessing', the first call of 'qdpll_sat' then skips static
+   QBCE. In other configurations, it is solved like any other formula. */
+void qdpll_load_preprocessed (QDPLL * qdpll, const char *buf, size_t bytes);
+
+/* Checkpoints hold the state needed to continue an interrupted run of
+   'qdpll_sat' without losing what was learned: learned clauses and cubes,
+   variable activities, restart distances and the seed. They use the
+   variable-length integers of the binary QDIMACS format after magic
+   'QDPLL_CHECKPOINT_MAGIC'. The trail is not saved, hence resuming is like
+   a restart. A checkpoint is only valid for the same formula and
+   configuration and cannot be used in incremental mode or with tracing. */
+#define QDPLL_CHECKPOINT_MAGIC "\0BQC"
+#define QDPLL_CHECKPOINT_MAGIC_LEN 4
+#define QDPLL_CHECKPOINT_VERSION 1
+
+/* Write a checkpoint to file 'path' during 'qdpll_sat' every 'secs'
+   seconds of process time and on requests by
+   'qdpll_request_checkpoint'. No timer is used if 'secs' is 0. The file
+   is replaced atomically by renaming a temporary file 'path.tmp'. */
+void qdpll_set_checkpoint (QDPLL * qdpll, const char *path, unsigned int secs);
+
+/* Let 'qdpll_sat' write a checkpoint at the next safe point. If 'stop' is
+   non-zero then 'qdpll_sat' returns 'QDPLL_RESULT_UNKNOWN' afterwards. Can
+   be called from a signal handler. */
+void qdpll_request_checkpoint (QDPLL * qdpll, int stop);
+
+/* Write a checkpoint of the current state to 'out'. */
+void qdpll_save_checkpoint (QDPLL * qdpll, FILE * out);
+
+/* Continue from checkpoint 'buf' of size 'bytes' written by
+   'qdpll_save_checkpoint' or 'qdpll_set_checkpoint'. Must be called after
+   the formula was added and before the first call of 'qdpll_sat', which
+   imports the checkpoint. */
+void qdpll_load_checkpoint (QDPLL * qdpll, const char *buf, size_t bytes);
+
 /* Print QDIMACS-compliant output. */
 void qdpll_print_qdimacs_output (QDPLL * qdpll);
 
@@ -306,9 +387,20 @@ QDPLLQuantifierType qdpll_get_scope_type (QDPLL *qdpll, Nesting nesting);
 /* Dump dependency graph to 'stdout' in DOT format. */
 void qdpll_dump_dep_graph (QDPLL * qdpll);
 
+/* Write buffered trace data before the process terminates abnormally.
+   Intended for signal handlers of the thread calling 'qdpll_sat'. The
+   last record of the trace may be incomplete. Returns zero if buffered
+   data could not be written because the signal arrived while a trace
+   buffer was handed over. */
+int qdpll_drain_trace (QDPLL * qdpll);
+
 /* Print statistics to 'stderr'. */
 void qdpll_print_stats (QDPLL * qdpll);
 
+/* Print current and peak memory usage to 'out', split into categories
+   like learned clauses, QDAG or QBCE. */
+void qdpll_print_mem_stats (QDPLL * qdpll, FILE * out);
+
 /* Reset internal solver state, keep clauses and variables. */
 void qdpll_reset (QDPLL * qdpll);
 
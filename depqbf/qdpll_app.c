@@ -23,6 +23,9 @@
  along with DepQBF.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+/* For 'fileno', 'mmap', 'posix_madvise' and 'fork' under '-std=c99'. */
+#define _POSIX_C_SOURCE 200112L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <ctype.h>
@@ -34,6 +37,12 @@
 #include <signal.h>
 #include <unistd.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <pthread.h>
 #include "qdpll.h"
 #include "qdpll_internals.h"
 
@@ -54,6 +63,7 @@
 "usage: depqbf [ <option> ... ] [ <in-file> ]\n"\
 "\n"\
 "  where <in-file> is a file in (Q)DIMACS format (default: stdin)\n"\
+"  which may be compressed by gzip, xz or bzip2\n"\
 "  and <option> is any combination of the following:\n"\
 "\n"\
 "  Note: see function 'qdpll_configure' in file 'qdpll.c' for further, undocumented\n"\
@@ -96,7 +106,9 @@
 #define USAGE2 \
 "  --dep-man=<val>                 set dependency manager: if <val>=qdag (default) then the solver\n"\
 "                                    uses the standard dependency scheme; if <val>=simple then the\n"\
-"                                    solver uses the given quantifier prefix of the input formula\n"	\
+"                                    solver uses the given quantifier prefix of the input formula;\n"	\
+"                                    if <val>=rrs then the solver uses the reflexive resolution-path\n"\
+"                                    dependency scheme, which must be combined with '--no-qbce-dynamic'\n"\
 "  --no-cdcl                       disable conflict-driven clause learning and\n"\
 "                                    backtrack chronologically from conflicts\n"\
 "  --no-sdcl                       disable solution-driven cube learning and\n"\
@@ -117,6 +129,21 @@
 "  --max-dec=<val>                 Abort after <val> assignments by decision making.\n"\
 "  --max-btracks=<val>             Abort after <val> backtracks.\n"\
 "  --max-secs=<val>                Abort after <val> seconds.\n"\
+"  --max-space=<val>               Limit memory to <val> MB, discard learned constraints close to the limit\n"\
+"                                    and stop with result unknown if that does not suffice.\n"\
+"  --print-mem-stats               print current and peak memory usage per category to <stderr>\n"\
+"  --parse-threads=<val>           tokenise clauses of mapped input files by <val> threads\n"\
+"  --write-binary=<file>           write the parsed formula to <file> in binary QDIMACS format and exit.\n"\
+"                                    Binary input files are detected automatically.\n"\
+"  --write-preprocessed=<file>     write the formula reduced by static QBCE to <file> and exit.\n"\
+"                                    Requires '--qbce-preprocessing'. Preprocessed files are detected\n"\
+"                                    automatically. QBCE is not repeated if they are loaded with\n"\
+"                                    '--qbce-preprocessing'.\n"\
+"  --checkpoint=<file>             write learned constraints and heuristic state to <file> when\n"\
+"                                    receiving SIGTERM and stop. A second SIGTERM stops right away.\n"\
+"  --checkpoint-interval=<val>     also write the checkpoint every <val> seconds\n"\
+"  --resume=<file>                 continue from checkpoint <file> written for the same formula\n"\
+"                                    and options\n"\
 "\n"\
 "Options that control QBCE:"\
 "\n"\
@@ -155,6 +182,13 @@ struct QDPLLApp
     int print_deps;
     int dump_dep_graph;
     int trace;
+    int print_mem_stats;
+    unsigned int parse_threads;
+    char *binary_out_filename;
+    char *preprocessed_out_filename;
+    char *checkpoint_filename;
+    unsigned int checkpoint_interval;
+    char *resume_filename;
     unsigned int max_time;
     unsigned int verbosity;
     unsigned int print_usage;
@@ -168,6 +202,9 @@ typedef struct QDPLLApp QDPLLApp;
    used for calling library functions from within a signal handler. */
 static QDPLL *qdpll = 0;
 
+/* Set if SIGTERM should be answered by writing a checkpoint. */
+static volatile sig_atomic_t checkpoint_on_sigterm = 0;
+
 static void
 print_abort_err (QDPLLApp * app, char *msg, ...)
 {
@@ -184,45 +221,515 @@ print_abort_err (QDPLLApp * app, char *msg, ...)
 
 
 /* -------------------- START: PARSING -------------------- */
+
+/* Size of buffer used if input can not be mapped into memory. */
+#define PARSER_BUF_SIZE (1 << 20)
+
+/* Input of the parser. Regular files are mapped into memory and
+   tokenised in place. Pipes and terminals are read in large blocks into
+   'buf', which is refilled when exhausted. */
+struct QDPLLAppReader
+{
+  const unsigned char *pos;
+  const unsigned char *end;
+  /* Null if input is mapped. */
+  FILE *in;
+  unsigned char *buf;
+  void *map;
+  size_t map_size;
+  /* Child process decompressing the input into 'in', if any. */
+  pid_t decompressor;
+  /* Child process writing buffered input to the decompressor, if any. */
+  pid_t feeder;
+  /* Number of threads tokenising the matrix of mapped input. */
+  unsigned int num_threads;
+  /* Literals of the current clause or scope, passed to the solver by one
+     call of 'qdpll_add_lits'. */
+  LitID *lits;
+  unsigned int lits_cnt;
+  unsigned int lits_size;
+};
+
+typedef struct QDPLLAppReader QDPLLAppReader;
+
+/* Compressed input is recognised by its magic bytes and decompressed by
+   the respective program running as child process. */
+static const struct
+{
+  const char *magic;
+  unsigned int len;
+  const char *prog;
+} decompressors[] = {
+  {"\x1f\x8b", 2, "gzip"},
+  {"\xfd" "7zXZ\0", 6, "xz"},
+  {"BZh", 3, "bzip2"},
+};
+
+static const char *
+get_decompressor (const unsigned char *start, size_t bytes)
+{
+  unsigned int i;
+  for (i = 0; i < sizeof (decompressors) / sizeof (decompressors[0]); i++)
+    if (bytes >= decompressors[i].len
+        && !memcmp (start, decompressors[i].magic, decompressors[i].len))
+      return decompressors[i].prog;
+  return 0;
+}
+
+/* Start 'prog' decompressing the data read from 'fd'. Returns stream of
+   decompressed data. */
+static FILE *
+start_decompressor (QDPLLAppReader * r, int fd, const char *prog)
+{
+  int fds[2];
+  QDPLL_ABORT_APP (pipe (fds), "could not create pipe!\n");
+  pid_t pid = fork ();
+  QDPLL_ABORT_APP (pid < 0, "could not start decompressor!\n");
+  if (!pid)
+    {
+      dup2 (fd, 0);
+      dup2 (fds[1], 1);
+      close (fds[0]);
+      close (fds[1]);
+      execlp (prog, prog, "-dc", (char *) 0);
+      fprintf (stderr, "[QDPLL-APP] could not execute '%s'\n", prog);
+      _exit (127);
+    }
+  close (fds[1]);
+  r->decompressor = pid;
+  FILE *in = fdopen (fds[0], "r");
+  QDPLL_ABORT_APP (!in, "could not open pipe!\n");
+  return in;
+}
+
+/* Start 'prog' decompressing 'in', of which the first 'bytes' bytes have
+   already been read into 'r->buf', e.g. from a pipe. These bytes and the
+   rest of 'in' are written to the decompressor by a child process, which
+   reuses its copy of 'r->buf' for copying. */
+static FILE *
+start_fed_decompressor (QDPLLAppReader * r, FILE * in, size_t bytes,
+                        const char *prog)
+{
+  int fds[2];
+  QDPLL_ABORT_APP (pipe (fds), "could not create pipe!\n");
+  pid_t pid = fork ();
+  QDPLL_ABORT_APP (pid < 0, "could not start decompressor!\n");
+  if (!pid)
+    {
+      close (fds[0]);
+      FILE *out = fdopen (fds[1], "w");
+      if (!out)
+        _exit (1);
+      while (bytes && fwrite (r->buf, 1, bytes, out) == bytes)
+        bytes = fread (r->buf, 1, PARSER_BUF_SIZE, in);
+      /* Do not flush buffers inherited from the parent by 'exit'. */
+      _exit (bytes || ferror (in) || fclose (out) ? 1 : 0);
+    }
+  close (fds[1]);
+  r->feeder = pid;
+  FILE *result = start_decompressor (r, fds[0], prog);
+  close (fds[0]);
+  return result;
+}
+
+static void
+reader_open (QDPLLAppReader * r, FILE * in)
+{
+  memset (r, 0, sizeof (QDPLLAppReader));
+  int fd = fileno (in);
+  struct stat st;
+  const char *prog;
+  /* Mapping starts at offset zero, hence input must not have been read. */
+  if (fd >= 0 && !fstat (fd, &st) && S_ISREG (st.st_mode) && st.st_size > 0
+      && lseek (fd, 0, SEEK_CUR) == 0)
+    {
+      void *map = mmap (0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (map != MAP_FAILED)
+        {
+          if (!(prog = get_decompressor (map, st.st_size)))
+            {
+              posix_madvise (map, st.st_size, POSIX_MADV_SEQUENTIAL);
+              r->map = map;
+              r->map_size = st.st_size;
+              r->pos = (const unsigned char *) map;
+              r->end = r->pos + r->map_size;
+              return;
+            }
+          munmap (map, st.st_size);
+          in = start_decompressor (r, fd, prog);
+        }
+    }
+  r->in = in;
+  r->buf = (unsigned char *) malloc (PARSER_BUF_SIZE);
+  QDPLL_ABORT_APP (!r->buf, "could not allocate memory!");
+  r->pos = r->buf;
+  r->end = r->buf + fread (r->buf, 1, PARSER_BUF_SIZE, r->in);
+  if (!r->decompressor && (prog = get_decompressor (r->pos, r->end - r->pos)))
+    {
+      r->in = start_fed_decompressor (r, in, r->end - r->pos, prog);
+      r->end = r->pos;
+    }
+}
+
+static void
+reader_close (QDPLLAppReader * r)
+{
+  if (r->map)
+    munmap (r->map, r->map_size);
+  free (r->buf);
+  free (r->lits);
+  if (r->decompressor)
+    {
+      int status;
+      fclose (r->in);
+      QDPLL_ABORT_APP (waitpid (r->decompressor, &status, 0) != r->decompressor
+                       || !WIFEXITED (status) || WEXITSTATUS (status),
+                       "decompression of input failed!\n");
+    }
+  if (r->feeder)
+    {
+      int status;
+      QDPLL_ABORT_APP (waitpid (r->feeder, &status, 0) != r->feeder
+                       || (WIFEXITED (status) && WEXITSTATUS (status)),
+                       "could not read compressed input!\n");
+    }
+}
+
+/* Called if all bytes have been consumed. Returns next byte or EOF. */
+static int
+reader_refill (QDPLLAppReader * r)
+{
+  if (!r->in)
+    return EOF;
+  size_t bytes = fread (r->buf, 1, PARSER_BUF_SIZE, r->in);
+  if (!bytes)
+    return EOF;
+  r->pos = r->buf;
+  r->end = r->buf + bytes;
+  return *r->pos++;
+}
+
+static void
+reader_push_lit (QDPLLAppReader * r, LitID lit)
+{
+  if (r->lits_cnt == r->lits_size)
+    {
+      r->lits_size = r->lits_size ? 2 * r->lits_size : 64;
+      r->lits = (LitID *) realloc (r->lits, r->lits_size * sizeof (LitID));
+      QDPLL_ABORT_APP (!r->lits, "could not allocate memory!");
+    }
+  r->lits[r->lits_cnt++] = lit;
+}
+
+static void
+reader_flush_lits (QDPLLAppReader * r, QDPLL * qdpll)
+{
+  qdpll_add_lits (qdpll, r->lits, r->lits_cnt);
+  r->lits_cnt = 0;
+}
+
+#define PARSER_GETC(r) ((r)->pos < (r)->end ? *(r)->pos++ : reader_refill ((r)))
+
+/* Unlike 'isdigit', no table lookup and false for EOF. */
+#define PARSER_IS_DIGIT(c) ((unsigned int) ((c) - '0') < 10u)
+
 #define PARSER_READ_NUM(num, c)                        \
-  assert (isdigit (c));                                \
+  assert (PARSER_IS_DIGIT (c));                        \
   num = 0;					       \
   do						       \
     {						       \
       num = num * 10 + (c - '0');		       \
     }						       \
-  while (isdigit ((c = getc (in))));
+  while (PARSER_IS_DIGIT ((c = PARSER_GETC (r))));
 
 #define PARSER_SKIP_SPACE_DO_WHILE(c)		     \
   do						     \
     {                                                \
-      c = getc (in);				     \
+      c = PARSER_GETC (r);			     \
     }                                                \
   while (isspace (c));
 
 #define PARSER_SKIP_SPACE_WHILE(c)		     \
   while (isspace (c))                                \
-    c = getc (in);
+    c = PARSER_GETC (r);
+
+/* Chunks of the matrix smaller than this are not worth a thread. */
+#define PARSER_MIN_CHUNK_SIZE (1 << 20)
+
+/* Part of the matrix tokenised by one thread. Chunks end at line
+   boundaries, hence no number is split between two chunks. */
+struct QDPLLAppParseChunk
+{
+  const unsigned char *start;
+  const unsigned char *end;
+  LitID *lits;
+  size_t lits_cnt;
+  size_t lits_size;
+  /* Set if chunk contains anything but numbers and white space. */
+  int error;
+};
+
+typedef struct QDPLLAppParseChunk QDPLLAppParseChunk;
+
+static void
+chunk_push_lit (QDPLLAppParseChunk * ch, LitID lit)
+{
+  if (ch->lits_cnt == ch->lits_size)
+    {
+      ch->lits_size = ch->lits_size ? 2 * ch->lits_size :
+        (size_t) (ch->end - ch->start) / 4 + 1;
+      ch->lits = (LitID *) realloc (ch->lits, ch->lits_size * sizeof (LitID));
+      QDPLL_ABORT_APP (!ch->lits, "could not allocate memory!");
+    }
+  ch->lits[ch->lits_cnt++] = lit;
+}
+
+static void *
+parse_chunk (void *arg)
+{
+  QDPLLAppParseChunk *ch = (QDPLLAppParseChunk *) arg;
+  const unsigned char *p = ch->start, *e = ch->end;
+  while (p < e)
+    {
+      int c = *p;
+      if (isspace (c))
+        {
+          p++;
+          continue;
+        }
+      int neg = c == '-';
+      p += neg;
+      if (p == e || !PARSER_IS_DIGIT (*p))
+        {
+          ch->error = 1;
+          return 0;
+        }
+      LitID num = 0;
+      do
+        num = num * 10 + (*p++ - '0');
+      while (p < e && PARSER_IS_DIGIT (*p));
+      chunk_push_lit (ch, neg ? -num : num);
+    }
+  return 0;
+}
+
+/* Tokenise the matrix starting at 'start' by several threads and add the
+   literals to 'qdpll' in file order. Returns null if all of the input was
+   consumed. If a chunk contains something else than numbers, like a
+   scope declaration or a comment, then the start of this chunk is
+   returned and the caller continues parsing sequentially from there,
+   which also reports errors the same way. */
+static const unsigned char *
+parse_matrix_parallel (QDPLLAppReader * r, QDPLL * qdpll,
+                       const unsigned char *start)
+{
+  const unsigned char *end = r->end;
+  size_t num_chunks = (end - start) / PARSER_MIN_CHUNK_SIZE + 1;
+  if (num_chunks > r->num_threads)
+    num_chunks = r->num_threads;
+
+  QDPLLAppParseChunk *chunks =
+    (QDPLLAppParseChunk *) calloc (num_chunks, sizeof (QDPLLAppParseChunk));
+  pthread_t *threads = (pthread_t *) malloc (num_chunks * sizeof (pthread_t));
+  QDPLL_ABORT_APP (!chunks || !threads, "could not allocate memory!");
+
+  size_t i, started;
+  const unsigned char *p = start;
+  for (i = 0; i < num_chunks; i++)
+    {
+      chunks[i].start = p;
+      if (i + 1 == num_chunks)
+        p = end;
+      else
+        {
+          p += (end - start) / num_chunks;
+          if (p < chunks[i].start)
+            p = chunks[i].start;
+          while (p < end && *p++ != '\n')
+            ;
+        }
+      chunks[i].end = p;
+    }
+
+  for (started = 0; started < num_chunks; started++)
+    if (pthread_create (threads + started, 0, parse_chunk, chunks + started))
+      break;
+  /* Chunks without thread are tokenised here. */
+  for (i = started; i < num_chunks; i++)
+    parse_chunk (chunks + i);
+
+  /* Merge in file order, overlapping with threads still running. */
+  const unsigned char *resume = 0;
+  for (i = 0; i < num_chunks; i++)
+    {
+      if (i < started)
+        pthread_join (threads[i], 0);
+      if (!resume)
+        {
+          if (chunks[i].error)
+            resume = chunks[i].start;
+          else
+            qdpll_add_lits (qdpll, chunks[i].lits, chunks[i].lits_cnt);
+        }
+      free (chunks[i].lits);
+    }
+
+  free (threads);
+  free (chunks);
+  return resume;
+}
+
+static unsigned int
+reader_read_varint (QDPLLAppReader * r)
+{
+  unsigned int x = 0, shift = 0;
+  int c;
+  do
+    {
+      c = PARSER_GETC (r);
+      QDPLL_ABORT_APP (c == EOF || shift > 28,
+                       "truncated or malformed binary input!\n");
+      x |= (unsigned int) (c & 0x7f) << shift;
+      shift += 7;
+    }
+  while (c & 0x80);
+  return x;
+}
+
+/* Parse binary QDIMACS as written by 'qdpll_print_binary'. */
+static void
+parse_binary (QDPLLApp * app, QDPLL * qdpll, QDPLLAppReader * r, int trace)
+{
+  unsigned int i;
+  for (i = 0; i < QDPLL_BINARY_MAGIC_LEN; i++)
+    QDPLL_ABORT_APP (PARSER_GETC (r) != QDPLL_BINARY_MAGIC[i],
+                     "malformed binary header!\n");
+  QDPLL_ABORT_APP (reader_read_varint (r) != QDPLL_BINARY_VERSION,
+                   "unsupported version of binary format!\n");
+  unsigned int num_vars = reader_read_varint (r);
+  unsigned int num_scopes = reader_read_varint (r);
+  unsigned int num_clauses = reader_read_varint (r);
+  unsigned int num_lits = reader_read_varint (r);
+
+  if (trace == TRACE_QRP)
+    fprintf (stdout, "p qrp %u %u\n", num_vars, num_clauses);
+  else if (trace == TRACE_BQRP)
+    fprintf (stdout, "p bqrp %u %u%c", num_vars, num_clauses, 0);
+
+  if (num_vars)
+    qdpll_adjust_vars (qdpll, num_vars);
+
+  for (; num_scopes; num_scopes--)
+    {
+      int c = PARSER_GETC (r);
+      QDPLL_ABORT_APP (c != 'a' && c != 'e', "expecting scope type!\n");
+      qdpll_new_scope (qdpll, c == 'a' ? QDPLL_QTYPE_FORALL : QDPLL_QTYPE_EXISTS);
+      VarID id = 0;
+      for (i = reader_read_varint (r); i; i--)
+        {
+          id += reader_read_varint (r);
+          reader_push_lit (r, id);
+        }
+      reader_push_lit (r, 0);
+      reader_flush_lits (r, qdpll);
+    }
+
+  for (; num_clauses; num_clauses--)
+    {
+      unsigned int code = 0, n = reader_read_varint (r);
+      QDPLL_ABORT_APP (n > num_lits, "malformed binary clause!\n");
+      num_lits -= n;
+      for (; n; n--)
+        {
+          code += reader_read_varint (r);
+          reader_push_lit (r, code & 1 ? -(LitID) (code >> 1) : (LitID) (code >> 1));
+        }
+      reader_push_lit (r, 0);
+      reader_flush_lits (r, qdpll);
+    }
+
+  QDPLL_ABORT_APP (PARSER_GETC (r) != EOF, "unexpected data after binary formula!\n");
+}
+
+/* Load formula as written by 'qdpll_save_preprocessed'. The solver takes
+   the formula in one piece, hence input which is not mapped is read
+   completely into memory first. */
+static void
+parse_preprocessed (QDPLLApp * app, QDPLL * qdpll, QDPLLAppReader * r, int trace)
+{
+  if (trace)
+    {
+      /* Header is within the first block of input, hence can be re-read. */
+      const unsigned char *start = r->pos;
+      r->pos += QDPLL_PREPROCESSED_MAGIC_LEN;
+      reader_read_varint (r);
+      reader_read_varint (r);
+      unsigned int num_vars = reader_read_varint (r);
+      reader_read_varint (r);
+      unsigned int num_clauses = reader_read_varint (r);
+      if (trace == TRACE_QRP)
+        fprintf (stdout, "p qrp %u %u\n", num_vars, num_clauses);
+      else if (trace == TRACE_BQRP)
+        fprintf (stdout, "p bqrp %u %u%c", num_vars, num_clauses, 0);
+      r->pos = start;
+    }
+
+  if (r->map)
+    {
+      qdpll_load_preprocessed (qdpll, (const char *) r->pos, r->end - r->pos);
+      r->pos = r->end;
+      return;
+    }
+
+  size_t bytes = r->end - r->pos, size = 2 * PARSER_BUF_SIZE, n;
+  char *buf = (char *) malloc (size);
+  QDPLL_ABORT_APP (!buf, "could not allocate memory!");
+  memcpy (buf, r->pos, bytes);
+  while ((n = fread (buf + bytes, 1, size - bytes, r->in)) > 0)
+    if ((bytes += n) == size)
+      {
+        size *= 2;
+        buf = (char *) realloc (buf, size);
+        QDPLL_ABORT_APP (!buf, "could not allocate memory!");
+      }
+  r->pos = r->end;
+  qdpll_load_preprocessed (qdpll, buf, bytes);
+  free (buf);
+}
 
 static void
-parse (QDPLLApp * app, QDPLL * qdpll, FILE * in, int trace)
+parse (QDPLLApp * app, QDPLL * qdpll, QDPLLAppReader * r, int trace)
 {
   int col = 0, line = 0, neg = 0, preamble_found = 0;
   LitID num = 0;
   QDPLLQuantifierType scope_type = QDPLL_QTYPE_UNDEF;
 
-  assert (in);
+  assert (r);
 
-  int c;
-  while ((c = getc (in)) != EOF)
+  /* Binary input starts with a zero byte, which is invalid in text. */
+  int c = PARSER_GETC (r);
+  if (c != EOF)
+    r->pos--;
+  if (c == QDPLL_BINARY_MAGIC[0])
+    {
+      if (r->end - r->pos >= QDPLL_PREPROCESSED_MAGIC_LEN
+          && !memcmp (r->pos, QDPLL_PREPROCESSED_MAGIC,
+                      QDPLL_PREPROCESSED_MAGIC_LEN))
+        parse_preprocessed (app, qdpll, r, trace);
+      else
+        parse_binary (app, qdpll, r, trace);
+      return;
+    }
+
+  while ((c = PARSER_GETC (r)) != EOF)
     {
       PARSER_SKIP_SPACE_WHILE (c);
 
       while (c == 'c')
         {
-          while ((c = getc (in)) != '\n' && c != EOF)
+          while ((c = PARSER_GETC (r)) != '\n' && c != EOF)
             ;
-          c = getc (in);
+          c = PARSER_GETC (r);
         }
 
       PARSER_SKIP_SPACE_WHILE (c);
@@ -240,7 +747,7 @@ parse (QDPLLApp * app, QDPLL * qdpll, FILE * in, int trace)
           if (c != 'f')
             goto MALFORMED_PREAMBLE;
           PARSER_SKIP_SPACE_DO_WHILE (c);
-          if (!isdigit (c))
+          if (!PARSER_IS_DIGIT (c))
             goto MALFORMED_PREAMBLE;
 
           /* read number of variables */
@@ -251,7 +758,7 @@ parse (QDPLLApp * app, QDPLL * qdpll, FILE * in, int trace)
             fprintf (stdout, "p bqrp %u", num); 
 
           PARSER_SKIP_SPACE_WHILE (c);
-          if (!isdigit (c))
+          if (!PARSER_IS_DIGIT (c))
             goto MALFORMED_PREAMBLE;
 
           /* read number of clauses */
@@ -279,6 +786,20 @@ parse (QDPLLApp * app, QDPLL * qdpll, FILE * in, int trace)
 
       PARSER_SKIP_SPACE_WHILE (c);
 
+      if (r->num_threads > 1 && r->map && !r->lits_cnt
+          && (PARSER_IS_DIGIT (c) || c == '-'))
+        {
+          /* Prefix has been read: hand over matrix to threads. */
+          const unsigned char *resume =
+            parse_matrix_parallel (r, qdpll, r->pos - 1);
+          r->num_threads = 1;
+          if (!resume)
+            return;
+          r->pos = resume;
+          c = PARSER_GETC (r);
+          goto PARSE_SCOPE_OR_CLAUSE;
+        }
+
       if (c == 'a' || c == 'e')
         {
           /* open a new scope */
@@ -292,10 +813,14 @@ parse (QDPLLApp * app, QDPLL * qdpll, FILE * in, int trace)
           PARSER_SKIP_SPACE_DO_WHILE (c);
         }
 
-      if (!isdigit (c) && c != '-')
+      if (!PARSER_IS_DIGIT (c) && c != '-')
         {
           if (c == EOF)
-            return;
+            {
+              /* Pass on literals of unterminated clause, if any. */
+              reader_flush_lits (r, qdpll);
+              return;
+            }
           QDPLL_ABORT_APP (1, "expecting digit or '-'!\n");
           return;
         }
@@ -304,7 +829,7 @@ parse (QDPLLApp * app, QDPLL * qdpll, FILE * in, int trace)
           if (c == '-')
             {
               neg = 1;
-              if (!isdigit ((c = getc (in))))
+              if (!PARSER_IS_DIGIT ((c = PARSER_GETC (r))))
                 {
                   QDPLL_ABORT_APP (1, "expecting digit!\n");
                   return;
@@ -315,7 +840,9 @@ parse (QDPLLApp * app, QDPLL * qdpll, FILE * in, int trace)
           PARSER_READ_NUM (num, c);
           num = neg ? -num : num;
 
-          qdpll_add (qdpll, num);
+          reader_push_lit (r, num);
+          if (!num)
+            reader_flush_lits (r, qdpll);
 
           neg = 0;
 
@@ -341,6 +868,10 @@ check_options (QDPLLApp * app)
   if (app->options.dump_dep_graph && !app->options.deps_only)
     print_abort_err (app, "must not use option '%s' without option'%s'!\n\n",
                      "--dump-dep-graph", "--deps-only");
+
+  if (app->options.checkpoint_interval && !app->options.checkpoint_filename)
+    print_abort_err (app, "must not use option '%s' without option'%s'!\n\n",
+                     "--checkpoint-interval", "--checkpoint");
 }
 
 
@@ -410,6 +941,44 @@ parse_cmd_line_options (QDPLLApp * app, QDPLL * qdpll, int argc, char **argv)
         {
           app->options.dump_dep_graph = 1;
         }
+      else if (!strcmp (opt_str, "--print-mem-stats"))
+        {
+          app->options.print_mem_stats = 1;
+        }
+      else if (!strncmp (opt_str, "--write-binary=", strlen ("--write-binary=")))
+        {
+          app->options.binary_out_filename = opt_str + strlen ("--write-binary=");
+        }
+      else if (!strncmp (opt_str, "--write-preprocessed=", strlen ("--write-preprocessed=")))
+        {
+          app->options.preprocessed_out_filename = opt_str + strlen ("--write-preprocessed=");
+        }
+      else if (!strncmp (opt_str, "--checkpoint=", strlen ("--checkpoint=")))
+        {
+          app->options.checkpoint_filename = opt_str + strlen ("--checkpoint=");
+        }
+      else if (!strncmp (opt_str, "--checkpoint-interval=", strlen ("--checkpoint-interval=")))
+        {
+          opt_str += strlen ("--checkpoint-interval=");
+          if (isnumstr (opt_str) && atoi (opt_str) > 0)
+            app->options.checkpoint_interval = atoi (opt_str);
+          else
+            print_abort_err (app, "%s!\n\n",
+                             "Expecting positive number after '--checkpoint-interval='");
+        }
+      else if (!strncmp (opt_str, "--resume=", strlen ("--resume=")))
+        {
+          app->options.resume_filename = opt_str + strlen ("--resume=");
+        }
+      else if (!strncmp (opt_str, "--parse-threads=", strlen ("--parse-threads=")))
+        {
+          opt_str += strlen ("--parse-threads=");
+          if (isnumstr (opt_str) && atoi (opt_str) > 0)
+            app->options.parse_threads = atoi (opt_str);
+          else
+            print_abort_err (app, "%s!\n\n",
+                             "Expecting positive number after '--parse-threads='");
+        }
       else if (!strcmp (opt_str, "--qdag-print-deps-by-search"))
         {
           app->options.print_deps = 1;
@@ -488,10 +1057,27 @@ print_deps (QDPLLApp * app, QDPLL * qdpll)
 }
 
 
+/* Complete the trace written so far, which is buffered in memory. */
+static void
+drain_trace ()
+{
+  if (!qdpll_drain_trace (qdpll))
+    fprintf (stderr, "Trace is incomplete.\n");
+}
+
+
 static void
 sig_handler (int sig)
 {
+  if (sig == SIGTERM && checkpoint_on_sigterm)
+    {
+      /* The solver writes the checkpoint at the next safe point. */
+      checkpoint_on_sigterm = 0;
+      qdpll_request_checkpoint (qdpll, 1);
+      return;
+    }
   fprintf (stderr, "\n\n SIG RECEIVED\n\n");
+  drain_trace ();
 #if (COMPUTE_STATS || COMPUTE_TIMES)
   qdpll_print_stats (qdpll);
 #endif
@@ -504,6 +1090,7 @@ static void
 sigalrm_handler (int sig)
 {
   fprintf (stderr, "\n\n SIGALRM RECEIVED\n\n");
+  drain_trace ();
 #if (COMPUTE_STATS || COMPUTE_TIMES)
   qdpll_print_stats (qdpll);
 #endif
@@ -517,11 +1104,37 @@ set_signal_handlers (QDPLLApp * app)
 {
   signal (SIGINT, sig_handler);
   signal (SIGTERM, sig_handler);
+  /* Raised by 'QDPLL_ABORT_*' and failed assertions. */
+  signal (SIGABRT, sig_handler);
   signal (SIGALRM, sigalrm_handler);
   signal (SIGXCPU, sigalrm_handler);
 }
 
 
+/* Load checkpoint written by an earlier run with '--checkpoint'. */
+static void
+resume (QDPLLApp * app, QDPLL * qdpll)
+{
+  FILE *in = fopen (app->options.resume_filename, "rb");
+  if (!in)
+    print_abort_err (app, "could not open checkpoint file '%s'!\n\n",
+                     app->options.resume_filename);
+  size_t bytes = 0, size = PARSER_BUF_SIZE, n;
+  char *buf = (char *) malloc (size);
+  QDPLL_ABORT_APP (!buf, "could not allocate memory!");
+  while ((n = fread (buf + bytes, 1, size - bytes, in)) > 0)
+    if ((bytes += n) == size)
+      {
+        size *= 2;
+        buf = (char *) realloc (buf, size);
+        QDPLL_ABORT_APP (!buf, "could not allocate memory!");
+      }
+  fclose (in);
+  qdpll_load_checkpoint (qdpll, buf, bytes);
+  free (buf);
+}
+
+
 static void
 print_result_message (QDPLLApp * app, QDPLL * qdpll, QDPLLResult result, FILE *stream)
 {
@@ -534,7 +1147,9 @@ print_result_message (QDPLLApp * app, QDPLL * qdpll, QDPLLResult result, FILE *s
         fprintf (stream, "SAT\n");
       else if (result == QDPLL_RESULT_UNSAT)
         fprintf (stream, "UNSAT\n");
-      else if (!app->options.pretty_print && !app->options.deps_only)
+      else if (!app->options.pretty_print && !app->options.deps_only
+               && !app->options.binary_out_filename
+               && !app->options.preprocessed_out_filename)
         {
           assert (result == QDPLL_RESULT_UNKNOWN);
           fprintf (stream, "UNKNOWN\n");
@@ -603,9 +1218,31 @@ qdpll_main (int argc, char **argv)
   if (app.options.max_time)
     alarm (app.options.max_time);
 
-  parse (&app, qdpll, app.options.in, app.options.trace);
+  QDPLLAppReader reader;
+  reader_open (&reader, app.options.in);
+  reader.num_threads = app.options.parse_threads;
+  parse (&app, qdpll, &reader, app.options.trace);
+  reader_close (&reader);
 
-  if (app.options.pretty_print)
+  if (app.options.preprocessed_out_filename)
+    {
+      FILE *out = fopen (app.options.preprocessed_out_filename, "wb");
+      if (!out)
+        print_abort_err (&app, "could not open output file '%s'!\n\n",
+                         app.options.preprocessed_out_filename);
+      qdpll_save_preprocessed (qdpll, out);
+      fclose (out);
+    }
+  else if (app.options.binary_out_filename)
+    {
+      FILE *out = fopen (app.options.binary_out_filename, "wb");
+      if (!out)
+        print_abort_err (&app, "could not open output file '%s'!\n\n",
+                         app.options.binary_out_filename);
+      qdpll_print_binary (qdpll, out);
+      fclose (out);
+    }
+  else if (app.options.pretty_print)
     {
       /* Call 'qdpll_gc' to clean up the formula by removing variables
          which have no occurrences and removing empty quantifier
@@ -623,12 +1260,24 @@ qdpll_main (int argc, char **argv)
     }
   else
     {
+        if (app.options.resume_filename)
+          resume (&app, qdpll);
+        if (app.options.checkpoint_filename)
+          {
+            qdpll_set_checkpoint (qdpll, app.options.checkpoint_filename,
+                                  app.options.checkpoint_interval);
+            checkpoint_on_sigterm = 1;
+          }
         result = qdpll_sat (qdpll);
+        checkpoint_on_sigterm = 0;
 #if (COMPUTE_STATS || COMPUTE_TIMES)
         qdpll_print_stats (qdpll);
 #endif
     }
 
+  if (app.options.print_mem_stats)
+    qdpll_print_mem_stats (qdpll, stderr);
+
   if (app.options.trace == TRACE_QRP)
     fprintf (stdout, "r ");
   else if (app.options.trace == TRACE_BQRP)
@@ -125,6 +125,10 @@ existential literals on the fly. */
 #define LCUBES_MIN_INIT_VAL 2500
 #define LCUBES_MAX_INIT_VAL 10000
 
+/* Poll the timer of checkpoints only every so many backtracks, since
+   reading the process time is a system call. */
+#define CHECKPOINT_POLL_BACKTRACKS 256
+
 /* ---------- END: 'qdpll.c' ---------- */
 /* ------------------------------------ */
 
@@ -33,7 +33,8 @@
 enum QDPLLDepManType
 {
   QDPLL_DEPMAN_TYPE_QDAG = 0,
-  QDPLL_DEPMAN_TYPE_SIMPLE = 1
+  QDPLL_DEPMAN_TYPE_SIMPLE = 1,
+  QDPLL_DEPMAN_TYPE_RRS = 2
 };
 
 typedef enum QDPLLDepManType QDPLLDepManType;
@@ -1509,16 +1509,16 @@ assert_check_deps_by_functions_in_clause (QDPLLDepManQDAG * dm,
       LitID lit = *p;
       Var *var = LIT2VARPTR (vars, lit);
       if (QDPLL_VAR_MARKED_PROPAGATED (var)
-          && var->decision_level <= 0)
+          && QDPLL_VAR_LEVEL (*dm->pcnf, var) <= 0)
         continue;
       for (tmp = c->lits; tmp <= e; tmp++)
         {
           LitID lit_tmp = *tmp;
           Var *var_tmp = LIT2VARPTR (vars, lit_tmp);
           assert (!(QDPLL_VAR_MARKED_PROPAGATED (var_tmp)
-                   && var_tmp->decision_level <= 0));
+                   && QDPLL_VAR_LEVEL (*dm->pcnf, var_tmp) <= 0));
           if (QDPLL_VAR_MARKED_PROPAGATED (var_tmp)
-              && var_tmp->decision_level <= 0)
+              && QDPLL_VAR_LEVEL (*dm->pcnf, var_tmp) <= 0)
             continue;
           if (tmp <= p || var->scope->type == var_tmp->scope->type)
             assert (!qdpll_dep_man_depends
@@ -2027,8 +2027,9 @@ insert_c_edge (QDPLLDepManQDAG * dm, Var * from, Var * to,
 }
 
 static LitID *
-find_next_lit_from_other_scope (Var * vars, LitID * lits, LitID * lit)
+find_next_lit_from_other_scope (QDPLLPCNF * pcnf, LitID * lits, LitID * lit)
 {
+  Var *vars = pcnf->vars;
   assert (lit);
   assert (lits <= lit);
 
@@ -2038,7 +2039,7 @@ find_next_lit_from_other_scope (Var * vars, LitID * lits, LitID * lit)
        lits <= lit &&
        ((var = LIT2VARPTR (vars, (*lit)))->scope == s ||
         (QDPLL_VAR_MARKED_PROPAGATED (var)
-         && var->decision_level <= 0)); lit--);
+         && QDPLL_VAR_LEVEL (*pcnf, var) <= 0)); lit--);
 
   return lit;
 }
@@ -2063,13 +2064,13 @@ extract_dependencies_from_lits (QDPLLDepManQDAG * dm, LitID * lits,
   assert (lits <= rightlit_p);
   assert (QDPLL_SCOPE_EXISTS (LIT2VARPTR (vars, *rightlit_p)->scope));
   assert (!(QDPLL_VAR_MARKED_PROPAGATED (LIT2VARPTR (vars, *rightlit_p)) &&
-            LIT2VARPTR (vars, *rightlit_p)->decision_level <= 0));
+            QDPLL_VAR_LEVEL (*dm->pcnf, LIT2VARPTR (vars, *rightlit_p)) <= 0));
 
   /* Extraction loop. */
   while (lits <= rightlit_p)
     {
       leftlit_p =
-        find_next_lit_from_other_scope (vars, lits, rightlit_p);
+        find_next_lit_from_other_scope (dm->pcnf, lits, rightlit_p);
       assert (leftlit_p < rightlit_p);
       assert (lits <= leftlit_p || leftlit_p == lits - 1);
       assert (leftlit_p < lits
@@ -2077,8 +2078,8 @@ extract_dependencies_from_lits (QDPLLDepManQDAG * dm, LitID * lits,
                   LIT2VARPTR (vars, *rightlit_p)->scope->nesting &&
                   !(QDPLL_VAR_MARKED_PROPAGATED
                     (LIT2VARPTR (vars, *leftlit_p))
-                    && LIT2VARPTR (vars,
-                                   *leftlit_p)->decision_level <= 0)));
+                    && QDPLL_VAR_LEVEL (*dm->pcnf, LIT2VARPTR (vars,
+                                   *leftlit_p)) <= 0)));
 
       if (QDPLL_SCOPE_EXISTS (LIT2VARPTR (vars, *rightlit_p)->scope))
         {
@@ -2089,23 +2090,23 @@ extract_dependencies_from_lits (QDPLLDepManQDAG * dm, LitID * lits,
               assert (lits <= tmp_p);
               assert (!
                       (QDPLL_VAR_MARKED_PROPAGATED (LIT2VARPTR (vars, *tmp_p))
-                       && LIT2VARPTR (vars,
-                                      *tmp_p)->decision_level <= 0));
+                       && QDPLL_VAR_LEVEL (*dm->pcnf, LIT2VARPTR (vars,
+                                      *tmp_p)) <= 0));
               assert (!
                       (QDPLL_VAR_MARKED_PROPAGATED
                        (LIT2VARPTR (vars, *rightlit_p))
-                       && LIT2VARPTR (vars,
-                                      *rightlit_p)->decision_level <= 0));
+                       && QDPLL_VAR_LEVEL (*dm->pcnf, LIT2VARPTR (vars,
+                                      *rightlit_p)) <= 0));
               Var *rep_tmp =
                 uf_find (vars, LIT2VARPTR (vars, *tmp_p), 0, type);
               Var *rep_right =
                 uf_find (vars, LIT2VARPTR (vars, *rightlit_p), 0, type);
               assert (!
                       (QDPLL_VAR_MARKED_PROPAGATED (rep_tmp)
-                       && rep_tmp->decision_level <= 0));
+                       && QDPLL_VAR_LEVEL (*dm->pcnf, rep_tmp) <= 0));
               assert (!
                       (QDPLL_VAR_MARKED_PROPAGATED (rep_right)
-                       && rep_right->decision_level <= 0));
+                       && QDPLL_VAR_LEVEL (*dm->pcnf, rep_right) <= 0));
 
 #ifndef NDEBUG
 #if QDAG_ASSERT_EXTRACT_DEPS_INSERT_C_EDGE_BEFORE
@@ -2135,16 +2136,16 @@ extract_dependencies_from_lits (QDPLLDepManQDAG * dm, LitID * lits,
       assert (rightlit_p == leftlit_p + 1);
       assert (!last_e_p
               || !(QDPLL_VAR_MARKED_PROPAGATED (LIT2VARPTR (vars, *last_e_p))
-                   && LIT2VARPTR (vars,
-                                  *last_e_p)->decision_level <= 0));
+                   && QDPLL_VAR_LEVEL (*dm->pcnf, LIT2VARPTR (vars,
+                                  *last_e_p)) <= 0));
       assert (!last_e_p
               ||
               !(QDPLL_VAR_MARKED_PROPAGATED
                 (uf_find (vars, LIT2VARPTR (vars, *last_e_p), 0, type))
-                && uf_find (vars,
+                && QDPLL_VAR_LEVEL (*dm->pcnf, uf_find (vars,
                             LIT2VARPTR (vars,
                                         *last_e_p), 0,
-                            type)->decision_level <= 0));
+                            type)) <= 0));
 
       /* POSSIBLE OPTIMIZATION: suffices to balance once, can then re-use insert-position for all vars from same scope */
 
@@ -2153,16 +2154,16 @@ extract_dependencies_from_lits (QDPLLDepManQDAG * dm, LitID * lits,
           assert (!
                   (QDPLL_VAR_MARKED_PROPAGATED
                    (LIT2VARPTR (vars, *rightlit_p))
-                   && LIT2VARPTR (vars,
-                                  *rightlit_p)->decision_level <= 0));
+                   && QDPLL_VAR_LEVEL (*dm->pcnf, LIT2VARPTR (vars,
+                                  *rightlit_p)) <= 0));
           if (last_e_p)
             {
               assert (!
                       (QDPLL_VAR_MARKED_PROPAGATED
                        (uf_find
                         (vars, LIT2VARPTR (vars, *rightlit_p), 0, type))
-                       && uf_find (vars, LIT2VARPTR (vars, *rightlit_p), 0,
-                                   type)->decision_level <= 0));
+                       && QDPLL_VAR_LEVEL (*dm->pcnf, uf_find (vars, LIT2VARPTR (vars, *rightlit_p), 0,
+                                   type)) <= 0));
               insert_c_edge (dm,
                              uf_find (vars, LIT2VARPTR (vars, *rightlit_p), 0,
                                       type), uf_find (vars, LIT2VARPTR (vars,
@@ -2176,8 +2177,8 @@ extract_dependencies_from_lits (QDPLLDepManQDAG * dm, LitID * lits,
                   assert (!
                           (QDPLL_VAR_MARKED_PROPAGATED
                            (LIT2VARPTR (vars, *tmp_p))
-                           && LIT2VARPTR (vars,
-                                          *tmp_p)->decision_level <= 0));
+                           && QDPLL_VAR_LEVEL (*dm->pcnf, LIT2VARPTR (vars,
+                                          *tmp_p)) <= 0));
                   insert_edge (dm, LIT2VARPTR (vars, *tmp_p), uf_find (vars, LIT2VARPTR (vars, *last_e_p), 0, type));
                   tmp_p++;
                 }
@@ -2196,8 +2197,8 @@ extract_dependencies_from_lits (QDPLLDepManQDAG * dm, LitID * lits,
             {
               assert (!
                       (QDPLL_VAR_MARKED_PROPAGATED (LIT2VARPTR (vars, *tmp_p))
-                       && LIT2VARPTR (vars,
-                                      *tmp_p)->decision_level <= 0));
+                       && QDPLL_VAR_LEVEL (*dm->pcnf, LIT2VARPTR (vars,
+                                      *tmp_p)) <= 0));
               insert_edge (dm, LIT2VARPTR (vars, *tmp_p), uf_find (vars, LIT2VARPTR (vars, *last_e_p), 0, type));
               tmp_p++;
             }
@@ -3010,9 +3011,9 @@ collect_deps_from_cnf_check_clause (QDPLLDepManQDAG * dm,
       LitID lit = *litp;
       Var *d = LIT2VARPTR (vars, lit);
       assert (!(QDPLL_VAR_MARKED_PROPAGATED (d)
-               && d->decision_level <= 0));
+               && QDPLL_VAR_LEVEL (*dm->pcnf, d) <= 0));
       if (QDPLL_VAR_MARKED_PROPAGATED (d)
-          && d->decision_level <= 0)
+          && QDPLL_VAR_LEVEL (*dm->pcnf, d) <= 0)
         continue;
 
       Scope *d_scope = d->scope;
@@ -3070,7 +3071,7 @@ collect_deps_from_cnf (QDPLLDepManQDAG * dm, VarPtrStack * deps, Var * v)
       Var *t = QDPLL_POP_STACK (con);
       assert (!
               (QDPLL_VAR_MARKED_PROPAGATED (t)
-               && t->decision_level <= 0));
+               && QDPLL_VAR_LEVEL (*dm->pcnf, t) <= 0));
       assert (t->GETQDAG (type).mark1);        /* Must be marked as collected. */
       assert (t == v || v->scope->nesting < t->scope->nesting);
       assert (t == v || t->scope->type == QDPLL_QTYPE_EXISTS);
@@ -3081,12 +3082,12 @@ collect_deps_from_cnf (QDPLLDepManQDAG * dm, VarPtrStack * deps, Var * v)
            bp < be; bp++)
         collect_deps_from_cnf_check_clause (dm, deps, &(con), var_type,
                                             var_nesting,
-                                            BLIT_STRIP_PTR (bp->constraint));
+                                            BLIT_CONSTRAINT (*dm->pcnf, *bp));
       for (bp = t->neg_occ_clauses.start, be = t->neg_occ_clauses.top;
            bp < be; bp++)
         collect_deps_from_cnf_check_clause (dm, deps, &(con), var_type,
                                             var_nesting,
-                                            BLIT_STRIP_PTR (bp->constraint));
+                                            BLIT_CONSTRAINT (*dm->pcnf, *bp));
     }
 
   QDPLL_DELETE_STACK (mm, con);
@@ -5568,7 +5569,7 @@ qdpll_dep_man_print_deps_by_graph (QDPLLDepManGeneric * dmg, VarID id)
 
   /* Handle top-level vars. */
   if (QDPLL_VAR_MARKED_PROPAGATED (v)
-          && v->decision_level <= 0)
+          && QDPLL_VAR_LEVEL (*dm->pcnf, v) <= 0)
     {
       fprintf (stdout, "disabled");
       return;
@@ -5611,7 +5612,7 @@ qdpll_dep_man_print_deps_by_search (QDPLLDepManGeneric * dmg, VarID id)
 
   /* Handle top-level vars. */
   if (QDPLL_VAR_MARKED_PROPAGATED (v)
-          && v->decision_level <= 0)
+          && QDPLL_VAR_LEVEL (*dm->pcnf, v) <= 0)
     {
       fprintf (stdout, "disabled");
       return;
@@ -5655,7 +5656,7 @@ qdpll_dep_man_return_deps_by_search (QDPLLDepManGeneric * dmg, VarID id, unsigne
 
   /* Handle top-level vars. */
   if (QDPLL_VAR_MARKED_PROPAGATED (v)
-      && v->decision_level <= 0)
+      && QDPLL_VAR_LEVEL (*dm->pcnf, v) <= 0)
   {
     // fprintf (stdout, "disabled");
     ret_deps[0] = 0;
@@ -5969,6 +5970,8 @@ qdpll_qdag_dep_man_create (QDPLLMemMan * mm, QDPLLPCNF * pcnf,
                            QDPLLDepManType type, int print_deps_by_search,
                            QDPLL * qdpll)
 {
+  /* All memory of the dependency manager is accounted to 'QDPLL_MEM_QDAG'. */
+  mm = qdpll_mem_view (mm, QDPLL_MEM_QDAG);
   QDPLLDepManQDAG *dm =
     (QDPLLDepManQDAG *) qdpll_malloc (mm, sizeof (QDPLLDepManQDAG));
   dm->mm = mm;
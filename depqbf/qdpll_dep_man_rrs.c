@@ -0,0 +1,777 @@
+/*
+ This file is part of DepQBF.
+
+ DepQBF, a solver for quantified boolean formulae (QBF).
+
+ Copyright 2010, 2011, 2012, 2013, 2014, 2015, 2016
+ Florian Lonsing, Johannes Kepler University, Linz, Austria and
+ Vienna University of Technology, Vienna, Austria.
+
+ DepQBF is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or (at
+ your option) any later version.
+
+ DepQBF is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with DepQBF.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include "qdpll_internals.h"
+#include "qdpll_pcnf.h"
+#include "qdpll_exit.h"
+#include "qdpll_dep_man_generic.h"
+#include "qdpll_dep_man_rrs.h"
+#include "qdpll_config.h"
+
+
+#define QDPLL_ABORT_DEPMAN(cond,msg)					\
+  do {									\
+    if (cond)								\
+      {									\
+        fprintf (stderr, "[qdpll_depman] %s at line %d: %s\n", __func__, \
+                 __LINE__,msg);						\
+        fflush (stderr);                                                \
+        abort();                                                        \
+      }									\
+  } while (0)
+
+/* Reachability is computed for this many source variables at once. Each
+   source takes two bits of a word, one for either literal. */
+#define RRS_SOURCES_PER_WORD 32
+
+/* Index of literal 'lit' in the tables of reachable sources. */
+#define RRS_LIT_INDEX(lit) (2 * LIT2VARID (lit) + ((lit) < 0))
+
+
+struct QDPLLDepManRRS
+{
+  /* DO NOT ADD MEMBERS BEFORE 'dmg'! */
+  QDPLLDepManGeneric dmg;
+  QDPLLMemMan *mm;
+  QDPLLPCNF *pcnf;
+  struct
+  {
+    unsigned int init:1;
+  } state;
+  /* Number of entries of the per-variable tables below, which is
+     'pcnf->size_vars' at the time of initialization. */
+  VarID size_vars;
+  /* Variables depending on 'x' are stored on 'deps' from position
+     'dep_offset[x]' on, 'dep_count[x]' many and sorted by ID. */
+  size_t *dep_offset;
+  unsigned int *dep_count;
+  VarIDStack deps;
+  /* Number of variables 'y' depends on which have not been notified
+     inactive. Variable 'y' is a candidate if and only if this is zero. */
+  unsigned int *active_deps;
+  /* Candidates not yet returned by 'get_candidate'. Variables which are
+     no candidate any more are skipped when popped. */
+  VarIDStack candidates;
+  unsigned char *on_candidates;
+};
+
+
+/* Data of the reachability analysis. 'reach[l]' holds the sources
+   which reach the clauses containing literal 'l' by a resolution path
+   entering them through 'l', and 'done[l]' the part of it which has been
+   propagated. 'ends[v]' holds the sources reaching a clause which
+   contains a literal of 'v' other than the one the path entered by. */
+struct RRSReach
+{
+  uint64_t *reach;
+  uint64_t *done;
+  uint64_t *ends;
+  LitIDStack queue;
+  LitIDStack touched_lits;
+  VarIDStack touched_ends;
+};
+
+typedef struct RRSReach RRSReach;
+
+
+static double
+time_stamp ()
+{
+  double result = 0;
+  struct rusage usage;
+
+  if (!getrusage (RUSAGE_SELF, &usage))
+    {
+      result += usage.ru_utime.tv_sec + 1e-6 * usage.ru_utime.tv_usec;
+      result += usage.ru_stime.tv_sec + 1e-6 * usage.ru_stime.tv_usec;
+    }
+
+  return result;
+}
+
+
+static int
+compare_var_ids (const void *a, const void *b)
+{
+  VarID x = *(const VarID *) a, y = *(const VarID *) b;
+  return x < y ? -1 : (x > y);
+}
+
+
+/* -------------------- START: DEPENDENCY EXTRACTION -------------------- */
+
+/* Propagate sources 'bits' which entered clause 'c' through a literal of
+   'from' to the other literals of 'c'. Variables of 'src_scope' and of
+   scopes to its left are ignored. */
+static void
+reach_clause (QDPLLDepManRRS * dm, RRSReach * r, Constraint * c,
+              VarID from, Scope * src_scope, uint64_t bits)
+{
+  QDPLLMemMan *mm = dm->mm;
+  Var *vars = dm->pcnf->vars;
+  LitID *p, *e;
+  for (p = c->lits, e = p + c->num_lits; p < e; p++)
+    {
+      LitID lit = *p;
+      Var *v = LIT2VARPTR (vars, lit);
+      if (v->id == from || v->scope->nesting <= src_scope->nesting)
+        continue;
+      if (v->scope->type != src_scope->type)
+        {
+          if (!r->ends[v->id])
+            QDPLL_PUSH_STACK (mm, r->touched_ends, v->id);
+          r->ends[v->id] |= bits;
+        }
+      if (QDPLL_SCOPE_EXISTS (v->scope))
+        {
+          /* Resolve on 'v': continue in clauses containing '-lit'. */
+          unsigned int i = RRS_LIT_INDEX (-lit);
+          uint64_t new_bits = bits & ~r->reach[i];
+          if (new_bits)
+            {
+              if (!r->reach[i])
+                QDPLL_PUSH_STACK (mm, r->touched_lits, -lit);
+              if (r->reach[i] == r->done[i])
+                QDPLL_PUSH_STACK (mm, r->queue, -lit);
+              r->reach[i] |= new_bits;
+            }
+        }
+    }
+}
+
+
+static void
+reach_occs (QDPLLDepManRRS * dm, RRSReach * r, LitID lit,
+            Scope * src_scope, uint64_t bits)
+{
+  Var *v = LIT2VARPTR (dm->pcnf->vars, lit);
+  BLitsOccStack *occs = lit < 0 ? &(v->neg_occ_clauses) :
+    &(v->pos_occ_clauses);
+  BLitsOcc *p, *e;
+  for (p = occs->start, e = occs->top; p < e; p++)
+    {
+      Constraint *c = BLIT_CONSTRAINT (*dm->pcnf, *p);
+      assert (!c->is_cube);
+      if (!c->learnt)
+        reach_clause (dm, r, c, v->id, src_scope, bits);
+    }
+}
+
+
+/* Compute the variables depending on the sources 'src[0..num-1]' of
+   scope 's' and append them to 'dm->deps'. */
+static void
+extract_batch (QDPLLDepManRRS * dm, RRSReach * r, Scope * s,
+               VarID * src, unsigned int num)
+{
+  QDPLLMemMan *mm = dm->mm;
+  unsigned int i;
+  assert (num <= RRS_SOURCES_PER_WORD);
+
+  for (i = 0; i < num; i++)
+    {
+      reach_occs (dm, r, src[i], s, (uint64_t) 1 << (2 * i));
+      reach_occs (dm, r, -(LitID) src[i], s, (uint64_t) 2 << (2 * i));
+    }
+
+  while (!QDPLL_EMPTY_STACK (r->queue))
+    {
+      LitID lit = QDPLL_POP_STACK (r->queue);
+      unsigned int li = RRS_LIT_INDEX (lit);
+      uint64_t new_bits = r->reach[li] & ~r->done[li];
+      assert (new_bits);
+      r->done[li] = r->reach[li];
+      reach_occs (dm, r, lit, s, new_bits);
+    }
+
+  /* 'y' depends on source 'i' if it is reached from both literals. */
+  qsort (r->touched_ends.start, QDPLL_COUNT_STACK (r->touched_ends),
+         sizeof (VarID), compare_var_ids);
+  VarID *p, *e;
+  for (i = 0; i < num; i++)
+    {
+      VarID x = src[i];
+      dm->dep_offset[x] = QDPLL_COUNT_STACK (dm->deps);
+      for (p = r->touched_ends.start, e = r->touched_ends.top; p < e; p++)
+        if (((r->ends[*p] >> (2 * i)) & 3) == 3)
+          QDPLL_PUSH_STACK (mm, dm->deps, *p);
+      dm->dep_count[x] = QDPLL_COUNT_STACK (dm->deps) - dm->dep_offset[x];
+    }
+
+  for (p = r->touched_ends.start, e = r->touched_ends.top; p < e; p++)
+    r->ends[*p] = 0;
+  QDPLL_RESET_STACK (r->touched_ends);
+  LitID *lp, *le;
+  for (lp = r->touched_lits.start, le = r->touched_lits.top; lp < le; lp++)
+    r->reach[RRS_LIT_INDEX (*lp)] = r->done[RRS_LIT_INDEX (*lp)] = 0;
+  QDPLL_RESET_STACK (r->touched_lits);
+}
+
+
+static void
+extract_dependencies (QDPLLDepManRRS * dm)
+{
+  QDPLLMemMan *mm = dm->mm;
+  const size_t size = dm->size_vars;
+  RRSReach r;
+  r.reach = qdpll_malloc (mm, 2 * size * sizeof (uint64_t));
+  r.done = qdpll_malloc (mm, 2 * size * sizeof (uint64_t));
+  r.ends = qdpll_malloc (mm, size * sizeof (uint64_t));
+  QDPLL_INIT_STACK (r.queue);
+  QDPLL_INIT_STACK (r.touched_lits);
+  QDPLL_INIT_STACK (r.touched_ends);
+
+  Scope *s, *t;
+  for (s = dm->pcnf->scopes.first; s; s = s->link.next)
+    {
+      /* Variables of the innermost scope of either type have no
+         depending variables. */
+      for (t = s->link.next; t && t->type == s->type; t = t->link.next)
+        ;
+      if (!t)
+        continue;
+      VarID *p, *e;
+      for (p = s->vars.start, e = s->vars.top; p < e;
+           p += RRS_SOURCES_PER_WORD)
+        {
+          size_t left = e - p;
+          extract_batch (dm, &r, s, p, left < RRS_SOURCES_PER_WORD ?
+                         left : RRS_SOURCES_PER_WORD);
+        }
+    }
+
+  QDPLL_DELETE_STACK (mm, r.touched_ends);
+  QDPLL_DELETE_STACK (mm, r.touched_lits);
+  QDPLL_DELETE_STACK (mm, r.queue);
+  qdpll_free (mm, r.ends, size * sizeof (uint64_t));
+  qdpll_free (mm, r.done, 2 * size * sizeof (uint64_t));
+  qdpll_free (mm, r.reach, 2 * size * sizeof (uint64_t));
+}
+
+/* -------------------- END: DEPENDENCY EXTRACTION -------------------- */
+
+
+static int
+has_dependent (QDPLLDepManRRS * dm, VarID x, VarID y)
+{
+  VarID *p = dm->deps.start + dm->dep_offset[x];
+  unsigned int lo = 0, hi = dm->dep_count[x];
+  while (lo < hi)
+    {
+      unsigned int mid = lo + (hi - lo) / 2;
+      if (p[mid] < y)
+        lo = mid + 1;
+      else if (p[mid] > y)
+        hi = mid;
+      else
+        return 1;
+    }
+  return 0;
+}
+
+
+static void
+push_candidate (QDPLLDepManRRS * dm, VarID id)
+{
+  if (!dm->on_candidates[id])
+    {
+      dm->on_candidates[id] = 1;
+      QDPLL_PUSH_STACK (dm->mm, dm->candidates, id);
+    }
+}
+
+
+static void
+free_tables (QDPLLDepManRRS * dm)
+{
+  QDPLLMemMan *mm = dm->mm;
+  const size_t size = dm->size_vars;
+  qdpll_free (mm, dm->dep_offset, size * sizeof (size_t));
+  qdpll_free (mm, dm->dep_count, size * sizeof (unsigned int));
+  qdpll_free (mm, dm->active_deps, size * sizeof (unsigned int));
+  qdpll_free (mm, dm->on_candidates, size * sizeof (unsigned char));
+  QDPLL_DELETE_STACK (mm, dm->deps);
+  QDPLL_DELETE_STACK (mm, dm->candidates);
+  dm->dep_offset = 0;
+  dm->dep_count = dm->active_deps = 0;
+  dm->on_candidates = 0;
+  dm->size_vars = 0;
+}
+
+
+/* -------------------- START: CORE FUNCTIONS -------------------- */
+
+static void
+qdpll_dep_man_rrs_init (QDPLLDepManGeneric * dmg)
+{
+  QDPLLDepManRRS *dm = (QDPLLDepManRRS *) dmg;
+  QDPLLMemMan *mm = dm->mm;
+  const double init_start_time = time_stamp ();
+  QDPLL_ABORT_DEPMAN (dm->state.init,
+                      "dependency manager already initialized.");
+  dm->state.init = 1;
+
+  const size_t size = dm->size_vars = dm->pcnf->size_vars;
+  dm->dep_offset = qdpll_malloc (mm, size * sizeof (size_t));
+  dm->dep_count = qdpll_malloc (mm, size * sizeof (unsigned int));
+  dm->active_deps = qdpll_malloc (mm, size * sizeof (unsigned int));
+  dm->on_candidates = qdpll_malloc (mm, size * sizeof (unsigned char));
+
+  extract_dependencies (dm);
+  QDPLL_SHRINK_STACK (mm, dm->deps);
+
+  VarID *p, *e;
+  VarID x;
+  for (x = 1; x < size; x++)
+    for (p = dm->deps.start + dm->dep_offset[x],
+         e = p + dm->dep_count[x]; p < e; p++)
+      dm->active_deps[*p]++;
+  Scope *s;
+  for (s = dm->pcnf->scopes.first; s; s = s->link.next)
+    for (p = s->vars.start, e = s->vars.top; p < e; p++)
+      {
+        assert (!QDPLL_VAR_MARKED_PROPAGATED
+                (VARID2VARPTR (dm->pcnf->vars, *p)));
+        if (!dm->active_deps[*p])
+          push_candidate (dm, *p);
+      }
+
+  if (dmg->qdpll->options.verbosity > 0)
+    {
+      fprintf (stderr, "DM rrs: init-time: %f, dependencies: %llu\n",
+               time_stamp () - init_start_time,
+               (unsigned long long int) QDPLL_COUNT_STACK (dm->deps));
+    }
+}
+
+
+static void
+qdpll_dep_man_rrs_reset (QDPLLDepManGeneric * dmg)
+{
+  QDPLLDepManRRS *dm = (QDPLLDepManRRS *) dmg;
+  if (dm->state.init)
+    free_tables (dm);
+  dm->state.init = 0;
+}
+
+
+static VarID
+qdpll_dep_man_rrs_get_candidate (QDPLLDepManGeneric * dmg)
+{
+  QDPLLDepManRRS *dm = (QDPLLDepManRRS *) dmg;
+  assert (dm->state.init);
+  while (!QDPLL_EMPTY_STACK (dm->candidates))
+    {
+      VarID id = QDPLL_POP_STACK (dm->candidates);
+      assert (dm->on_candidates[id]);
+      dm->on_candidates[id] = 0;
+      if (!dm->active_deps[id])
+        return id;
+    }
+  return 0;
+}
+
+
+static void
+qdpll_dep_man_rrs_notify_inactive (QDPLLDepManGeneric * dmg, VarID id)
+{
+  QDPLLDepManRRS *dm = (QDPLLDepManRRS *) dmg;
+  assert (dm->state.init);
+  assert (id > 0 && id < dm->size_vars);
+  assert (QDPLL_VAR_MARKED_PROPAGATED (VARID2VARPTR (dm->pcnf->vars, id)));
+  VarID *p, *e;
+  for (p = dm->deps.start + dm->dep_offset[id], e = p + dm->dep_count[id];
+       p < e; p++)
+    {
+      assert (dm->active_deps[*p]);
+      if (!--dm->active_deps[*p])
+        push_candidate (dm, *p);
+    }
+}
+
+
+static void
+qdpll_dep_man_rrs_notify_active (QDPLLDepManGeneric * dmg, VarID id)
+{
+  QDPLLDepManRRS *dm = (QDPLLDepManRRS *) dmg;
+  assert (dm->state.init);
+  assert (id > 0 && id < dm->size_vars);
+  assert (!QDPLL_VAR_MARKED_PROPAGATED (VARID2VARPTR (dm->pcnf->vars, id)));
+  VarID *p, *e;
+  for (p = dm->deps.start + dm->dep_offset[id], e = p + dm->dep_count[id];
+       p < e; p++)
+    dm->active_deps[*p]++;
+  /* Like the QDAG manager: offer an active candidate again. */
+  if (!dm->active_deps[id])
+    push_candidate (dm, id);
+}
+
+
+static int
+qdpll_dep_man_rrs_is_candidate (QDPLLDepManGeneric * dmg, VarID id)
+{
+  QDPLLDepManRRS *dm = (QDPLLDepManRRS *) dmg;
+  assert (dm->state.init);
+  assert (id > 0 && id < dm->size_vars);
+  return !dm->active_deps[id];
+}
+
+
+/* Dependencies are computed from the formula at initialization, hence
+   there is nothing to do when variables are added or removed. */
+static void
+qdpll_dep_man_rrs_notify_init_variable (QDPLLDepManGeneric * dmg, VarID id)
+{
+  assert (id > 0);
+}
+
+
+static void
+qdpll_dep_man_rrs_notify_reset_variable (QDPLLDepManGeneric * dmg, VarID id)
+{
+  assert (id > 0);
+}
+
+
+static int
+qdpll_dep_man_rrs_is_init (QDPLLDepManGeneric * dmg)
+{
+  QDPLLDepManRRS *dm = (QDPLLDepManRRS *) dmg;
+  return dm->state.init;
+}
+
+
+/* Write the zero-terminated dependencies of 'id' to 'ret_deps' if
+   non-null, otherwise print them to 'stdout'. */
+static void
+print_or_return_deps (QDPLLDepManRRS * dm, VarID id, unsigned int *ret_deps)
+{
+  assert (dm->state.init);
+  assert (id > 0 && id < dm->pcnf->size_vars);
+  Var *v = VARID2VARPTR (dm->pcnf->vars, id);
+
+  /* Unused and top-level assigned variables have no dependencies. */
+  if (!v->id || id >= dm->size_vars
+      || (QDPLL_VAR_MARKED_PROPAGATED (v)
+          && QDPLL_VAR_LEVEL (*dm->pcnf, v) <= 0))
+    {
+      if (ret_deps)
+        ret_deps[0] = 0;
+      else
+        fprintf (stdout, v->id ? "disabled" : "unused");
+      return;
+    }
+
+  VarID *p = dm->deps.start + dm->dep_offset[id];
+  unsigned int i, n = dm->dep_count[id];
+  for (i = 0; i < n; i++)
+    {
+      if (ret_deps)
+        ret_deps[i] = p[i];
+      else
+        fprintf (stdout, "%u ", p[i]);
+    }
+  if (ret_deps)
+    ret_deps[n] = 0;
+  else
+    fprintf (stdout, "0");
+}
+
+
+static void
+qdpll_dep_man_rrs_print_deps (QDPLLDepManGeneric * dmg, VarID id)
+{
+  print_or_return_deps ((QDPLLDepManRRS *) dmg, id, 0);
+}
+
+
+static void
+qdpll_dep_man_rrs_return_deps (QDPLLDepManGeneric * dmg, VarID id,
+                               unsigned int *ret_deps)
+{
+  print_or_return_deps ((QDPLLDepManRRS *) dmg, id, ret_deps);
+}
+
+
+static void
+qdpll_dep_man_rrs_dump_dep_graph (QDPLLDepManGeneric * dmg)
+{
+  QDPLLDepManRRS *dm = (QDPLLDepManRRS *) dmg;
+  assert (dm->state.init);
+  Var *vars = dm->pcnf->vars;
+  Scope *s;
+  VarID *p, *e, *dp, *de;
+
+  fprintf (stdout, "digraph rrs {\n");
+  for (s = dm->pcnf->scopes.first; s; s = s->link.next)
+    {
+      fprintf (stdout, "  { rank=same;\n");
+      for (p = s->vars.start, e = s->vars.top; p < e; p++)
+        fprintf (stdout, "    %c%u[shape=%s];\n",
+                 QDPLL_SCOPE_EXISTS (s) ? 'e' : 'a', *p,
+                 QDPLL_SCOPE_EXISTS (s) ? "diamond" : "box");
+      fprintf (stdout, "  }\n");
+    }
+  for (s = dm->pcnf->scopes.first; s; s = s->link.next)
+    for (p = s->vars.start, e = s->vars.top; p < e; p++)
+      for (dp = dm->deps.start + dm->dep_offset[*p],
+           de = dp + dm->dep_count[*p]; dp < de; dp++)
+        fprintf (stdout, "  %c%u -> %c%u;\n",
+                 QDPLL_SCOPE_EXISTS (s) ? 'e' : 'a', *p,
+                 QDPLL_SCOPE_EXISTS (VARID2VARPTR (vars, *dp)->scope) ?
+                 'e' : 'a', *dp);
+  fprintf (stdout, "}\n");
+}
+
+
+/* Checks if 'y' depends on 'x'. */
+static int
+qdpll_dep_man_rrs_depends (QDPLLDepManGeneric * dmg, VarID x, VarID y)
+{
+  QDPLLDepManRRS *dm = (QDPLLDepManRRS *) dmg;
+  assert (dm->state.init);
+  /* Variables added after initialization have no occurrences yet. */
+  if (x >= dm->size_vars || y >= dm->size_vars)
+    return 0;
+  Var *vars = dm->pcnf->vars;
+  Scope *scope_x = VARID2VARPTR (vars, x)->scope;
+  Scope *scope_y = VARID2VARPTR (vars, y)->scope;
+  if (scope_x->nesting >= scope_y->nesting || scope_x->type == scope_y->type)
+    return 0;
+  return has_dependent (dm, x, y);
+}
+
+
+/* Every variable is a class of its own. */
+static VarID
+qdpll_dep_man_rrs_get_class_rep (QDPLLDepManGeneric * dmg, VarID x,
+                                 const unsigned int ufoffset)
+{
+  assert (ufoffset <= 1);
+  return x;
+}
+
+
+/* Check if one of the variables on 'kept', which are marked, depends
+   on 'x'. */
+static int
+has_marked_dependent (QDPLLDepManRRS * dm, Var * x, VarPtrStack * kept)
+{
+  Var *vars = dm->pcnf->vars;
+  Var **kp, **ke;
+  if (dm->dep_count[x->id] <= QDPLL_COUNT_STACK (*kept))
+    {
+      VarID *p, *e;
+      for (p = dm->deps.start + dm->dep_offset[x->id],
+           e = p + dm->dep_count[x->id]; p < e; p++)
+        if (QDPLL_VAR_NEG_MARKED (VARID2VARPTR (vars, *p)))
+          return 1;
+    }
+  else
+    {
+      for (kp = kept->start, ke = kept->top; kp < ke; kp++)
+        if ((*kp)->scope->nesting > x->scope->nesting
+            && has_dependent (dm, x->id, (*kp)->id))
+          return 1;
+    }
+  return 0;
+}
+
+
+/* Literals of type 'other_type' are kept, others are removed unless a
+   kept literal depends on them. The literals were collected before in
+   'qdpll->wreason_a' and 'qdpll->wreason_e' like for the QDAG manager,
+   but each variable is its own class representative. */
+static void
+qdpll_dep_man_rrs_reduce_lits (QDPLLDepManGeneric * dmg,
+                               LitIDStack ** lit_stack,
+                               LitIDStack ** lit_stack_tmp,
+                               const QDPLLQuantifierType other_type,
+                               const int lits_sorted)
+{
+  QDPLLDepManRRS *dm = (QDPLLDepManRRS *) dmg;
+  QDPLL *qdpll = dmg->qdpll;
+#if COMPUTE_TIMES
+  const double start = time_stamp ();
+#endif
+  assert (dm->state.init);
+  assert (lits_sorted);
+  assert (other_type == QDPLL_QTYPE_FORALL
+          || other_type == QDPLL_QTYPE_EXISTS);
+
+  if (QDPLL_COUNT_STACK (**lit_stack) == 0)
+    return;
+#if COMPUTE_STATS
+  qdpll->stats.total_type_reduce_calls++;
+  unsigned int num_lits_before_reduction = QDPLL_COUNT_STACK (**lit_stack);
+#endif
+
+  VarPtrStack *check, *kept;
+  if (other_type == QDPLL_QTYPE_EXISTS)
+    {
+      check = &(qdpll->wreason_a);
+      kept = &(qdpll->wreason_e);
+    }
+  else
+    {
+      check = &(qdpll->wreason_e);
+      kept = &(qdpll->wreason_a);
+    }
+
+  Var **p, **e;
+  for (p = kept->start, e = kept->top; p < e; p++)
+    QDPLL_VAR_NEG_MARK (*p);
+
+  /* Variables which stay POS-marked are removed. */
+  unsigned int reduced = 0;
+  for (p = check->start, e = check->top; p < e; p++)
+    {
+      assert (QDPLL_VAR_POS_MARKED (*p));
+      if (!(*p)->is_internal && !has_marked_dependent (dm, *p, kept))
+        reduced++;
+      else
+        QDPLL_VAR_POS_UNMARK (*p);
+    }
+
+  if (reduced)
+    {
+      Var *vars = qdpll->pcnf.vars;
+      LitID *lp, *le, *dest = (*lit_stack)->start;
+      for (lp = (*lit_stack)->start, le = (*lit_stack)->top; lp < le; lp++)
+        {
+          Var *v = LIT2VARPTR (vars, *lp);
+          if (v->scope->type != other_type && QDPLL_VAR_POS_MARKED (v))
+            {
+              LEARN_VAR_UNMARK (v);
+              if (qdpll->options.verbosity > 1)
+                fprintf (stderr, "%s: type-reducing lit %d by rrs\n",
+                         other_type == QDPLL_QTYPE_EXISTS ? "CDCL" : "SDCL",
+                         *lp);
+            }
+          else
+            *dest++ = *lp;
+        }
+      (*lit_stack)->top = dest;
+    }
+
+  for (p = check->start, e = check->top; p < e; p++)
+    {
+      QDPLL_VAR_UNMARK (*p);
+      QDPLL_RESET_STACK ((*p)->type_red_member_lits);
+    }
+  for (p = kept->start, e = kept->top; p < e; p++)
+    {
+      QDPLL_VAR_UNMARK (*p);
+      QDPLL_RESET_STACK ((*p)->type_red_member_lits);
+    }
+  QDPLL_RESET_STACK (qdpll->wreason_a);
+  QDPLL_RESET_STACK (qdpll->wreason_e);
+
+#if COMPUTE_STATS
+  qdpll->stats.total_type_reduce_lits +=
+    (num_lits_before_reduction - QDPLL_COUNT_STACK (**lit_stack));
+#endif
+#if COMPUTE_TIMES
+  qdpll->time_stats.total_reduce_time += (time_stamp () - start);
+#endif
+}
+
+
+static LitID *
+qdpll_dep_man_rrs_get_candidates (QDPLLDepManGeneric * dmg)
+{
+  QDPLLDepManRRS *dm = (QDPLLDepManRRS *) dmg;
+  QDPLL_ABORT_DEPMAN (!(dm->state.init),
+                      "dependency manager not initialized.");
+  Var *vars = dm->pcnf->vars;
+  VarID *p, *e;
+  unsigned int cnt = 0;
+  for (p = dm->candidates.start, e = dm->candidates.top; p < e; p++)
+    if (!dm->active_deps[*p])
+      cnt++;
+
+  /* Allocate zero-terminated array of candidates, which the caller
+     releases by 'free'. */
+  LitID *result = malloc ((cnt + 1) * sizeof (LitID));
+  LitID *rp = result;
+  for (p = dm->candidates.start, e = dm->candidates.top; p < e; p++)
+    if (!dm->active_deps[*p])
+      *rp++ = QDPLL_SCOPE_EXISTS (VARID2VARPTR (vars, *p)->scope) ?
+        (LitID) * p : -(LitID) * p;
+  *rp = 0;
+  return result;
+}
+
+/* -------------------- END: CORE FUNCTIONS -------------------- */
+
+
+/* -------------------- START: PUBLIC FUNCTIONS -------------------- */
+
+QDPLLDepManRRS *
+qdpll_rrs_dep_man_create (QDPLLMemMan * mm, QDPLLPCNF * pcnf, QDPLL * qdpll)
+{
+  /* Accounted to 'QDPLL_MEM_QDAG' like the QDAG manager. */
+  mm = qdpll_mem_view (mm, QDPLL_MEM_QDAG);
+  QDPLLDepManRRS *dm =
+    (QDPLLDepManRRS *) qdpll_malloc (mm, sizeof (QDPLLDepManRRS));
+  dm->mm = mm;
+  dm->pcnf = pcnf;
+
+  dm->dmg.qdpll = qdpll;
+  dm->dmg.type = QDPLL_DEPMAN_TYPE_RRS;
+
+  dm->dmg.init = qdpll_dep_man_rrs_init;
+  dm->dmg.reset = qdpll_dep_man_rrs_reset;
+  dm->dmg.get_candidate = qdpll_dep_man_rrs_get_candidate;
+  dm->dmg.notify_inactive = qdpll_dep_man_rrs_notify_inactive;
+  dm->dmg.notify_active = qdpll_dep_man_rrs_notify_active;
+  dm->dmg.is_candidate = qdpll_dep_man_rrs_is_candidate;
+  dm->dmg.notify_init_variable = qdpll_dep_man_rrs_notify_init_variable;
+  dm->dmg.notify_reset_variable = qdpll_dep_man_rrs_notify_reset_variable;
+  dm->dmg.is_init = qdpll_dep_man_rrs_is_init;
+  dm->dmg.print_deps = qdpll_dep_man_rrs_print_deps;
+  dm->dmg.return_deps = qdpll_dep_man_rrs_return_deps;
+  dm->dmg.dump_dep_graph = qdpll_dep_man_rrs_dump_dep_graph;
+  dm->dmg.depends = qdpll_dep_man_rrs_depends;
+  dm->dmg.get_class_rep = qdpll_dep_man_rrs_get_class_rep;
+  dm->dmg.reduce_lits = qdpll_dep_man_rrs_reduce_lits;
+  dm->dmg.get_candidates = qdpll_dep_man_rrs_get_candidates;
+
+  return dm;
+}
+
+
+void
+qdpll_rrs_dep_man_delete (QDPLLDepManRRS * dm)
+{
+  if (dm->state.init)
+    free_tables (dm);
+  qdpll_free (dm->mm, dm, sizeof (QDPLLDepManRRS));
+}
+
+/* -------------------- END: PUBLIC FUNCTIONS -------------------- */
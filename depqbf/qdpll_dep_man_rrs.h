@@ -0,0 +1,44 @@
+/*
+ This file is part of DepQBF.
+
+ DepQBF, a solver for quantified boolean formulae (QBF).
+
+ Copyright 2010, 2011, 2012, 2013, 2014, 2015, 2016
+ Florian Lonsing, Johannes Kepler University, Linz, Austria and
+ Vienna University of Technology, Vienna, Austria.
+
+ DepQBF is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or (at
+ your option) any later version.
+
+ DepQBF is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with DepQBF.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef QDPLL_DEPMAN_RRS_H_INCLUDED
+#define QDPLL_DEPMAN_RRS_H_INCLUDED
+
+#include "qdpll_dep_man_generic.h"
+#include "qdpll_pcnf.h"
+#include "qdpll_mem.h"
+
+typedef struct QDPLLDepManRRS QDPLLDepManRRS;
+
+/* Dependency manager for the reflexive resolution-path dependency
+   scheme. Variable 'y' depends on 'x' if 'y' is reachable both from
+   literal 'x' and from literal '-x' by resolution paths over existential
+   variables quantified to the right of 'x'. Dependencies are kept
+   explicitly as lists of depending variables. */
+
+QDPLLDepManRRS *qdpll_rrs_dep_man_create (QDPLLMemMan * mm,
+                                          QDPLLPCNF * pcnf, QDPLL * qdpll);
+
+void qdpll_rrs_dep_man_delete (QDPLLDepManRRS * dm);
+
+#endif
@@ -26,8 +26,10 @@
 #ifndef QDPLL_INTERNALS_H_INCLUDED
 #define QDPLL_INTERNALS_H_INCLUDED
 
+#include <signal.h>
 #include "qdpll_dep_man_generic.h"
 #include "qdpll_pqueue.h"
+#include "qdpll_trace.h"
 #include "qdpll_pcnf.h"
 #include "qdpll_config.h"
 #include "qdpll.h"
@@ -121,9 +123,11 @@ struct QDPLL
 
   QDPLLResult result;
 
-  /* Tracing, support both ascii and binary QRP format. */
-  void (*trace_scope) (Scope *);
-  void (*trace_constraint) (ConstraintID, LitID *, unsigned int,
+  /* Tracing, support both ascii and binary QRP format. Output goes
+     through 'trace_writer', which is created by '--trace'. */
+  QDPLLTraceWriter *trace_writer;
+  void (*trace_scope) (QDPLL *, Scope *);
+  void (*trace_constraint) (QDPLL *, ConstraintID, LitID *, unsigned int,
                             ConstraintID, ConstraintID);
   void (*trace_full_cover_set) (QDPLL *, ConstraintID, LitID *, unsigned int,
                                 LitID *, unsigned int);
@@ -176,6 +180,16 @@ struct QDPLL
   char *qdo_assignment_table;
   unsigned int qdo_table_bytes;
 
+  /* Checkpoints written during solving, see 'qdpll_set_checkpoint'. The
+     request is set asynchronously: 1 to write a checkpoint, 2 to write a
+     checkpoint and stop. */
+  char *checkpoint_path;
+  unsigned int checkpoint_secs;
+  volatile sig_atomic_t checkpoint_request;
+  /* Checkpoint given to 'qdpll_load_checkpoint', imported by 'solve'. */
+  unsigned char *resume_buf;
+  size_t resume_bytes;
+
   struct
   {
     unsigned int scope_opened:1;
@@ -242,12 +256,19 @@ struct QDPLL
     int exceeded_soft_max_space;
     unsigned int disabled_clauses;
     double solving_start_time;
+    /* Time of the last checkpoint and number of backtracks when the timer
+       of checkpoints was last polled. */
+    double last_checkpoint_time;
+    unsigned int checkpoint_poll_backtracks;
     unsigned int popped_off_orig_clause_cnt;
     /* Flag to toggle import of user given prefix. */
     unsigned int no_scheduled_import_user_scopes:1;
     /* Flag to indicate necessary update of clause watched for empty formula
        detection. */
     unsigned int empty_formula_watcher_scheduled_update:1; 
+    /* Set by the memory manager if allocations exceeded the pressure
+       threshold of the memory limit, handled in 'relieve_mem_pressure'. */
+    unsigned int mem_pressure:1;
 #if QBCP_QBCE_DYNAMIC_ASSIGNMENT_ELIM_UNIV_VARS
     unsigned int elim_univ_dynamic_disabled;
     unsigned int elim_univ_tried;
@@ -259,8 +280,13 @@ struct QDPLL
        i.e. 'find-blocked-clauses' is called at decision level 0 but WITHOUT
        having assigned any variables before. */
     unsigned int qbcp_qbce_currently_preprocessing:1;
+    /* Flag indicates that no original clause is blocked, which holds for
+       formulae loaded by 'qdpll_load_preprocessed'. */
+    unsigned int qbce_closed:1;
     /* For QDIMACS partial output: schedule model reconstruction. */
     unsigned int qdo_no_schedule_model_reconstruction:1;
+    /* Assignment for QDIMACS output completed, see 'qdo_prepare_values'. */
+    unsigned int qdo_values_prepared:1;
   } state;
 
   struct
@@ -279,6 +305,7 @@ struct QDPLL
     unsigned int verbosity;
     unsigned int depman_simple:1;
     unsigned int depman_qdag:1;
+    unsigned int depman_rrs:1;
     unsigned int depman_qdag_print_deps_by_search:1;
     /* Limits to be set by API function 'qdpll_setlimit'. */
     unsigned int limit_set:1;
@@ -23,11 +23,17 @@
  along with DepQBF.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+/* For 'MAP_ANONYMOUS' and 'MAP_NORESERVE'. */
+#define _DEFAULT_SOURCE
+
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include <assert.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/mman.h>
 #include "qdpll_mem.h"
 #include "qdpll_exit.h"
 
@@ -42,12 +48,144 @@
       }									\
   } while (0)
 
+static const char *mem_category_names[QDPLL_MEM_NUM_CATEGORIES] = {
+  "pcnf",
+  "learnt-clauses",
+  "learnt-cubes",
+  "qdag",
+  "qbce",
+  "qpup",
+  "pqueue",
+  "trail",
+  "trace",
+  "slab-free"
+};
+
+#if !defined (MAP_ANONYMOUS) && defined (MAP_ANON)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#ifdef MAP_NORESERVE
+#define REGION_MAP_FLAGS (MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE)
+#else
+#define REGION_MAP_FLAGS (MAP_PRIVATE | MAP_ANONYMOUS)
+#endif
+
+
+/* Reserve the region of slab chunks and arenas, see 'qdpll_mem.h'. */
+static void
+region_reserve (QDPLLMemMan * mm)
+{
+  void *region = MAP_FAILED;
+  size_t bytes;
+  for (bytes = QDPLL_REGION_MAX_BYTES; bytes >= QDPLL_REGION_MIN_BYTES;
+       bytes /= 2)
+    {
+      region = mmap (0, bytes, PROT_READ | PROT_WRITE, REGION_MAP_FLAGS, -1, 0);
+      if (region != MAP_FAILED)
+        break;
+    }
+  QDPLL_ABORT_MEM (region == MAP_FAILED, "could not reserve address space!");
+  long page_bytes = sysconf (_SC_PAGESIZE);
+  mm->page_bytes = page_bytes > 0 ? (size_t) page_bytes : 4096;
+  mm->region = (char *) region;
+  mm->region_bytes = bytes;
+  mm->region_top = QDPLL_SLAB_CHUNK_BYTES;
+  mm->region_chunks_end = bytes / 2;
+  const size_t arena_bytes = bytes / 2 / QDPLL_MEM_NUM_ARENAS;
+  unsigned int i;
+  for (i = 0; i < QDPLL_MEM_NUM_ARENAS; i++)
+    {
+      mm->arenas[i].start = bytes / 2 + i * arena_bytes;
+      mm->arenas[i].size = arena_bytes;
+    }
+}
+
+
+/* Give back the memory of the whole pages in 'bytes' bytes at 'offset'
+   of the region by mapping fresh pages over them. */
+static void
+region_discard (QDPLLMemMan * mm, size_t offset, size_t bytes)
+{
+  assert (mm == mm->root);
+  const size_t page_bytes = mm->page_bytes;
+  size_t start = (offset + page_bytes - 1) / page_bytes * page_bytes;
+  size_t end = (offset + bytes) / page_bytes * page_bytes;
+  if (start >= end)
+    return;
+  void *p = mmap (mm->region + start, end - start, PROT_READ | PROT_WRITE,
+                  REGION_MAP_FLAGS | MAP_FIXED, -1, 0);
+  QDPLL_ABORT_MEM (p == MAP_FAILED, "could not release memory!");
+}
+
+
+/* Return 'num' consecutive chunk slots of the region. Single slots are
+   reused after release, larger requests are placed at the top. */
+static void *
+region_alloc_chunks (QDPLLMemMan * mm, size_t num)
+{
+  mm = mm->root;
+  if (num == 1 && mm->num_free_slots)
+    return mm->region +
+      (size_t) mm->free_slots[--mm->num_free_slots] * QDPLL_SLAB_CHUNK_BYTES;
+  QDPLL_ABORT_MEM ((mm->region_chunks_end - mm->region_top) /
+                   QDPLL_SLAB_CHUNK_BYTES < num,
+                   "reserved address space exhausted!");
+  void *r = mm->region + mm->region_top;
+  mm->region_top += num * QDPLL_SLAB_CHUNK_BYTES;
+  return r;
+}
+
+
+static void
+region_free_chunks (QDPLLMemMan * mm, void *ptr, size_t num)
+{
+  mm = mm->root;
+  size_t offset = (char *) ptr - mm->region;
+  assert (offset % QDPLL_SLAB_CHUNK_BYTES == 0);
+  region_discard (mm, offset, num * QDPLL_SLAB_CHUNK_BYTES);
+  if (offset + num * QDPLL_SLAB_CHUNK_BYTES == mm->region_top)
+    {
+      mm->region_top = offset;
+      return;
+    }
+  if (mm->size_free_slots - mm->num_free_slots < num)
+    {
+      size_t new_size = 2 * (mm->num_free_slots + num);
+      mm->free_slots = (unsigned int *)
+        qdpll_realloc (mm->views[QDPLL_MEM_SLAB_FREE], mm->free_slots,
+                       mm->size_free_slots * sizeof (unsigned int),
+                       new_size * sizeof (unsigned int));
+      mm->size_free_slots = new_size;
+    }
+  size_t slot = offset / QDPLL_SLAB_CHUNK_BYTES;
+  while (num--)
+    mm->free_slots[mm->num_free_slots++] = slot++;
+}
+
+
 QDPLLMemMan *
 qdpll_create_mem_man ()
 {
   QDPLLMemMan *mm = (QDPLLMemMan *) malloc (sizeof (QDPLLMemMan));
   QDPLL_ABORT_MEM (!mm, "could not allocate memory!");
   memset (mm, 0, sizeof (QDPLLMemMan));
+  mm->root = mm;
+  mm->category = QDPLL_MEM_PCNF;
+  mm->views[QDPLL_MEM_PCNF] = mm;
+  unsigned int i;
+  for (i = 0; i < QDPLL_MEM_NUM_CATEGORIES; i++)
+    {
+      if (i == QDPLL_MEM_PCNF)
+        continue;
+      /* Views are not accounted for, like the root itself. */
+      QDPLLMemMan *view = (QDPLLMemMan *) malloc (sizeof (QDPLLMemMan));
+      QDPLL_ABORT_MEM (!view, "could not allocate memory!");
+      memset (view, 0, sizeof (QDPLLMemMan));
+      view->root = mm;
+      view->category = (QDPLLMemCategory) i;
+      mm->views[i] = view;
+    }
+  region_reserve (mm);
   return mm;
 }
 
@@ -56,16 +194,58 @@ void
 qdpll_delete_mem_man (QDPLLMemMan * mm)
 {
   QDPLL_ABORT_MEM (!mm, "null pointer encountered!");
+  QDPLL_ABORT_MEM (mm->root != mm, "must not delete view of manager!");
+  /* All slab blocks must have been freed before, hence all chunks go away. */
+  qdpll_slab_release (mm);
+  unsigned int i;
+#ifndef NDEBUG
+  for (i = 0; i < QDPLL_SLAB_NUM_CLASSES; i++)
+    assert (!mm->slab_classes[i].chunks);
+  for (i = 0; i < QDPLL_MEM_NUM_ARENAS; i++)
+    assert (mm->arenas[i].used == 0);
+#endif
+  qdpll_free (mm->views[QDPLL_MEM_SLAB_FREE], mm->free_slots,
+              mm->size_free_slots * sizeof (unsigned int));
+#ifndef NDEBUG
+  for (i = 0; i < QDPLL_MEM_NUM_CATEGORIES; i++)
+    assert (mm->cur_by_category[i] == 0);
+#endif
   assert (mm->cur_allocated == 0);
+  munmap (mm->region, mm->region_bytes);
+  for (i = 0; i < QDPLL_MEM_NUM_CATEGORIES; i++)
+    if (mm->views[i] != mm)
+      free (mm->views[i]);
   free (mm);
 }
 
 
-void *
-qdpll_malloc (QDPLLMemMan * mm, size_t size)
+QDPLLMemMan *
+qdpll_mem_view (QDPLLMemMan * mm, QDPLLMemCategory category)
+{
+  assert (category < QDPLL_MEM_NUM_CATEGORIES);
+  return mm->root->views[category];
+}
+
+
+static size_t
+pressure_threshold (QDPLLMemMan * mm)
+{
+  assert (mm == mm->root);
+  return mm->limit * 1024 * 1024 / 100 * QDPLL_MEM_PRESSURE_PERCENT;
+}
+
+
+static void
+check_mem_limit (QDPLLMemMan * mm, size_t size)
 {
+  mm = mm->root;
+  if (!mm->limit)
+    return;
+  /* Owner handles pressure at next safe point. */
+  if (mm->pressure_cb && mm->cur_allocated + size > pressure_threshold (mm))
+    mm->pressure_cb (mm->pressure_state);
   /* Mem-limit is given in MB. */
-  if (mm->limit && mm->limit < (mm->cur_allocated + size) / 1024 / 1024)
+  if (mm->limit < (mm->cur_allocated + size) / 1024 / 1024)
     {
       fprintf (stderr,
                "Attempted to allocate total %f MB (limit = %lu MB)\n",
@@ -74,27 +254,75 @@ qdpll_malloc (QDPLLMemMan * mm, size_t size)
                (unsigned long) mm->limit);
       QDPLL_ABORT_MEM (1, "mem-limit exceeded!");
     }
+}
+
+
+/* Account for a block of 'old_size' bytes in the category of 'mm'
+   which now has 'new_size' bytes. */
+static void
+account_realloc (QDPLLMemMan * mm, size_t old_size, size_t new_size)
+{
+  QDPLLMemMan *root = mm->root;
+  size_t *cat_cur = root->cur_by_category + mm->category;
+  assert (*cat_cur >= old_size);
+  *cat_cur -= old_size;
+  *cat_cur += new_size;
+  if (*cat_cur > root->max_by_category[mm->category])
+    root->max_by_category[mm->category] = *cat_cur;
+  root->cur_allocated -= old_size;
+  root->cur_allocated += new_size;
+  if (root->cur_allocated > root->max_allocated)
+    root->max_allocated = root->cur_allocated;
+}
+
+
+void *
+qdpll_malloc_uninit (QDPLLMemMan * mm, size_t size)
+{
+  check_mem_limit (mm, size);
   void *r = malloc (size);
   QDPLL_ABORT_MEM (!r, "could not allocate memory!");
+#ifndef NDEBUG
+  memset (r, QDPLL_MEM_POISON_BYTE, size);
+#endif
+  account_realloc (mm, 0, size);
+  return r;
+}
+
+
+void *
+qdpll_malloc (QDPLLMemMan * mm, size_t size)
+{
+  void *r = qdpll_malloc_uninit (mm, size);
   memset (r, 0, size);
-  mm->cur_allocated += size;
-  if (mm->cur_allocated > mm->max_allocated)
-    mm->max_allocated = mm->cur_allocated;
   return r;
 }
 
 
 void *
-qdpll_realloc (QDPLLMemMan * mm, void *ptr, size_t old_size, size_t new_size)
+qdpll_realloc_uninit (QDPLLMemMan * mm, void *ptr, size_t old_size,
+                      size_t new_size)
 {
+  if (new_size > old_size)
+    check_mem_limit (mm, new_size - old_size);
   ptr = realloc (ptr, new_size);
   QDPLL_ABORT_MEM (!ptr, "could not allocate memory!");
+#ifndef NDEBUG
+  if (new_size > old_size)
+    memset (((char *) ptr) + old_size, QDPLL_MEM_POISON_BYTE,
+            new_size - old_size);
+#endif
+  account_realloc (mm, old_size, new_size);
+  return ptr;
+}
+
+
+void *
+qdpll_realloc (QDPLLMemMan * mm, void *ptr, size_t old_size, size_t new_size)
+{
+  ptr = qdpll_realloc_uninit (mm, ptr, old_size, new_size);
   if (new_size > old_size)
     memset (((char *) ptr) + old_size, 0, new_size - old_size);
-  mm->cur_allocated -= old_size;
-  mm->cur_allocated += new_size;
-  if (mm->cur_allocated > mm->max_allocated)
-    mm->max_allocated = mm->cur_allocated;
   return ptr;
 }
 
@@ -104,21 +332,21 @@ qdpll_free (QDPLLMemMan * mm, void *ptr, size_t size)
 {
   QDPLL_ABORT_MEM (!mm, "null pointer encountered!");
   free (ptr);
-  mm->cur_allocated -= size;
+  account_realloc (mm, size, 0);
 }
 
 
 size_t
 qdpll_max_allocated (QDPLLMemMan * mm)
 {
-  return mm->max_allocated;
+  return mm->root->max_allocated;
 }
 
 
 size_t
 qdpll_cur_allocated (QDPLLMemMan * mm)
 {
-  return mm->cur_allocated;
+  return mm->root->cur_allocated;
 }
 
 
@@ -126,12 +354,384 @@ void
 qdpll_set_mem_limit (QDPLLMemMan * mm, size_t limit)
 {
   QDPLL_ABORT_MEM (limit <= 0, "mem-limit must be greater than 0!");
-  mm->limit = limit;
+  mm->root->limit = limit;
 }
 
 
 size_t
 qdpll_get_mem_limit (QDPLLMemMan * mm)
 {
-  return mm->limit;
+  return mm->root->limit;
+}
+
+
+void
+qdpll_set_mem_pressure_callback (QDPLLMemMan * mm,
+                                 QDPLLMemPressureCallback cb, void *state)
+{
+  mm->root->pressure_cb = cb;
+  mm->root->pressure_state = state;
+}
+
+
+int
+qdpll_mem_under_pressure (QDPLLMemMan * mm)
+{
+  mm = mm->root;
+  return mm->limit && mm->cur_allocated > pressure_threshold (mm);
+}
+
+
+size_t
+qdpll_cur_allocated_by_category (QDPLLMemMan * mm, QDPLLMemCategory category)
+{
+  assert (category < QDPLL_MEM_NUM_CATEGORIES);
+  return mm->root->cur_by_category[category];
+}
+
+
+size_t
+qdpll_max_allocated_by_category (QDPLLMemMan * mm, QDPLLMemCategory category)
+{
+  assert (category < QDPLL_MEM_NUM_CATEGORIES);
+  return mm->root->max_by_category[category];
+}
+
+
+void
+qdpll_mem_print_stats (QDPLLMemMan * mm, FILE * out)
+{
+  QDPLLMemMan *root = mm->root;
+  unsigned int i;
+  fprintf (out, "Memory usage by category (current, peak in MB):\n");
+  for (i = 0; i < QDPLL_MEM_NUM_CATEGORIES; i++)
+    fprintf (out, "  %-16s %10.3f %10.3f\n", mem_category_names[i],
+             root->cur_by_category[i] / (double) (1024 * 1024),
+             root->max_by_category[i] / (double) (1024 * 1024));
+  fprintf (out, "  %-16s %10.3f %10.3f\n", "total",
+           root->cur_allocated / (double) (1024 * 1024),
+           root->max_allocated / (double) (1024 * 1024));
 }
+
+
+/* -------------------- START: SLAB ALLOCATOR -------------------- */
+
+/* Number of classes with a granule of 'QDPLL_SLAB_GRANULE' bytes. */
+#define SLAB_NUM_LINEAR_CLASSES 64
+#define SLAB_CHUNK_HEADER_BYTES                                         \
+  ((sizeof (QDPLLSlabChunk) + QDPLL_SLAB_GRANULE - 1) /                 \
+   QDPLL_SLAB_GRANULE * QDPLL_SLAB_GRANULE)
+#define SLAB_BLOCKS_PER_CHUNK(class_idx)                                \
+  ((QDPLL_SLAB_CHUNK_BYTES - SLAB_CHUNK_HEADER_BYTES) /                 \
+   slab_block_bytes (class_idx))
+#define SLAB_CHUNK_BLOCKS(chunk)                                        \
+  (((char *) (chunk)) + SLAB_CHUNK_HEADER_BYTES)
+#define SLAB_NEXT_FREE(block) (*((void **) (block)))
+#define SLAB_NUM_LARGE_CHUNKS(size)                                     \
+  (((size) + QDPLL_SLAB_CHUNK_BYTES - 1) / QDPLL_SLAB_CHUNK_BYTES)
+
+
+static unsigned int
+slab_class_of_size (size_t size)
+{
+  assert (size > 0 && size <= QDPLL_SLAB_MAX_BYTES);
+  if (size <= SLAB_NUM_LINEAR_CLASSES * QDPLL_SLAB_GRANULE)
+    return (size - 1) / QDPLL_SLAB_GRANULE;
+  /* Four classes per power of two, starting at 1024 bytes. */
+  const size_t s = size - 1;
+  unsigned int e = 10;
+  while (s >> (e + 1))
+    e++;
+  return SLAB_NUM_LINEAR_CLASSES + (e - 10) * 4 + ((s >> (e - 2)) & 3);
+}
+
+
+static size_t
+slab_block_bytes (unsigned int class_idx)
+{
+  if (class_idx < SLAB_NUM_LINEAR_CLASSES)
+    return (class_idx + 1) * QDPLL_SLAB_GRANULE;
+  class_idx -= SLAB_NUM_LINEAR_CLASSES;
+  return ((size_t) 5 + class_idx % 4) << (8 + class_idx / 4);
+}
+
+/* Place a new chunk for a size class in the region and put its blocks on
+   the free list. The chunk is accounted for as a whole in 'cur_allocated'
+   and in category 'QDPLL_MEM_SLAB_FREE'. */
+static void
+slab_add_chunk (QDPLLMemMan * mm, unsigned int class_idx)
+{
+  mm = mm->root->views[QDPLL_MEM_SLAB_FREE];
+  QDPLLSlabClass *sc = mm->root->slab_classes + class_idx;
+  assert (!sc->free_list);
+  const size_t block_bytes = slab_block_bytes (class_idx);
+  const size_t num_blocks = SLAB_BLOCKS_PER_CHUNK (class_idx);
+  assert (num_blocks > 0);
+  const size_t bytes = SLAB_CHUNK_HEADER_BYTES + num_blocks * block_bytes;
+  check_mem_limit (mm, bytes);
+  QDPLLSlabChunk *chunk = (QDPLLSlabChunk *) region_alloc_chunks (mm, 1);
+  account_realloc (mm, 0, bytes);
+  chunk->bytes = bytes;
+  chunk->next = sc->chunks;
+  sc->chunks = chunk;
+  sc->num_chunks++;
+
+  /* Link blocks in address order such that consecutive allocations are
+     adjacent in memory. */
+  char *block = SLAB_CHUNK_BLOCKS (chunk);
+  char *last = block + (num_blocks - 1) * block_bytes;
+  for (; block < last; block += block_bytes)
+    SLAB_NEXT_FREE (block) = block + block_bytes;
+  SLAB_NEXT_FREE (last) = 0;
+  sc->free_list = SLAB_CHUNK_BLOCKS (chunk);
+  sc->num_free += num_blocks;
+}
+
+
+/* Move accounting of 'bytes' from the category of 'from' to the one of
+   'to'. Used for slab blocks, which are part of chunks accounted to
+   'QDPLL_MEM_SLAB_FREE' while they are not used. */
+static void
+account_move (QDPLLMemMan * from, QDPLLMemMan * to, size_t bytes)
+{
+  account_realloc (from, bytes, 0);
+  account_realloc (to, 0, bytes);
+}
+
+
+/* Allocate a zero-initialized block of 'size' bytes. Must be released by
+   'qdpll_slab_free' with the same 'size' and a manager of the same
+   category. */
+void *
+qdpll_slab_malloc (QDPLLMemMan * mm, size_t size)
+{
+  void *r;
+  if (size == 0)
+    return qdpll_malloc (mm, size);
+  if (size > QDPLL_SLAB_MAX_BYTES)
+    {
+      /* Only the pages which are written take memory, hence only 'size'
+         bytes are accounted for. */
+      check_mem_limit (mm, size);
+      r = region_alloc_chunks (mm, SLAB_NUM_LARGE_CHUNKS (size));
+      account_realloc (mm, 0, size);
+      memset (r, 0, size);
+      return r;
+    }
+  const unsigned int class_idx = slab_class_of_size (size);
+  QDPLLSlabClass *sc = mm->root->slab_classes + class_idx;
+  if (!sc->free_list)
+    slab_add_chunk (mm, class_idx);
+  r = sc->free_list;
+  sc->free_list = SLAB_NEXT_FREE (r);
+  assert (sc->num_free > 0);
+  sc->num_free--;
+  account_move (mm->root->views[QDPLL_MEM_SLAB_FREE], mm,
+                slab_block_bytes (class_idx));
+  memset (r, 0, size);
+  return r;
+}
+
+
+void
+qdpll_slab_free (QDPLLMemMan * mm, void *ptr, size_t size)
+{
+  QDPLL_ABORT_MEM (!mm, "null pointer encountered!");
+  if (size == 0)
+    {
+      qdpll_free (mm, ptr, size);
+      return;
+    }
+  if (!ptr)
+    return;
+  if (size > QDPLL_SLAB_MAX_BYTES)
+    {
+      region_free_chunks (mm, ptr, SLAB_NUM_LARGE_CHUNKS (size));
+      account_realloc (mm, size, 0);
+      return;
+    }
+  const unsigned int class_idx = slab_class_of_size (size);
+  QDPLLSlabClass *sc = mm->root->slab_classes + class_idx;
+  account_move (mm, mm->root->views[QDPLL_MEM_SLAB_FREE],
+                slab_block_bytes (class_idx));
+  SLAB_NEXT_FREE (ptr) = sc->free_list;
+  sc->free_list = ptr;
+  sc->num_free++;
+}
+
+
+static int
+compare_chunk_addresses (const void *a, const void *b)
+{
+  uintptr_t pa = (uintptr_t) * ((QDPLLSlabChunk * const *) a);
+  uintptr_t pb = (uintptr_t) * ((QDPLLSlabChunk * const *) b);
+  return pa < pb ? -1 : (pa > pb ? 1 : 0);
+}
+
+
+/* Return position of chunk containing 'block' in sorted table 'chunks'. */
+static size_t
+find_chunk_of_block (QDPLLSlabChunk ** chunks, size_t num_chunks,
+                     void *block)
+{
+  uintptr_t addr = (uintptr_t) block;
+  size_t lo = 0, hi = num_chunks;
+  while (hi - lo > 1)
+    {
+      size_t mid = lo + (hi - lo) / 2;
+      if ((uintptr_t) chunks[mid] <= addr)
+        lo = mid;
+      else
+        hi = mid;
+    }
+  assert ((uintptr_t) chunks[lo] <= addr &&
+          addr < (uintptr_t) chunks[lo] + chunks[lo]->bytes);
+  return lo;
+}
+
+
+static void
+slab_release_class (QDPLLMemMan * mm, QDPLLSlabClass * sc,
+                    unsigned int class_idx)
+{
+  const size_t num_blocks = SLAB_BLOCKS_PER_CHUNK (class_idx);
+  QDPLLSlabChunk *chunk, *next;
+
+  if (sc->num_free == sc->num_chunks * num_blocks)
+    {
+      /* No used blocks left: release all chunks at once. */
+      for (chunk = sc->chunks; chunk; chunk = next)
+        {
+          next = chunk->next;
+          account_realloc (mm, chunk->bytes, 0);
+          region_free_chunks (mm, chunk, 1);
+        }
+      memset (sc, 0, sizeof (QDPLLSlabClass));
+      return;
+    }
+
+  /* Count free blocks per chunk. Chunks which consist of free blocks
+     only are released and their blocks are removed from the free list. */
+  const size_t num_chunks = sc->num_chunks;
+  QDPLLSlabChunk **chunks =
+    (QDPLLSlabChunk **) qdpll_malloc (mm, num_chunks * sizeof (QDPLLSlabChunk *));
+  size_t *free_cnts = (size_t *) qdpll_malloc (mm, num_chunks * sizeof (size_t));
+  size_t i = 0;
+  for (chunk = sc->chunks; chunk; chunk = chunk->next)
+    chunks[i++] = chunk;
+  assert (i == num_chunks);
+  qsort (chunks, num_chunks, sizeof (QDPLLSlabChunk *), compare_chunk_addresses);
+
+  void *block;
+  for (block = sc->free_list; block; block = SLAB_NEXT_FREE (block))
+    free_cnts[find_chunk_of_block (chunks, num_chunks, block)]++;
+
+  void **prev_next = &(sc->free_list);
+  for (block = sc->free_list; block; block = SLAB_NEXT_FREE (block))
+    {
+      if (free_cnts[find_chunk_of_block (chunks, num_chunks, block)] !=
+          num_blocks)
+        {
+          *prev_next = block;
+          prev_next = &SLAB_NEXT_FREE (block);
+        }
+    }
+  *prev_next = 0;
+
+  sc->chunks = 0;
+  for (i = 0; i < num_chunks; i++)
+    {
+      chunk = chunks[i];
+      if (free_cnts[i] == num_blocks)
+        {
+          sc->num_chunks--;
+          sc->num_free -= num_blocks;
+          account_realloc (mm, chunk->bytes, 0);
+          region_free_chunks (mm, chunk, 1);
+        }
+      else
+        {
+          chunk->next = sc->chunks;
+          sc->chunks = chunk;
+        }
+    }
+
+  qdpll_free (mm, free_cnts, num_chunks * sizeof (size_t));
+  qdpll_free (mm, chunks, num_chunks * sizeof (QDPLLSlabChunk *));
+}
+
+
+/* Give back chunks which do not contain used blocks. Called after bulk
+   deletions, e.g. when learned constraints have been reduced. */
+void
+qdpll_slab_release (QDPLLMemMan * mm)
+{
+  QDPLL_ABORT_MEM (!mm, "null pointer encountered!");
+  mm = mm->root->views[QDPLL_MEM_SLAB_FREE];
+  unsigned int i;
+  for (i = 0; i < QDPLL_SLAB_NUM_CLASSES; i++)
+    {
+      QDPLLSlabClass *sc = mm->root->slab_classes + i;
+      if (sc->num_free >= SLAB_BLOCKS_PER_CHUNK (i))
+        slab_release_class (mm, sc, i);
+    }
+}
+
+/* -------------------- END: SLAB ALLOCATOR -------------------- */
+
+
+/* -------------------- START: ARENAS -------------------- */
+
+char *
+qdpll_region_base (QDPLLMemMan * mm)
+{
+  return mm->root->region;
+}
+
+
+void *
+qdpll_arena_malloc (QDPLLMemMan * mm, unsigned int arena, size_t size)
+{
+  assert (arena < QDPLL_MEM_NUM_ARENAS);
+  QDPLLArena *a = mm->root->arenas + arena;
+  if (a->size - a->used < size)
+    return 0;
+  check_mem_limit (mm, size);
+  char *r = mm->root->region + a->start + a->used;
+  a->used += size;
+#ifndef NDEBUG
+  memset (r, QDPLL_MEM_POISON_BYTE, size);
+#endif
+  account_realloc (mm, 0, size);
+  return r;
+}
+
+
+void
+qdpll_arena_shrink (QDPLLMemMan * mm, unsigned int arena, size_t used)
+{
+  assert (arena < QDPLL_MEM_NUM_ARENAS);
+  QDPLLArena *a = mm->root->arenas + arena;
+  assert (used <= a->used);
+  region_discard (mm->root, a->start + used, a->used - used);
+  account_realloc (mm, a->used - used, 0);
+  a->used = used;
+}
+
+
+char *
+qdpll_arena_start (QDPLLMemMan * mm, unsigned int arena)
+{
+  assert (arena < QDPLL_MEM_NUM_ARENAS);
+  return mm->root->region + mm->root->arenas[arena].start;
+}
+
+
+size_t
+qdpll_arena_used (QDPLLMemMan * mm, unsigned int arena)
+{
+  assert (arena < QDPLL_MEM_NUM_ARENAS);
+  return mm->root->arenas[arena].used;
+}
+
+/* -------------------- END: ARENAS -------------------- */
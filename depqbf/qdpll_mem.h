@@ -27,27 +27,171 @@
 #define QDPLL_MEM_H_INCLUDED
 
 #include <stddef.h>
+#include <stdio.h>
+
+/* Categories for memory accounting. Every allocation is accounted to the
+   category of the manager it is made through, where managers of
+   categories are obtained by 'qdpll_mem_view'. Slab chunks are accounted
+   to 'QDPLL_MEM_SLAB_FREE' and blocks handed out from them are moved to
+   the category of the requesting manager. */
+enum QDPLLMemCategory
+{
+  QDPLL_MEM_PCNF = 0,
+  QDPLL_MEM_LEARNT_CLAUSES,
+  QDPLL_MEM_LEARNT_CUBES,
+  QDPLL_MEM_QDAG,
+  QDPLL_MEM_QBCE,
+  QDPLL_MEM_QPUP,
+  QDPLL_MEM_PQUEUE,
+  QDPLL_MEM_TRAIL,
+  QDPLL_MEM_TRACE,
+  QDPLL_MEM_SLAB_FREE,
+  QDPLL_MEM_NUM_CATEGORIES
+};
+
+typedef enum QDPLLMemCategory QDPLLMemCategory;
+
+/* Slab allocator for small objects which are frequently allocated and
+   released, like constraints. Blocks of at most 1024 bytes are grouped in
+   size classes of 'QDPLL_SLAB_GRANULE' bytes, i.e. class 'i < 64' serves
+   blocks of at most '(i + 1) * QDPLL_SLAB_GRANULE' bytes. Above, four
+   classes per power of two serve blocks up to 'QDPLL_SLAB_MAX_BYTES'.
+   Larger blocks are given whole chunks. Released blocks are kept on
+   per-class free lists and chunks without used blocks are given back by
+   'qdpll_slab_release'. */
+#define QDPLL_SLAB_GRANULE 16
+#define QDPLL_SLAB_NUM_CLASSES 76
+#define QDPLL_SLAB_MAX_BYTES 8192
+#define QDPLL_SLAB_CHUNK_BYTES (32 * 1024)
+
+/* Slab chunks are placed in the first half of a range of address space
+   which is reserved when the manager is created and which never moves.
+   The second half is split into 'QDPLL_MEM_NUM_ARENAS' arenas, which grow
+   and shrink at their end only. Slab and arena blocks can thus be
+   referenced by 32-bit offsets from 'qdpll_region_base' in units of
+   'QDPLL_SLAB_GRANULE'. Reserved address space takes memory only once it
+   is written, and released chunks and arena tails give it back. If the
+   maximal size cannot be reserved, smaller sizes down to
+   'QDPLL_REGION_MIN_BYTES' are tried. */
+#define QDPLL_MEM_NUM_ARENAS 2
+#define QDPLL_REGION_MAX_BYTES \
+  (sizeof (size_t) > 4 ? (size_t) QDPLL_SLAB_GRANULE << 31 : (size_t) 1 << 30)
+#define QDPLL_REGION_MIN_BYTES ((size_t) 64 * 1024 * 1024)
+
+typedef struct QDPLLSlabChunk QDPLLSlabChunk;
+typedef struct QDPLLSlabClass QDPLLSlabClass;
+typedef struct QDPLLArena QDPLLArena;
+typedef struct QDPLLMemMan QDPLLMemMan;
+
+/* Called by allocations which make the total exceed
+   'QDPLL_MEM_PRESSURE_PERCENT' percent of the limit. The owner is
+   responsible to release memory or to stop at the next safe point. The
+   callback must not allocate or free memory. Allocations which exceed
+   the limit itself abort, with or without a callback. */
+typedef void (*QDPLLMemPressureCallback) (void *state);
+#define QDPLL_MEM_PRESSURE_PERCENT 90
+
+struct QDPLLSlabChunk
+{
+  QDPLLSlabChunk *next;
+  /* Total size of chunk including this header. */
+  size_t bytes;
+};
+
+struct QDPLLSlabClass
+{
+  /* Free blocks, linked through their first word. */
+  void *free_list;
+  QDPLLSlabChunk *chunks;
+  size_t num_chunks;
+  size_t num_free;
+};
+
+struct QDPLLArena
+{
+  /* Offset of the arena in the region, its size and used bytes. */
+  size_t start;
+  size_t size;
+  size_t used;
+};
 
 struct QDPLLMemMan
 {
+  /* Manager which owns counters, limit and slab classes. Views of
+     categories share the state of their root and only keep 'category'. */
+  QDPLLMemMan *root;
+  QDPLLMemCategory category;
   size_t cur_allocated;
   size_t max_allocated;
   size_t limit;
+  QDPLLMemPressureCallback pressure_cb;
+  void *pressure_state;
+  size_t cur_by_category[QDPLL_MEM_NUM_CATEGORIES];
+  size_t max_by_category[QDPLL_MEM_NUM_CATEGORIES];
+  QDPLLMemMan *views[QDPLL_MEM_NUM_CATEGORIES];
+  QDPLLSlabClass slab_classes[QDPLL_SLAB_NUM_CLASSES];
+  /* Region of slab chunks and arenas. Chunks are placed at offset
+     'region_top' or in released slots, whose indices are kept in
+     'free_slots'. Slot 0 is never used such that offset 0 does not refer
+     to any block. */
+  char *region;
+  size_t region_bytes;
+  size_t region_top;
+  size_t region_chunks_end;
+  size_t page_bytes;
+  unsigned int *free_slots;
+  size_t num_free_slots;
+  size_t size_free_slots;
+  QDPLLArena arenas[QDPLL_MEM_NUM_ARENAS];
 };
 
-typedef struct QDPLLMemMan QDPLLMemMan;
-
 QDPLLMemMan *qdpll_create_mem_man ();
 
 void qdpll_delete_mem_man (QDPLLMemMan * mm);
 
+/* Return manager which accounts to 'category' but otherwise shares the
+   state of 'mm'. It lives as long as 'mm' and must not be deleted. */
+QDPLLMemMan *qdpll_mem_view (QDPLLMemMan * mm, QDPLLMemCategory category);
+
 void *qdpll_malloc (QDPLLMemMan * mm, size_t size);
 
 void *qdpll_realloc (QDPLLMemMan * mm, void *ptr, size_t old_size,
                      size_t new_size);
 
+/* Same as 'qdpll_malloc' and 'qdpll_realloc', but new memory is not
+   zero-initialized. Use only if the caller writes memory before reading
+   it, like stacks do. In assertion-enabled builds, new memory is filled
+   with 'QDPLL_MEM_POISON_BYTE' to expose reads of uninitialized data. */
+#define QDPLL_MEM_POISON_BYTE 0xa5
+
+void *qdpll_malloc_uninit (QDPLLMemMan * mm, size_t size);
+
+void *qdpll_realloc_uninit (QDPLLMemMan * mm, void *ptr, size_t old_size,
+                            size_t new_size);
+
 void qdpll_free (QDPLLMemMan * mm, void *ptr, size_t size);
 
+void *qdpll_slab_malloc (QDPLLMemMan * mm, size_t size);
+
+void qdpll_slab_free (QDPLLMemMan * mm, void *ptr, size_t size);
+
+void qdpll_slab_release (QDPLLMemMan * mm);
+
+/* Start of the region holding slab blocks and arenas. */
+char *qdpll_region_base (QDPLLMemMan * mm);
+
+/* Allocate 'size' bytes at the end of arena 'arena', accounted to the
+   category of 'mm'. Memory is not initialized, see
+   'qdpll_malloc_uninit'. Returns 0 if the arena is full. */
+void *qdpll_arena_malloc (QDPLLMemMan * mm, unsigned int arena, size_t size);
+
+/* Release the end of arena 'arena' such that 'used' bytes remain. */
+void qdpll_arena_shrink (QDPLLMemMan * mm, unsigned int arena, size_t used);
+
+char *qdpll_arena_start (QDPLLMemMan * mm, unsigned int arena);
+
+size_t qdpll_arena_used (QDPLLMemMan * mm, unsigned int arena);
+
 size_t qdpll_max_allocated (QDPLLMemMan * mm);
 
 size_t qdpll_cur_allocated (QDPLLMemMan * mm);
@@ -56,4 +200,20 @@ void qdpll_set_mem_limit (QDPLLMemMan * mm, size_t limit);
 
 size_t qdpll_get_mem_limit (QDPLLMemMan * mm);
 
+void qdpll_set_mem_pressure_callback (QDPLLMemMan * mm,
+                                      QDPLLMemPressureCallback cb,
+                                      void *state);
+
+/* Returns non-zero if current total exceeds the pressure threshold. */
+int qdpll_mem_under_pressure (QDPLLMemMan * mm);
+
+size_t qdpll_cur_allocated_by_category (QDPLLMemMan * mm,
+                                        QDPLLMemCategory category);
+
+size_t qdpll_max_allocated_by_category (QDPLLMemMan * mm,
+                                        QDPLLMemCategory category);
+
+/* Print current and peak bytes per category. */
+void qdpll_mem_print_stats (QDPLLMemMan * mm, FILE * out);
+
 #endif
@@ -35,6 +35,7 @@ typedef struct QDPLLPCNF QDPLLPCNF;
 typedef struct Scope Scope;
 typedef struct Var Var;
 typedef struct Constraint Constraint;
+typedef struct QBCEConstraintState QBCEConstraintState;
 
 #define QDPLL_DECLARE_DLIST(name, type)					\
   struct name ## List {type * first; type * last; unsigned int cnt;};	\
@@ -49,22 +50,39 @@ QDPLL_DECLARE_DLIST (Scope, Scope);
 QDPLL_DECLARE_DLINK (Constraint, Constraint);
 QDPLL_DECLARE_DLIST (Constraint, Constraint);
 
-/* Wrapper for constraint occurrences: blocking literal and pointer to actual
-   constraint. Used during literal-watcher updates: before pointer is deref'd,
-   we check if the blocking literal 'blit' already satisfies/falsifies the
-   clause/cube. We use bit-stuffing to store a flag whether 'constr' points to
-   a clause or cube. */
+/* Constraints are referenced from occurrence and watcher stacks by 32-bit
+   references instead of pointers. All constraints are placed in the
+   region of the memory manager, see 'qdpll_region_base', which never
+   moves. A reference is the offset of the constraint from
+   'pcnf->constraint_base' in units of 'QDPLL_SLAB_GRANULE', shifted left
+   by one. The lowest bit is set if and only if the constraint is a cube.
+   Reference 0 is never assigned to a constraint. */
+typedef unsigned int ConstraintRef;
+
+#define QDPLL_INVALID_CONSTRAINT_REF 0
+
+/* Wrapper for constraint occurrences: blocking literal and reference to
+   actual constraint. Used during literal-watcher updates: before the
+   reference is resolved, we check if the blocking literal 'blit' already
+   satisfies/falsifies the clause/cube. The marked bit of the reference
+   tells whether it refers to a clause or cube. */
 struct BLitsOcc
 {
   LitID blit;
-  Constraint *constraint;
+  ConstraintRef cref;
 };
 
 typedef struct BLitsOcc BLitsOcc;
 
-#define BLIT_MARKED_PTR(ptr) (((uintptr_t)(ptr)) & ((uintptr_t)1))
-#define BLIT_STRIP_PTR(ptr) ((Constraint *)(((uintptr_t)(ptr)) & (~((uintptr_t)(1)))))
-#define BLIT_MARK_PTR(ptr) ((Constraint *)(((uintptr_t)(ptr)) | (((uintptr_t)(1)))))
+#define BLIT_MARKED_REF(ref) ((ref) & ((ConstraintRef) 1))
+#define BLIT_REF_OFFSET(ref) \
+  ((size_t) ((ref) >> 1) * QDPLL_SLAB_GRANULE)
+#define BLIT_REF_OF_OFFSET(offset, is_cube) \
+  ((((ConstraintRef) ((offset) / QDPLL_SLAB_GRANULE)) << 1) | \
+   ((is_cube) ? 1 : 0))
+#define BLIT_REF2CONSTRAINT(pcnf, ref) \
+  ((Constraint *) ((pcnf).constraint_base + BLIT_REF_OFFSET ((ref))))
+#define BLIT_CONSTRAINT(pcnf, occ) (BLIT_REF2CONSTRAINT ((pcnf), (occ).cref))
 
 QDPLL_DECLARE_STACK (ConstraintPtr, Constraint *);
 QDPLL_DECLARE_STACK (VarPtr, Var *);
@@ -148,9 +166,17 @@ struct QDPLLPCNF
   VarID size_user_vars;
   VarID used_vars;
   Var *vars;
+  /* Hot per-variable state, indexed like 'vars' and with 'size_vars'
+     entries each. Kept out of 'Var' such that propagation does not touch
+     the cache lines of variables only to look up their values. */
+  signed char *var_values;
+  unsigned int *var_levels;
+  unsigned int *var_trail_pos;
   ConstraintList clauses;
   ConstraintList learnt_clauses;
   ConstraintList learnt_cubes;
+  /* Base of constraint references, see 'ConstraintRef'. */
+  char *constraint_base;
 };
 
 struct QDAGPartition
@@ -175,12 +201,12 @@ struct Scope
   QDAGPartition partition;
 };
 
+/* NOTE: the assignment, decision level and trail position of a variable are
+   not stored in 'Var' but in the arrays 'var_values', 'var_levels' and
+   'var_trail_pos' of 'QDPLLPCNF'. Use 'QDPLL_VAR_VALUE' etc. for access. */
 struct Var
 {
   VarID id;
-  unsigned int decision_level;
-  unsigned int trail_pos;
-  QDPLLAssignment assignment:2;
   QDPLLVarMode mode:3;
   /* Two multi-purpose marks. */
   unsigned int mark0:1;
@@ -321,9 +347,37 @@ struct Var
 
 
 /* A constraint type that subsumes Clause and Cube. */
+/* State of a clause for QBCE in QBCP, which is kept outside of 'Constraint'
+   to keep constraints small. It is allocated only for original clauses and
+   only if QBCE is enabled, see 'qbcp_qbce_get_state'. */
+struct QBCEConstraintState
+{
+  /* List of clauses for which this clauses is a non-blocked witness. If this
+     clause becomes blocked (or satisfied, but this must be handled from
+     assigned variables) then all the clauses in the list may be blocked and
+     must be inspected again. We also store the non-blocking literal for which
+     a clause in the list is a witness. This way, we can check this
+     non-blocking literals only and search for a new witness. */
+  QBCENonBlockedWitnessStack qbcp_qbce_notify_maybe_blocked_clauses;
+  /* List of clauses and respective non-blocking literals which are witnesses
+     that this clause is not blocked by the respective literal. Every
+     non-blocked clause has exactly one witness for every non-blocking
+     literal. */
+  QBCENonBlockedWitnessStack qbcp_qbce_witness_clauses;
+  /* If this clause is currently a witness, then a pointer to this clause is
+     stored in the lists 'var->qbcp_qbce_watched_pos/neg_occ_clauses' of all
+     variables which occur positively and negatively in the witness. We maintain
+     the offset of the pointer entry in this lists in
+     'clause->offsets_of_witness_in_watched_occs' to allow for O(1) deletion in
+     'qbcp_qbce_remove_watched_occ'. */
+  VarIDStack qbcp_qbce_offset_of_witness_in_watched_occs;
+};
+
 struct Constraint
 {
   ConstraintID id;
+  /* Reference to this constraint in occurrence and watcher stacks. */
+  ConstraintRef ref;
   unsigned int size_lits:(sizeof (unsigned int) * 8 - 1);
   unsigned int qbcp_qbce_elim_univ_mark:1;
   unsigned int num_lits:(sizeof (unsigned int) * 8 - 4);
@@ -340,27 +394,16 @@ struct Constraint
   /* For QBCE in QBCP: indicates that a clause is blocked. */
   unsigned int qbcp_qbce_blocked:1;
   unsigned int qbcp_qbce_mark:1;
+  /* Set if constraint is stored in the arena of learned clauses or cubes,
+     see 'create_learnt_constraint'. */
+  unsigned int in_learnt_arena:1;
+  /* Memory category the constraint is accounted to. */
+  unsigned int mem_category:4;
   /* Blocking literal, set if and only if 'qbcp_qbce_blocked' is true. */
   LitID qbcp_qbce_blocking_lit;
-  /* List of clauses for which this clauses is a non-blocked witness. If this
-     clause becomes blocked (or satisfied, but this must be handled from
-     assigned variables) then all the clauses in the list may be blocked and
-     must be inspected again. We also store the non-blocking literal for which
-     a clause in the list is a witness. This way, we can check this
-     non-blocking literals only and search for a new witness. */
-  QBCENonBlockedWitnessStack qbcp_qbce_notify_maybe_blocked_clauses;
-  /* List of clauses and respective non-blocking literals which are witnesses
-     that this clause is not blocked by the respective literal. Every
-     non-blocked clause has exactly one witness for every non-blocking
-     literal. */
-  QBCENonBlockedWitnessStack qbcp_qbce_witness_clauses;
-  /* If this clause is currently a witness, then a pointer to this clause is
-     stored in the lists 'var->qbcp_qbce_watched_pos/neg_occ_clauses' of all
-     variables which occur positively and negatively in the witness. We maintain
-     the offset of the pointer entry in this lists in
-     'clause->offsets_of_witness_in_watched_occs' to allow for O(1) deletion in
-     'qbcp_qbce_remove_watched_occ'. */
-  VarIDStack qbcp_qbce_offset_of_witness_in_watched_occs;
+  /* Witness bookkeeping for QBCE, see 'struct QBCEConstraintState'. Null
+     unless the constraint is an original clause and QBCE is enabled. */
+  QBCEConstraintState *qbce;
 
   /* All original clauses are kept in linked list, also learnt clauses
      separately and learnt cubes. */
@@ -408,11 +451,36 @@ struct Constraint
 #define QDPLL_VAR_NEG_MARKED(v) ((v)->mark1)
 #define QDPLL_VAR_MARKED(v) ((v)->mark0 || (v)->mark1)
 
-#define QDPLL_VAR_ASSIGNED(v) ((v)->assignment)
-#define QDPLL_VAR_ASSIGNED_TRUE(v) ((v)->assignment == QDPLL_ASSIGNMENT_TRUE)
-#define QDPLL_VAR_ASSIGNED_FALSE(v) ((v)->assignment == QDPLL_ASSIGNMENT_FALSE)
-#define QDPLL_VAR_ASSIGN_TRUE(v) ((v)->assignment = QDPLL_ASSIGNMENT_TRUE)
-#define QDPLL_VAR_ASSIGN_FALSE(v) ((v)->assignment = QDPLL_ASSIGNMENT_FALSE)
+/* Access to hot per-variable state in 'pcnf', see 'struct QDPLLPCNF'. The
+   state of a variable is indexed by its ID. Hence 'v->id' must be set before
+   and cleared after accessing the state. Where only a literal is at hand,
+   prefer the 'QDPLL_VARID_*' and 'QDPLL_LIT_VAR_*' variants below. */
+#define QDPLL_VAR_INDEX(pcnf, v) ((v)->id)
+#define QDPLL_VAR_VALUE(pcnf, v) ((pcnf).var_values[QDPLL_VAR_INDEX((pcnf), (v))])
+#define QDPLL_VAR_LEVEL(pcnf, v) ((pcnf).var_levels[QDPLL_VAR_INDEX((pcnf), (v))])
+#define QDPLL_VAR_TRAIL_POS(pcnf, v) \
+  ((pcnf).var_trail_pos[QDPLL_VAR_INDEX((pcnf), (v))])
+#define QDPLL_VARID_VALUE(pcnf, id) ((pcnf).var_values[(id)])
+#define QDPLL_VARID_LEVEL(pcnf, id) ((pcnf).var_levels[(id)])
+
+#define QDPLL_VAR_ASSIGNED(pcnf, v) (QDPLL_VAR_VALUE((pcnf), (v)))
+#define QDPLL_VAR_ASSIGNED_TRUE(pcnf, v) \
+  (QDPLL_VAR_VALUE((pcnf), (v)) == QDPLL_ASSIGNMENT_TRUE)
+#define QDPLL_VAR_ASSIGNED_FALSE(pcnf, v) \
+  (QDPLL_VAR_VALUE((pcnf), (v)) == QDPLL_ASSIGNMENT_FALSE)
+#define QDPLL_VAR_ASSIGN_TRUE(pcnf, v) \
+  (QDPLL_VAR_VALUE((pcnf), (v)) = QDPLL_ASSIGNMENT_TRUE)
+#define QDPLL_VAR_ASSIGN_FALSE(pcnf, v) \
+  (QDPLL_VAR_VALUE((pcnf), (v)) = QDPLL_ASSIGNMENT_FALSE)
+
+/* Same as above, but for the variable of literal 'lit'. Used in
+   propagation to avoid touching the variable itself. */
+#define QDPLL_LIT_VAR_ASSIGNED(pcnf, lit) \
+  (QDPLL_VARID_VALUE((pcnf), LIT2VARID((lit))))
+#define QDPLL_LIT_VAR_ASSIGNED_TRUE(pcnf, lit) \
+  (QDPLL_LIT_VAR_ASSIGNED((pcnf), (lit)) == QDPLL_ASSIGNMENT_TRUE)
+#define QDPLL_LIT_VAR_ASSIGNED_FALSE(pcnf, lit) \
+  (QDPLL_LIT_VAR_ASSIGNED((pcnf), (lit)) == QDPLL_ASSIGNMENT_FALSE)
 
 #define QDPLL_INVALID_TRAIL_POS UINT_MAX
 #define QDPLL_INVALID_PQUEUE_POS UINT_MAX
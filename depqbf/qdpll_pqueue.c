@@ -228,6 +228,7 @@ print_pqueue (PriorityQueue * pqueue)
 PriorityQueue *
 pqueue_create (QDPLLMemMan * mm, unsigned int init_size)
 {
+  mm = qdpll_mem_view (mm, QDPLL_MEM_PQUEUE);
   PriorityQueue *pq = qdpll_malloc (mm, sizeof (PriorityQueue));
   if (init_size == 0)
     init_size = 1;
@@ -246,6 +247,7 @@ pqueue_create (QDPLLMemMan * mm, unsigned int init_size)
 void
 pqueue_delete (QDPLLMemMan * mm, PriorityQueue * pqueue)
 {
+  mm = qdpll_mem_view (mm, QDPLL_MEM_PQUEUE);
   qdpll_free (mm, pqueue->queue, sizeof (PriorityQueueElem) * pqueue->size);
   qdpll_free (mm, pqueue, sizeof (PriorityQueue));
 }
@@ -258,6 +260,7 @@ pqueue_adjust (QDPLLMemMan * mm, PriorityQueue * pqueue, unsigned int size)
 
   if ((old_size = pqueue->size) < size)
     {
+      mm = qdpll_mem_view (mm, QDPLL_MEM_PQUEUE);
       pqueue->queue = qdpll_realloc (mm, pqueue->queue,
                                      old_size * sizeof (PriorityQueueElem),
                                      size * sizeof (PriorityQueueElem));
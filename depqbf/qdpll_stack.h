@@ -86,6 +86,48 @@
     *((stack).top++) = (elem);			\
   } while (0)
 
+/* Variants of 'QDPLL_ENLARGE_STACK' and 'QDPLL_PUSH_STACK' which do not
+   zero-initialize the grown part of the stack. Elements beyond 'top' are
+   never read, hence these can be used for all stacks which are filled by
+   pushing only, like literal buffers in hot paths. */
+#define QDPLL_ENLARGE_STACK_UNINIT(mm, stack)				\
+  do {									\
+    size_t old_size = QDPLL_SIZE_STACK (stack), new_size;		\
+    new_size = old_size ? 2 * old_size : 1;				\
+    size_t old_count = QDPLL_COUNT_STACK (stack);			\
+    size_t elem_bytes = sizeof(*(stack).start);				\
+    (stack).start = qdpll_realloc_uninit((mm), (stack).start,		\
+					 old_size*elem_bytes,		\
+					 new_size*elem_bytes);		\
+    (stack).top = (stack).start + old_count;				\
+    (stack).end = (stack).start + new_size;				\
+  } while (0)
+
+#define QDPLL_PUSH_STACK_UNINIT(mm, stack, elem)	\
+  do {							\
+    if (QDPLL_FULL_STACK ((stack)))			\
+      QDPLL_ENLARGE_STACK_UNINIT ((mm), (stack));	\
+    *((stack).top++) = (elem);				\
+  } while (0)
+
+/* Release the capacity of 'stack' beyond 'top', the stack is deleted if
+   it is empty. Pointers into the stack become invalid, offsets do not. */
+#define QDPLL_SHRINK_STACK(mm, stack)					\
+  do {									\
+    size_t old_size = QDPLL_SIZE_STACK (stack);				\
+    size_t count = QDPLL_COUNT_STACK (stack);				\
+    if (count == 0)							\
+      QDPLL_DELETE_STACK ((mm), (stack));				\
+    else if (count < old_size)						\
+      {									\
+	size_t elem_bytes = sizeof(*(stack).start);			\
+	(stack).start = qdpll_realloc_uninit((mm), (stack).start,	\
+					     old_size * elem_bytes,	\
+					     count * elem_bytes);	\
+	(stack).top = (stack).end = (stack).start + count;		\
+      }									\
+  } while (0)
+
 #define QDPLL_POP_STACK(stack) (*--(stack).top)
 
 QDPLL_DECLARE_STACK (VoidPtr, void *);
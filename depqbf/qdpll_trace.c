@@ -0,0 +1,223 @@
+/*
+ This file is part of DepQBF.
+
+ DepQBF, a solver for quantified boolean formulae (QBF).        
+
+ Copyright 2010, 2011, 2012, 2013, 2014, 2015, 2016 
+ Florian Lonsing, Johannes Kepler University, Linz, Austria and 
+ Vienna University of Technology, Vienna, Austria.
+
+ DepQBF is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or (at
+ your option) any later version.
+
+ DepQBF is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with DepQBF.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/* For 'sigset_t', 'pthread_sigmask' and 'nanosleep' under '-std=c99'. */
+#define _POSIX_C_SOURCE 200112L
+
+#include <assert.h>
+#include <stdlib.h>
+#include <time.h>
+#include "qdpll_trace.h"
+#include "qdpll_exit.h"
+
+#define QDPLL_ABORT_TRACE(cond,msg)					\
+  do {									\
+    if (cond)								\
+      {									\
+        fprintf (stderr, "[qdpll_trace] %s at line %d: %s\n", __func__,	\
+		 __LINE__,msg);						\
+	fflush (stderr);						\
+        abort ();							\
+      }									\
+  } while (0)
+
+
+static void *
+trace_writer_thread (void *arg)
+{
+  QDPLLTraceWriter *tw = (QDPLLTraceWriter *) arg;
+  pthread_mutex_lock (&tw->lock);
+  while (1)
+    {
+      while (!tw->pending && !tw->done)
+        pthread_cond_wait (&tw->cond, &tw->lock);
+      if (!tw->pending)
+        break;
+      char *buf = tw->pending;
+      size_t bytes = tw->pending_bytes;
+      pthread_mutex_unlock (&tw->lock);
+      fwrite (buf, 1, bytes, tw->out);
+      pthread_mutex_lock (&tw->lock);
+      tw->pending = 0;
+      pthread_cond_broadcast (&tw->cond);
+    }
+  pthread_mutex_unlock (&tw->lock);
+  return 0;
+}
+
+
+QDPLLTraceWriter *
+qdpll_trace_writer_create (QDPLLMemMan * mm, FILE * out)
+{
+  QDPLLTraceWriter *tw =
+    (QDPLLTraceWriter *) qdpll_malloc (mm, sizeof (QDPLLTraceWriter));
+  tw->mm = mm;
+  tw->out = out;
+  tw->bufs[0] = (char *) qdpll_malloc_uninit (mm, QDPLL_TRACE_BUF_SIZE);
+  tw->bufs[1] = (char *) qdpll_malloc_uninit (mm, QDPLL_TRACE_BUF_SIZE);
+  tw->pos = tw->bufs[0];
+  tw->end = tw->pos + QDPLL_TRACE_BUF_SIZE;
+  pthread_mutex_init (&tw->lock, 0);
+  pthread_cond_init (&tw->cond, 0);
+  /* Signals must be handled by the thread which fills the buffers, see
+     'qdpll_trace_writer_drain'. The writer thread inherits the mask. */
+  sigset_t all, old;
+  sigfillset (&all);
+  pthread_sigmask (SIG_SETMASK, &all, &old);
+  int error = pthread_create (&tw->thread, 0, trace_writer_thread, tw);
+  pthread_sigmask (SIG_SETMASK, &old, 0);
+  QDPLL_ABORT_TRACE (error, "could not start trace writer thread!");
+  return tw;
+}
+
+
+void
+qdpll_trace_writer_delete (QDPLLTraceWriter * tw)
+{
+  qdpll_trace_writer_flush (tw);
+  pthread_mutex_lock (&tw->lock);
+  tw->done = 1;
+  pthread_cond_broadcast (&tw->cond);
+  pthread_mutex_unlock (&tw->lock);
+  pthread_join (tw->thread, 0);
+  pthread_cond_destroy (&tw->cond);
+  pthread_mutex_destroy (&tw->lock);
+  qdpll_free (tw->mm, tw->bufs[0], QDPLL_TRACE_BUF_SIZE);
+  qdpll_free (tw->mm, tw->bufs[1], QDPLL_TRACE_BUF_SIZE);
+  qdpll_free (tw->mm, tw, sizeof (QDPLLTraceWriter));
+}
+
+
+/* Return the buffer which the writer thread has not finished yet, if
+   any. Must not be called while 'busy' is set. */
+static char *
+get_pending (QDPLLTraceWriter * tw)
+{
+  tw->busy = 1;
+  pthread_mutex_lock (&tw->lock);
+  char *pending = tw->pending;
+  pthread_mutex_unlock (&tw->lock);
+  tw->busy = 0;
+  return pending;
+}
+
+
+/* Wait until the writer thread is idle. The solver polls instead of
+   waiting on 'cond' so that a signal handler interrupting the wait does
+   not find the lock taken, see 'qdpll_trace_writer_drain'. */
+static void
+wait_until_written (QDPLLTraceWriter * tw)
+{
+  struct timespec pause = { 0, 50000 };
+  while (get_pending (tw))
+    nanosleep (&pause, 0);
+}
+
+
+void
+qdpll_trace_writer_swap (QDPLLTraceWriter * tw)
+{
+  char *start = tw->bufs[tw->active];
+  if (tw->pos == start)
+    return;
+  wait_until_written (tw);
+  /* Until the active buffer is switched, its data is both pending and
+     still in the active buffer. */
+  tw->busy = 1;
+  pthread_mutex_lock (&tw->lock);
+  assert (!tw->pending);
+  tw->pending = start;
+  tw->pending_bytes = tw->pos - start;
+  pthread_cond_broadcast (&tw->cond);
+  pthread_mutex_unlock (&tw->lock);
+  tw->active ^= 1;
+  tw->pos = tw->bufs[tw->active];
+  tw->end = tw->pos + QDPLL_TRACE_BUF_SIZE;
+  tw->busy = 0;
+}
+
+
+void
+qdpll_trace_writer_flush (QDPLLTraceWriter * tw)
+{
+  qdpll_trace_writer_swap (tw);
+  wait_until_written (tw);
+  fflush (tw->out);
+}
+
+
+int
+qdpll_trace_writer_drain (QDPLLTraceWriter * tw)
+{
+  if (tw->busy)
+    return 0;
+  /* The interrupted thread does not hold the lock, hence only the writer
+     thread may have to finish the pending buffer. The active buffer is
+     written here to avoid a handover. */
+  wait_until_written (tw);
+  char *start = tw->bufs[tw->active];
+  fwrite (start, 1, tw->pos - start, tw->out);
+  tw->pos = start;
+  fflush (tw->out);
+  return 1;
+}
+
+
+void
+qdpll_trace_put_uint (QDPLLTraceWriter * tw, unsigned int x)
+{
+  char digits[10], *p = digits;
+  do
+    {
+      *p++ = '0' + x % 10;
+      x /= 10;
+    }
+  while (x);
+  while (p > digits)
+    QDPLL_TRACE_PUTC (tw, *--p);
+}
+
+
+void
+qdpll_trace_put_int (QDPLLTraceWriter * tw, int x)
+{
+  if (x < 0)
+    {
+      QDPLL_TRACE_PUTC (tw, '-');
+      qdpll_trace_put_uint (tw, -(unsigned int) x);
+    }
+  else
+    qdpll_trace_put_uint (tw, x);
+}
+
+
+void
+qdpll_trace_put_varint (QDPLLTraceWriter * tw, unsigned int x)
+{
+  while (x & ~0x7f)
+    {
+      QDPLL_TRACE_PUTC (tw, (x & 0x7f) | 0x80);
+      x >>= 7;
+    }
+  QDPLL_TRACE_PUTC (tw, x);
+}
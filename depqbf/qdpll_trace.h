@@ -0,0 +1,95 @@
+/*
+ This file is part of DepQBF.
+
+ DepQBF, a solver for quantified boolean formulae (QBF).        
+
+ Copyright 2010, 2011, 2012, 2013, 2014, 2015, 2016 
+ Florian Lonsing, Johannes Kepler University, Linz, Austria and 
+ Vienna University of Technology, Vienna, Austria.
+
+ DepQBF is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or (at
+ your option) any later version.
+
+ DepQBF is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with DepQBF.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef QDPLL_TRACE_H_INCLUDED
+#define QDPLL_TRACE_H_INCLUDED
+
+#include <stdio.h>
+#include <signal.h>
+#include <pthread.h>
+#include "qdpll_mem.h"
+
+/* Size of each of the two buffers of a trace writer. */
+#define QDPLL_TRACE_BUF_SIZE (1 << 20)
+
+/* Buffered writer for proof traces. The solver fills one buffer while a
+   background thread writes the other one to 'out'. The solver waits only
+   if it fills a buffer faster than the thread writes the previous one. */
+struct QDPLLTraceWriter
+{
+  QDPLLMemMan *mm;
+  FILE *out;
+  char *bufs[2];
+  /* Current position and end of buffer filled by the solver. */
+  char *pos;
+  char *end;
+  unsigned int active;
+  /* Buffer handed over to writer thread and its number of bytes. Null if
+     writer thread is idle. */
+  char *pending;
+  size_t pending_bytes;
+  int done;
+  /* Set while the solver holds 'lock' or hands over a buffer, where the
+     buffers cannot be drained from a signal handler. */
+  volatile sig_atomic_t busy;
+  pthread_t thread;
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+};
+
+typedef struct QDPLLTraceWriter QDPLLTraceWriter;
+
+QDPLLTraceWriter *qdpll_trace_writer_create (QDPLLMemMan * mm, FILE * out);
+
+/* Flush and stop writer thread. */
+void qdpll_trace_writer_delete (QDPLLTraceWriter * tw);
+
+/* Hand over full buffer to writer thread. */
+void qdpll_trace_writer_swap (QDPLLTraceWriter * tw);
+
+/* Return after all data has been written to 'out' and 'out' is flushed. */
+void qdpll_trace_writer_flush (QDPLLTraceWriter * tw);
+
+/* Same as 'qdpll_trace_writer_flush', but for a signal handler running in
+   the thread which fills the buffers before the process terminates.
+   Returns zero and writes nothing if that thread was interrupted while
+   'busy' was set. */
+int qdpll_trace_writer_drain (QDPLLTraceWriter * tw);
+
+#define QDPLL_TRACE_PUTC(tw, ch)			\
+  do {							\
+    if ((tw)->pos == (tw)->end)				\
+      qdpll_trace_writer_swap ((tw));			\
+    *(tw)->pos++ = (ch);				\
+  } while (0)
+
+/* Write 'x' in decimal digits. */
+void qdpll_trace_put_uint (QDPLLTraceWriter * tw, unsigned int x);
+
+void qdpll_trace_put_int (QDPLLTraceWriter * tw, int x);
+
+/* Write 'x' in the variable-length encoding of binary traces, see also
+   'encode_varint' in 'qdpll.c'. */
+void qdpll_trace_put_varint (QDPLLTraceWriter * tw, unsigned int x);
+
+#endif